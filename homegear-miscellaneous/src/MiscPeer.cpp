@@ -31,8 +31,6 @@
 #include "MiscPeer.h"
 #include "MiscCentral.h"
 #include "GD.h"
-#include "sys/wait.h"
-#include "sys/stat.h"
 
 namespace Misc
 {
@@ -94,11 +92,7 @@ MiscPeer::~MiscPeer()
 			}
 			if(i == 30) GD::out.printError("Error: Script of peer " + std::to_string(_peerID) + " did not finish.");
 		}
-		if(_programPID != -1)
-		{
-			kill(_programPID, 15);
-			GD::out.printInfo("Info: Waiting for process with pid " + std::to_string(_programPID) + " started by peer " + std::to_string(_peerID) + "...");
-		}
+		if(_programScheduler) _programScheduler->remove(_peerID);
 		_stopRunProgramThread = true;
 		_bl->threadManager.join(_runProgramThread);
 	}
@@ -133,13 +127,7 @@ void MiscPeer::homegearShuttingDown()
 		}
 		if(i == 30) GD::out.printError("Error: Script of peer " + std::to_string(_peerID) + " did not finish.");
 
-		if(_programPID != -1)
-		{
-			kill(_programPID, 15);
-			_programPID = -1;
-		}
-
-		if(_programPID != -1) GD::out.printInfo("Info: Waiting for process with pid " + std::to_string(_programPID) + " started by peer " + std::to_string(_peerID) + "...");
+		if(_programScheduler) _programScheduler->remove(_peerID);
 		_bl->threadManager.join(_runProgramThread);
 	}
 	catch(const std::exception& ex)
@@ -161,7 +149,6 @@ void MiscPeer::runProgram()
 	try
 	{
 		if(!_rpcDevice->runProgram) return;
-		while(GD::bl->booting && !_stopRunProgramThread) std::this_thread::sleep_for(std::chrono::milliseconds(1000));
 		std::string path = _rpcDevice->runProgram->path;
 		if(path.empty()) return;
 		if(path.front() != '/') path = GD::bl->settings.scriptPath() + path;
@@ -172,82 +159,10 @@ void MiscPeer::runProgram()
 			GD::bl->hf.stringReplace(*i, "$RPCPORT", std::to_string(_bl->rpcPort));
 		}
 		if(_rpcDevice->runProgram->interval == 0) _rpcDevice->runProgram->interval = 10;
-		while(!_stopRunProgramThread)
-		{
-			_programPID = -1;
-			int64_t startTime = GD::bl->hf.getTime();
-			struct stat statStruct;
-			if(stat(path.c_str(), &statStruct) < 0)
-			{
-				GD::out.printError("Error: Could not execute script: " + std::string(strerror(errno)));
-				std::this_thread::sleep_for(std::chrono::milliseconds(_rpcDevice->runProgram->interval));
-				if(_rpcDevice->runProgram->startType == RunProgram::StartType::once) return;
-				std::this_thread::sleep_for(std::chrono::milliseconds(_rpcDevice->runProgram->interval));
-				continue;
-			}
 
-			uint32_t uid = getuid();
-			uint32_t gid = getgid();
-			if((statStruct.st_mode & S_IXOTH) == 0)
-			{
-				if(statStruct.st_gid != gid || (statStruct.st_gid == gid && (statStruct.st_mode & S_IXGRP) == 0))
-				{
-					if(statStruct.st_uid != uid || (statStruct.st_uid == uid && (statStruct.st_mode & S_IXUSR) == 0))
-					{
-						GD::out.printError("Error: Could not execute script. No permission or executable bit is not set.");
-						std::this_thread::sleep_for(std::chrono::milliseconds(_rpcDevice->runProgram->interval));
-						if(_rpcDevice->runProgram->startType == RunProgram::StartType::once) return;
-						continue;
-					}
-				}
-			}
-			if((statStruct.st_mode & (S_IXGRP | S_IXUSR)) == 0) //At least in Debian it is not possible to execute scripts, when the execution bit is only set for "other".
-			{
-				GD::out.printError("Error: Could not execute script. Executable bit is not set for user or group.");
-				std::this_thread::sleep_for(std::chrono::milliseconds(_rpcDevice->runProgram->interval));
-				if(_rpcDevice->runProgram->startType == RunProgram::StartType::once) return;
-				continue;
-			}
-			if((statStruct.st_mode & (S_IXUSR | S_IXGRP | S_IXOTH)) == 0)
-			{
-				GD::out.printError("Error: Could not execute script. The file mode is not set to executable.");
-				std::this_thread::sleep_for(std::chrono::milliseconds(_rpcDevice->runProgram->interval));
-				if(_rpcDevice->runProgram->startType == RunProgram::StartType::once) return;
-				continue;
-			}
-			_programPID = GD::bl->hf.system(path, arguments);
-			if(_programPID < 0)
-			{
-				GD::out.printError("Error: Could not execute script.");
-				std::this_thread::sleep_for(std::chrono::milliseconds(_rpcDevice->runProgram->interval));
-				if(_rpcDevice->runProgram->startType == RunProgram::StartType::once) return;
-				continue;
-			}
-			GD::out.printInfo("Info: Started program " + path + ". PID is " + std::to_string(_programPID) + ".");
-
-			if(_rpcDevice->runProgram->startType == RunProgram::StartType::once) return;
-			else if(_rpcDevice->runProgram->startType == RunProgram::StartType::interval)
-			{
-				int64_t totalTimeToSleep = (_rpcDevice->runProgram->interval * 1000) - (GD::bl->hf.getTime() - startTime);
-				if(totalTimeToSleep < 0) totalTimeToSleep = 0;
-				for(int32_t i = 0; i < (totalTimeToSleep / 100) + 1; i++)
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(100));
-				}
-			}
-			int32_t result = 0;
-			int32_t status = 0;
-			while(!_stopRunProgramThread && (result = waitpid(_programPID, &status, WNOHANG)) == 0)
-			{
-				std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-			}
-			if(result == -1)
-			{
-				GD::out.printCritical("Critical error executing waitpid: " + std::string(strerror(errno)) + ". Exiting run program thread of peer " + std::to_string(_peerID));
-				_programPID = -1;
-				return;
-			}
-		}
+		if(!_programScheduler) _programScheduler = GD::family->getProgramScheduler();
+		if(!_programScheduler) return;
+		_programScheduler->add(_peerID, path, arguments, _rpcDevice->runProgram->startType, _rpcDevice->runProgram->interval);
 	}
 	catch(const std::exception& ex)
 	{
@@ -261,7 +176,6 @@ void MiscPeer::runProgram()
 	{
 		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
 	}
-	_programPID = -1;
 }
 
 void MiscPeer::scriptFinished(BaseLib::ScriptEngine::PScriptInfo& scriptInfo, int32_t exitCode)
@@ -598,7 +512,7 @@ void MiscPeer::initProgram()
 			_bl->threadManager.join(_runProgramThread);
 			_stopRunProgramThread = false;
 			if(!_rpcDevice->runProgram->script.empty()) _bl->threadManager.start(_runProgramThread, true, &MiscPeer::runScript, this, false);
-			else _bl->threadManager.start(_runProgramThread, true, &MiscPeer::runProgram, this);
+			else runProgram();
 		}
 	}
 	catch(const std::exception& ex)
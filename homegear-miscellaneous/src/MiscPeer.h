@@ -32,6 +32,7 @@
 #define MISCPEER_H_
 
 #include <homegear-base/BaseLib.h>
+#include "ProgramScheduler.h"
 
 #include <list>
 
@@ -82,7 +83,7 @@ protected:
 	std::atomic_bool _scriptRunning;
 	std::atomic_bool _stopRunProgramThread;
 	std::thread _runProgramThread;
-	pid_t _programPID = -1;
+	std::shared_ptr<ProgramScheduler> _programScheduler;
 	std::mutex _scriptInfoMutex;
 	BaseLib::ScriptEngine::PScriptInfo _scriptInfo;
 
@@ -92,6 +93,10 @@ protected:
     virtual void saveVariables();
     virtual void savePeers() {}
 
+
+	/**
+	 * Passes the program of the peer to the family's ProgramScheduler.
+	 */
 	void runProgram();
 	void runScript(bool delay = false);
 	void scriptFinished(BaseLib::ScriptEngine::PScriptInfo& scriptInfo, int32_t exitCode);
@@ -53,6 +53,31 @@ void Miscellaneous::dispose()
 {
 	if(_disposed) return;
 	DeviceFamily::dispose();
+	std::lock_guard<std::mutex> programSchedulerGuard(_programSchedulerMutex);
+	if(_programScheduler) _programScheduler->stop();
+}
+
+std::shared_ptr<ProgramScheduler> Miscellaneous::getProgramScheduler()
+{
+	try
+	{
+		std::lock_guard<std::mutex> programSchedulerGuard(_programSchedulerMutex);
+		if(!_programScheduler) _programScheduler = std::make_shared<ProgramScheduler>();
+		return _programScheduler;
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+	return std::shared_ptr<ProgramScheduler>();
 }
 
 std::shared_ptr<BaseLib::Systems::ICentral> Miscellaneous::initializeCentral(uint32_t deviceId, int32_t address, std::string serialNumber)
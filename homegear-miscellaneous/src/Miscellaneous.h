@@ -32,6 +32,7 @@
 #define MISCELLANEOUS_H_
 
 #include <homegear-base/BaseLib.h>
+#include "ProgramScheduler.h"
 
 using namespace BaseLib;
 
@@ -48,7 +49,15 @@ public:
 
 	virtual bool hasPhysicalInterface() { return false; }
 	virtual PVariable getPairingMethods();
+
+	/**
+	 * Returns the scheduler running the external programs of all peers. It is created on first use.
+	 */
+	std::shared_ptr<ProgramScheduler> getProgramScheduler();
 protected:
+	std::mutex _programSchedulerMutex;
+	std::shared_ptr<ProgramScheduler> _programScheduler;
+
 	virtual std::shared_ptr<BaseLib::Systems::ICentral> initializeCentral(uint32_t deviceId, int32_t address, std::string serialNumber);
 	virtual void createCentral();
 };
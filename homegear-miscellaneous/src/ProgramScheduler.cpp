@@ -0,0 +1,348 @@
+/* Copyright 2013-2017 Sathya Laufer
+ *
+ * Homegear is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * 
+ * Homegear is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Homegear.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * 
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU Lesser General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+*/
+
+#include "ProgramScheduler.h"
+#include "GD.h"
+#include "sys/wait.h"
+#include "sys/stat.h"
+
+namespace Misc
+{
+
+ProgramScheduler::ProgramScheduler()
+{
+	_stopThreads = false;
+	GD::bl->threadManager.start(_timerThread, true, &ProgramScheduler::timerThread, this);
+	GD::bl->threadManager.start(_reaperThread, true, &ProgramScheduler::reaperThread, this);
+}
+
+ProgramScheduler::~ProgramScheduler()
+{
+	stop();
+}
+
+void ProgramScheduler::stop()
+{
+	try
+	{
+		{
+			std::lock_guard<std::mutex> programsGuard(_programsMutex);
+			if(_stopThreads) return;
+			_stopThreads = true;
+			_timerConditionVariable.notify_all();
+			_reaperConditionVariable.notify_all();
+		}
+		GD::bl->threadManager.join(_timerThread);
+		GD::bl->threadManager.join(_reaperThread);
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+
+void ProgramScheduler::add(uint64_t peerId, const std::string& path, const std::vector<std::string>& arguments, RunProgram::StartType::Enum startType, uint32_t interval)
+{
+	try
+	{
+		remove(peerId);
+
+		PProgram program = std::make_shared<Program>();
+		program->peerId = peerId;
+		program->path = path;
+		program->arguments = arguments;
+		program->startType = startType;
+		program->interval = (int64_t)interval * 1000;
+
+		std::lock_guard<std::mutex> programsGuard(_programsMutex);
+		_programs[peerId] = program;
+		schedule(program, GD::bl->hf.getTime());
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+
+void ProgramScheduler::remove(uint64_t peerId)
+{
+	try
+	{
+		std::lock_guard<std::mutex> programsGuard(_programsMutex);
+		auto programIterator = _programs.find(peerId);
+		if(programIterator == _programs.end()) return;
+		PProgram program = programIterator->second;
+		_programs.erase(programIterator);
+		if(program->pid != -1)
+		{
+			kill(program->pid, SIGTERM);
+			GD::out.printInfo("Info: Waiting for process with pid " + std::to_string(program->pid) + " started by peer " + std::to_string(peerId) + "...");
+			//The reaper thread collects the exit status, so the process doesn't stay a zombie.
+			_orphans.insert(program->pid);
+		}
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+
+void ProgramScheduler::schedule(PProgram& program, int64_t time)
+{
+	//Timers of older starts are ignored by comparing them with nextStart.
+	program->nextStart = time;
+	auto timerIterator = _timers.emplace(time, program->peerId);
+	if(timerIterator == _timers.begin()) _timerConditionVariable.notify_one();
+}
+
+pid_t ProgramScheduler::execute(const std::string& path, std::vector<std::string> arguments)
+{
+	try
+	{
+		struct stat statStruct;
+		if(stat(path.c_str(), &statStruct) < 0)
+		{
+			GD::out.printError("Error: Could not execute script: " + std::string(strerror(errno)));
+			return -1;
+		}
+
+		uint32_t uid = getuid();
+		uint32_t gid = getgid();
+		if((statStruct.st_mode & S_IXOTH) == 0)
+		{
+			if(statStruct.st_gid != gid || (statStruct.st_gid == gid && (statStruct.st_mode & S_IXGRP) == 0))
+			{
+				if(statStruct.st_uid != uid || (statStruct.st_uid == uid && (statStruct.st_mode & S_IXUSR) == 0))
+				{
+					GD::out.printError("Error: Could not execute script. No permission or executable bit is not set.");
+					return -1;
+				}
+			}
+		}
+		if((statStruct.st_mode & (S_IXGRP | S_IXUSR)) == 0) //At least in Debian it is not possible to execute scripts, when the execution bit is only set for "other".
+		{
+			GD::out.printError("Error: Could not execute script. Executable bit is not set for user or group.");
+			return -1;
+		}
+		if((statStruct.st_mode & (S_IXUSR | S_IXGRP | S_IXOTH)) == 0)
+		{
+			GD::out.printError("Error: Could not execute script. The file mode is not set to executable.");
+			return -1;
+		}
+		pid_t pid = GD::bl->hf.system(path, arguments);
+		if(pid < 0)
+		{
+			GD::out.printError("Error: Could not execute script.");
+			return -1;
+		}
+		GD::out.printInfo("Info: Started program " + path + ". PID is " + std::to_string(pid) + ".");
+		return pid;
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+	return -1;
+}
+
+void ProgramScheduler::timerThread()
+{
+	while(!_stopThreads)
+	{
+		try
+		{
+			PProgram program;
+			{
+				std::unique_lock<std::mutex> programsGuard(_programsMutex);
+				int64_t time = GD::bl->hf.getTime();
+				if(_timers.empty() || _timers.begin()->first > time)
+				{
+					//add() and the reaper thread wake us up when an earlier start is scheduled. The wait is limited in case the system time changes.
+					int64_t waitTime = _timers.empty() ? _maxTimerWait : _timers.begin()->first - time;
+					if(waitTime > _maxTimerWait) waitTime = _maxTimerWait;
+					_timerConditionVariable.wait_for(programsGuard, std::chrono::milliseconds(waitTime));
+					continue;
+				}
+
+				int64_t dueTime = _timers.begin()->first;
+				uint64_t peerId = _timers.begin()->second;
+				_timers.erase(_timers.begin());
+				auto programIterator = _programs.find(peerId);
+				if(programIterator == _programs.end() || programIterator->second->nextStart != dueTime) continue;
+				program = programIterator->second;
+
+				if(GD::bl->booting)
+				{
+					schedule(program, time + 1000);
+					continue;
+				}
+
+				if(program->pid != -1)
+				{
+					//The last run of an interval program is still running. Start it again, as soon as it finishes.
+					program->restartOnExit = true;
+					continue;
+				}
+			}
+
+			int64_t startTime = GD::bl->hf.getTime();
+			pid_t pid = execute(program->path, program->arguments);
+
+			std::lock_guard<std::mutex> programsGuard(_programsMutex);
+			auto programIterator = _programs.find(program->peerId);
+			if(programIterator == _programs.end() || programIterator->second != program)
+			{
+				//The program was removed while starting it.
+				if(pid != -1)
+				{
+					kill(pid, SIGTERM);
+					_orphans.insert(pid);
+				}
+				continue;
+			}
+
+			if(pid == -1)
+			{
+				if(program->startType == RunProgram::StartType::once) _programs.erase(programIterator);
+				else schedule(program, startTime + program->interval);
+				continue;
+			}
+
+			program->pid = pid;
+			program->restartOnExit = (program->startType == RunProgram::StartType::permanent);
+			if(program->startType == RunProgram::StartType::interval) schedule(program, startTime + program->interval);
+		}
+		catch(const std::exception& ex)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(BaseLib::Exception& ex)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(...)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+		}
+	}
+}
+
+void ProgramScheduler::reaperThread()
+{
+	while(!_stopThreads)
+	{
+		try
+		{
+			std::unique_lock<std::mutex> programsGuard(_programsMutex);
+			_reaperConditionVariable.wait_for(programsGuard, std::chrono::milliseconds(1000), [&] { return (bool)_stopThreads; });
+			if(_stopThreads) return;
+
+			int64_t time = GD::bl->hf.getTime();
+			int32_t status = 0;
+			for(auto programIterator = _programs.begin(); programIterator != _programs.end();)
+			{
+				PProgram& program = programIterator->second;
+				if(program->pid == -1)
+				{
+					++programIterator;
+					continue;
+				}
+				pid_t result = waitpid(program->pid, &status, WNOHANG);
+				if(result == 0)
+				{
+					++programIterator;
+					continue;
+				}
+				if(result == -1) GD::out.printError("Error: Could not get exit status of process with pid " + std::to_string(program->pid) + " started by peer " + std::to_string(program->peerId) + ": " + std::string(strerror(errno)));
+				program->pid = -1;
+
+				if(program->startType == RunProgram::StartType::once)
+				{
+					programIterator = _programs.erase(programIterator);
+					continue;
+				}
+				if(program->restartOnExit) schedule(program, time);
+				++programIterator;
+			}
+
+			for(auto orphanIterator = _orphans.begin(); orphanIterator != _orphans.end();)
+			{
+				if(waitpid(*orphanIterator, &status, WNOHANG) == 0) ++orphanIterator;
+				else orphanIterator = _orphans.erase(orphanIterator);
+			}
+		}
+		catch(const std::exception& ex)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(BaseLib::Exception& ex)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(...)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+		}
+	}
+}
+
+}
@@ -0,0 +1,114 @@
+/* Copyright 2013-2017 Sathya Laufer
+ *
+ * Homegear is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * 
+ * Homegear is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Homegear.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * 
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU Lesser General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+*/
+
+#ifndef PROGRAMSCHEDULER_H_
+#define PROGRAMSCHEDULER_H_
+
+#include <homegear-base/BaseLib.h>
+
+#include <condition_variable>
+#include <unordered_map>
+#include <map>
+#include <set>
+
+using namespace BaseLib::DeviceDescription;
+
+namespace Misc
+{
+
+/**
+ * Runs the external programs of all peers. Starting programs on time and waiting for them to finish is done by two threads shared by all peers instead of one thread per peer.
+ */
+class ProgramScheduler
+{
+public:
+	ProgramScheduler();
+	virtual ~ProgramScheduler();
+	void stop();
+
+	/**
+	 * Starts running a program for a peer. A program already running for the peer is replaced.
+	 *
+	 * @param peerId The ID of the peer the program belongs to.
+	 * @param path The absolute path to the executable.
+	 * @param arguments The program arguments.
+	 * @param startType Specifies, when the program is started (once, in an interval or restarted whenever it exits).
+	 * @param interval The interval in seconds for "interval" programs. Also used as delay before retrying a program that couldn't be started.
+	 */
+	void add(uint64_t peerId, const std::string& path, const std::vector<std::string>& arguments, RunProgram::StartType::Enum startType, uint32_t interval);
+
+	/**
+	 * Stops running the program of a peer. A running process is sent SIGTERM.
+	 */
+	void remove(uint64_t peerId);
+private:
+	struct Program
+	{
+		uint64_t peerId = 0;
+		std::string path;
+		std::vector<std::string> arguments;
+		RunProgram::StartType::Enum startType = RunProgram::StartType::once;
+		int64_t interval = 10000;
+		pid_t pid = -1;
+		int64_t nextStart = 0;
+		bool restartOnExit = false;
+	};
+	typedef std::shared_ptr<Program> PProgram;
+
+	std::atomic_bool _stopThreads;
+	std::mutex _programsMutex;
+	std::unordered_map<uint64_t, PProgram> _programs;
+	std::multimap<int64_t, uint64_t> _timers;
+	std::set<pid_t> _orphans;
+	std::condition_variable _timerConditionVariable;
+	std::condition_variable _reaperConditionVariable;
+	const int64_t _maxTimerWait = 10000;
+	std::thread _timerThread;
+	std::thread _reaperThread;
+
+	/**
+	 * Schedules the next start of a program. _programsMutex must be locked.
+	 */
+	void schedule(PProgram& program, int64_t time);
+
+	/**
+	 * Checks the executable and starts it.
+	 *
+	 * @return Returns the PID of the new process or -1 on error.
+	 */
+	pid_t execute(const std::string& path, std::vector<std::string> arguments);
+
+	void timerThread();
+	void reaperThread();
+};
+
+}
+
+#endif
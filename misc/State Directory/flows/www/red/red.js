@@ -554,6 +554,12 @@ RED.comms = (function() {
     }
 
     function homegearEvent(message) {
+        if(message.method == "nodeEvents") {
+            for(var i = 0; i < message.params[0].length; i++) {
+                homegearEvent({method: "nodeEvent", params: message.params[0][i]});
+            }
+            return;
+        }
         if(message.method == "nodeEvent") {
             if(message.params[2].format && !message.params[2].format.match(/string/g)) message.params[2].msg = JSON.stringify(message.params[2].msg);
             for (var t in subscriptions) {
@@ -13,7 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  **/
-var RED={};RED.events=function(){function a(a,b){d[a]=d[a]||[],d[a].push(b)}function b(a,b){var c=d[a];if(c)for(var e=0;e<c.length;e++)if(c[e]===b)return void c.splice(e,1)}function c(a,b){if(d[a])for(var c=0;c<d[a].length;c++)try{d[a][c](b)}catch(b){console.log("RED.events.emit error: ["+a+"] "+b.toString()),console.log(b)}}var d={};return{on:a,off:b,emit:c}}(),RED.i18n=function(){return{init:function(a){i18n.init({resGetPath:"locales/__ns__?lng=__lng__",dynamicLoad:!1,load:"current",ns:{namespaces:["editor","node-red","jsonata","infotips"],defaultNs:"editor"},fallbackLng:["en-US"],fallbackNS:["node-red","editor"],useCookie:!1},function(){a()}),RED._=function(){return i18n.t.apply(null,arguments)}},loadCatalog:function(a,b){i18n.loadNamespace(a,b)},loadNodeCatalogs:function(a){var b=i18n.functions.toLanguages(i18n.detectLanguage()),c=b.length;b.forEach(function(b){$.ajax({headers:{Accept:"application/json"},cache:!1,url:"locales/nodes?lng="+b,success:function(d){var e=Object.keys(d);e.forEach(function(a){i18n.addResourceBundle(b,a,d[a])}),c--,0===c&&a()}})})}}}(),RED.settings=function(){function a(a,b){if(!RED.settings.editorTheme)return b;var c=a.split("."),d=RED.settings.editorTheme;try{for(var e=0;e<c.length;e++)d=d[c[e]];return void 0===d?b:d}catch(a){return b}}var b={},c=function(){try{return"localStorage"in window&&null!==window.localStorage}catch(a){return!1}},d=function(a,b){c()&&localStorage.setItem(a,JSON.stringify(b))},e=function(a){if(c())return JSON.parse(localStorage.getItem(a))},f=function(a){c()&&localStorage.removeItem(a)},g=function(a){for(var c in b)b.hasOwnProperty(c)&&RED.settings.hasOwnProperty(c)&&delete RED.settings[c];for(c in a)a.hasOwnProperty(c)&&(RED.settings[c]=a[c]);b=a},h=function(a){var b=/[?&]access_token=(.*?)(?:$|&)/.exec(window.location.search);if(b){var c=b[1];RED.settings.set("auth-tokens",{access_token:c}),window.location.search=""}$.ajaxSetup({beforeSend:function(a,b){if(!/^\s*(https?:|\/|\.)/.test(b.url)){var c=RED.settings.get("auth-tokens");c&&a.setRequestHeader("Authorization","Bearer "+c.access_token),a.setRequestHeader("Node-RED-API-Version","v2")}}}),i(a)},i=function(a){$.ajax({headers:{Accept:"application/json"},dataType:"json",cache:!1,url:"settings",success:function(b){g(b),RED.settings.user&&!RED.settings.user.anonymous||RED.settings.remove("auth-tokens"),console.log("Node-BLUE: "+b.version),a()},error:function(b,c,d){401===b.status?(/[?&]access_token=(.*?)(?:$|&)/.test(window.location.search)&&(window.location.search=""),RED.user.login(function(){i(a)})):console.log("Unexpected error:",b.status,c)}})};return{init:h,load:i,set:d,get:e,remove:f,theme:a}}(),RED.user=function(){function a(a,b){"function"==typeof a&&(b=a,a={});var d=$('<div id="node-dialog-login" class="hide"><div style="display: inline-block;width: 250px; vertical-align: top; margin-right: 10px; margin-bottom: 20px;"><img id="node-dialog-login-image" src=""/></div><div style="display: inline-block; width: 250px; vertical-align: bottom; margin-left: 10px; margin-bottom: 20px;"><form id="node-dialog-login-fields" class="form-horizontal" style="margin-bottom: 0px;"></form></div></div>');d.dialog({autoOpen:!1,dialogClass:"ui-dialog-no-close",modal:!0,closeOnEscape:!!a.cancelable,width:600,resizable:!1,draggable:!1}),$("#node-dialog-login-fields").empty(),$.ajax({dataType:"json",url:"auth/login",success:function(e){var f=0;if("credentials"==e.type){for(;f<e.prompts.length;f++){var g=e.prompts[f],h=$("<div/>",{class:"form-row"});$('<label for="node-dialog-login-'+g.id+'">'+g.label+":</label><br/>").appendTo(h);var i=$('<input style="width: 100%" id="node-dialog-login-'+g.id+'" type="'+g.type+'" tabIndex="'+(f+1)+'"/>').appendTo(h);f<e.prompts.length-1&&i.keypress(function(){var a=h;return function(b){13==b.keyCode&&(a.next("div").find("input").focus(),b.preventDefault())}}()),h.appendTo("#node-dialog-login-fields")}$('<div class="form-row" style="text-align: right; margin-top: 10px;"><span id="node-dialog-login-failed" style="line-height: 2em;float:left;" class="hide">'+RED._("user.loginFailed")+'</span><img src="red/images/spin.svg" style="height: 30px; margin-right: 10px; " class="login-spinner hide"/>'+(a.cancelable?'<a href="#" id="node-dialog-login-cancel" style="margin-right: 20px;" tabIndex="'+(f+1)+'">'+RED._("common.label.cancel")+"</a>":"")+'<input type="submit" id="node-dialog-login-submit" style="width: auto;" tabIndex="'+(f+2)+'" value="'+RED._("user.login")+'"></div>').appendTo("#node-dialog-login-fields"),$("#node-dialog-login-submit").button(),$("#node-dialog-login-fields").submit(function(d){$("#node-dialog-login-submit").button("option","disabled",!0),$("#node-dialog-login-failed").hide(),$(".login-spinner").show();for(var f={client_id:"node-red-editor",grant_type:"password",scope:""},g=0;g<e.prompts.length;g++){var h=e.prompts[g];f[h.id]=$("#node-dialog-login-"+h.id).val()}$.ajax({url:"auth/token",type:"POST",data:f}).done(function(d,e,f){RED.settings.set("auth-tokens",d),$("#node-dialog-login").dialog("destroy").remove(),a.updateMenu&&c(),b()}).fail(function(a,b,c){RED.settings.remove("auth-tokens"),$("#node-dialog-login-failed").show()}).always(function(){$("#node-dialog-login-submit").button("option","disabled",!1),$(".login-spinner").hide()}),d.preventDefault()})}else if("strategy"==e.type)for(f=0;f<e.prompts.length;f++){var g=e.prompts[f],h=$("<div/>",{class:"form-row",style:"text-align: center"}).appendTo("#node-dialog-login-fields"),j=$('<a href="#"></a>',{style:"padding: 10px"}).appendTo(h).click(function(){document.location=g.url});if(g.image)$("<img>",{src:g.image}).appendTo(j);else if(g.label){var k=$("<span></span>").text(g.label);g.icon&&($("<i></i>",{class:"fa fa-2x "+g.icon,style:"vertical-align: middle"}).appendTo(j),k.css({verticalAlign:"middle",marginLeft:"8px"})),k.appendTo(j)}j.button()}a.cancelable&&$("#node-dialog-login-cancel").button().click(function(a){$("#node-dialog-login").dialog("destroy").remove()});var l=e.image||"red/images/node-red-256.png";$("#node-dialog-login-image").load(function(){d.dialog("open")}).attr("src",l)}})}function b(){$.ajax({url:"auth/revoke",type:"POST",data:{token:RED.settings.get("auth-tokens").access_token},success:function(a){RED.settings.remove("auth-tokens"),a&&a.redirect?document.location.href=a.redirect:document.location.reload(!0)}})}function c(){$("#btn-usermenu-submenu li").remove(),RED.settings.user.anonymous?RED.menu.addItem("btn-usermenu",{id:"usermenu-item-login",label:RED._("menu.label.login"),onselect:function(){RED.user.login({cancelable:!0},function(){RED.settings.load(function(){RED.notify(RED._("user.loggedInAs",{name:RED.settings.user.username}),"success"),c()})})}}):(RED.menu.addItem("btn-usermenu",{id:"usermenu-item-username",label:"<b>"+RED.settings.user.username+"</b>"}),RED.menu.addItem("btn-usermenu",{id:"usermenu-item-logout",label:RED._("menu.label.logout"),onselect:function(){RED.user.logout()}}))}function d(){if(RED.settings.user&&(!RED.settings.editorTheme||!RED.settings.editorTheme.hasOwnProperty("userMenu"))){var a=$('<li><a id="btn-usermenu" class="button hide" data-toggle="dropdown" href="#"></a></li>').prependTo(".header-toolbar");RED.settings.user.image?$('<span class="user-profile"></span>').css({backgroundImage:"url("+RED.settings.user.image+")"}).appendTo(a.find("a")):$('<i class="fa fa-user"></i>').appendTo(a.find("a")),RED.menu.init({id:"btn-usermenu",options:[]}),c()}}return{init:d,login:a,logout:b}}(),RED.comms=function(){function a(){return h}function b(a){var b;return(b=new RegExp("(?:^|; )"+encodeURIComponent(a)+"=([^;]*)").exec(document.cookie))?b[1]:null}function c(a){if("nodeEvent"==a.method){a.params[2].format&&!a.params[2].format.match(/string/g)&&(a.params[2].msg=JSON.stringify(a.params[2].msg));for(var b in j)if(j.hasOwnProperty(b)){var c=new RegExp("^"+b.replace(/([\[\]\?\(\)\\\\$\^\*\.|])/g,"\\$1").replace(/\+/g,"[^/]+").replace(/\/#$/,"(/.*)?")+"$");if(c.test(a.params[1])){var d=j[b];if(d)for(var e=0;e<d.length;e++)d[e](a.params[1],a.params[2])}}}}function d(){var a="https:"==window.location.protocol,d="",e=a?"443":"80",f=window.location.host.indexOf("]");if(f>-1)part2=window.location.host.substring(f),part2.length>2&&":"==part2.charAt(1)&&(e=part2.substring(2)),d=window.location.host.substring(0,f+1);else{var g=window.location.host.split(":");d=g[0],g.length>1&&(e=g[1])}var j=b("PHPSESSID");h=new HomegearWS(d,e,"hgflows",a,j),h.ready(function(){i&&(i.close(),i=null)}),h.error(function(a){i&&i.close(),i=RED.notify(RED._("notification.error",{message:RED._("notification.errors.lostConnection")}),"error",!0)}),h.event(c),h.connect()}function e(a,b){null==j[a]&&(j[a]=[]),j[a].push(b)}function f(a,b){if(j[a]){for(var c=0;c<j[a].length;c++)if(j[a][c]===b){j[a].splice(c,1);break}0===j[a].length&&delete j[a]}}function g(){h.invoke("getNodeEvents",function(a){for(var b in a.result)if(a.result.hasOwnProperty(b)){var c=a.result[b];for(var d in c)if(c.hasOwnProperty(d)){var e=c[d];e.format&&!e.format.match(/string/g)&&(e.msg=JSON.stringify(e.msg));for(var f in j)if(j.hasOwnProperty(f)){var g=new RegExp("^"+f.replace(/([\[\]\?\(\)\\\\$\^\*\.|])/g,"\\$1").replace(/\+/g,"[^/]+").replace(/\/#$/,"(/.*)?")+"$");if(g.test(d)){var h=j[f];if(h)for(var i=0;i<h.length;i++)h[i](d,e)}}}}})}var h=null,i=null,j={};return{homegear:a,connect:d,subscribe:e,unsubscribe:f,getEvents:g}}(),RED.text={},RED.text.bidi=function(){function a(a){for(var d=a.length,e=0;e<d;e++){if(b(a.charCodeAt(e)))return!0;if(c(a.charCodeAt(e)))return!1}return!1}function b(a){return a>=1488&&a<=1535||a>=1536&&a<=1631||a>=1642&&a<=1775||a>=1786&&a<=2047||a>=64285&&a<=65023||a>=65136&&a<=65276}function c(a){return a>64&&a<91||a>96&&a<123}function d(b){return"auto"==j?a(b)?"rtl":"ltr":j}function e(){$(this).attr("dir",d($(this).val()))}function f(a){a.on("keyup",e).on("paste",e).on("cut",e),e.call(a)}function g(a){if(a){var b=d(a);if("ltr"==b)return k+a+m;if("rtl"==b)return l+a+m}return a}function h(){$("#workspace").find("span.bidiAware").each(function(){$(this).attr("dir",d($(this).html()))}),$("#sidebar").find("span.bidiAware").each(function(){$(this).attr("dir",d($(this).text()))})}function i(a){j=a,RED.nodes.eachNode(function(a){a.dirty=!0}),RED.view.redraw(),RED.palette.refresh(),h()}var j="",k="‪",l="‫",m="‬";return{setTextDirection:i,enforceTextDirectionWithUCC:g,resolveBaseTextDir:d,prepareInput:f}}(),RED.text.format=function(){function a(a){switch(a){case"breadcrumb":return j;case"comma":return k;case"email":return l;case"filepath":return m;case"formula":return n;case"sql":return o;case"underscore":return p;case"url":return q;case"word":return r;case"xpath":return s;default:return t}}function b(a){var b=window.navigator.userAgent;if(b.indexOf("MSIE")>=0||b.indexOf("Trident")>=0||b.indexOf("Edge")>=0)return!1;var c=document.createElement(a.tagName);c.contentEditable=!0;var d="oninput"in c;return d||(c.setAttribute("oninput","return;"),d="function"==typeof c.oninput),c=null,d}function c(a,c,e,f,g){if(!a||1!=a.nodeType)return!1;u||(u=document.createEvent("Event"),u.initEvent("TF",!0,!0)),a.setAttribute("data-tf-type",c);var i="undefined"===e?"{}":JSON.stringify(Array.isArray(e)?e[0]:e);a.setAttribute("data-tf-args",i);var j="ltr";if("undefined"===f&&(a.dir?j=a.dir:a.style&&a.style.direction&&(j=a.style.direction),f="rtl"===j.toLowerCase()),a.setAttribute("data-tf-dir",f),a.setAttribute("data-tf-locale",h.getLocaleDetails(g).lang),b(a)){a.oninput;a.oninput=function(a){d(a.target)}}else a.onkeyup=function(b){d(b.target),a.dispatchEvent(u)},a.onmouseup=function(b){d(b.target),a.dispatchEvent(u)};return d(a),!0}function d(b){var c=b.textContent||"",d=document.getSelection();if(0===c.length||!d||d.rangeCount<=0)return void b.dispatchEvent(u);var e,f,g=d.getRangeAt(0),h=g.cloneRange();e=g.startContainer,f=g.startOffset;var i=0;3===e.nodeType&&(i+=f),h.setStart(b,0),h.setEndBefore(e);var j=document.createElement("div");j.appendChild(h.cloneContents()),i+=j.textContent.length,b.innerHTML=a(b.getAttribute("data-tf-type")).format(c,JSON.parse(b.getAttribute("data-tf-args")),"true"===b.getAttribute("data-tf-dir"),!0,b.getAttribute("data-tf-locale"));var k=b,l=b,m=0,n=!1;for(d.removeAllRanges(),g.setStart(b,0),g.setEnd(b,0);l;){if(3===l.nodeType){if(m+l.nodeValue.length>=i){g.setStart(l,i-m);break}m+=l.nodeValue.length,l=l.nextSibling}else{if(l.hasChildNodes()){k=l,l=k.firstChild;continue}l=l.nextSibling}for(;!l;){if(k===b){n=!0;break}l=k.nextSibling,k=k.parentNode}if(n)break}d.addRange(g),b.dispatchEvent(u)}var e=function(){var a=function(a){this.content="",this.actual="",this.textDirection="",this.localGui="",this.isVisible=!0,this.isSeparator=!1,this.isParsed=!1,this.keep=!1,this.inBounds=!1,this.inPoints=!1;var b="";for(b in a)a.hasOwnProperty(b)&&(this[b]=a[b])};return a}(),f=function(){function a(a){if(!a)return!1;"undefined"==typeof a.start&&(a.start=""),"undefined"==typeof a.end&&(a.end=""),"undefined"!=typeof a.startAfter?(a.start=a.startAfter,a.after=!0):a.after=!1,"undefined"!=typeof a.endBefore?(a.end=a.endBefore,a.before=!0):a.before=!1;var b=parseInt(a.startPos,10);isNaN(b)?a.usePos=!1:a.usePos=!0;var c=parseInt(a.length,10);return isNaN(c)?a.useLength=!1:a.useLength=!0,a.loops="undefined"==typeof a.loops||!!a.loops,!0}function b(a,b){var c={};for(var d in b)b.hasOwnProperty(d)&&(c[d]=b[d]);var e=a.content,f=c.usePos&&c.startPos<e.length;f&&(c.start="",c.loops=!1),c.bStart=f?c.startPos:c.start.length>0?e.indexOf(c.start):0;var g=c.useLength&&c.length>0&&c.bStart+c.length<e.length;return g&&(c.end=""),c.bEnd=g?c.bStart+c.length:c.end.length>0?e.indexOf(c.end,c.bStart+c.start.length)+1:e.length,c.after||(c.start=""),c.before||(c.end=""),c}return{handleSubcontents:function(a,b,c,d,f){if(!c.content||"string"!=typeof c.content||0===c.content.length)return a;var g=!0;"undefined"!=typeof c.loops&&(g=!!c.loops);for(var h=0;!0&&!(h>=a.length);h++)if(!(a[h].isParsed||a.keep||a[h].isSeparator)){var i=a[h].content,j=i.indexOf(c.content);if(!(j<0)){var k,l=0;if(c.continued){do l++,k=i.indexOf(c.content,j+l*c.content.length);while(0===k)}else l=1;if(k=j+l*c.content.length,a.splice(h,1),j>0&&(a.splice(h,0,new e({content:i.substring(0,j),localGui:b.dir,keep:!0})),h++),a.splice(h,0,new e({content:i.substring(j,k),textDirection:c.subDir,localGui:b.dir})),k<i.length&&a.splice(h+1,0,new e({content:i.substring(k,i.length),localGui:b.dir,keep:!0})),!g)break}}},handleBounds:function(c,d,f,g,h){for(var i=0;i<f.length;i++)if(a(f[i]))for(var j=0;!0&&!(j>=c.length);j++)if(!(c[j].isParsed||c[j].inBounds||c.keep||c[j].isSeparator)){var k=b(c[j],f[i]),l=k.bStart,m=k.bEnd;if(!(l<0||m<0)){var n=c[j].content;if(c.splice(j,1),l>0&&(c.splice(j,0,new e({content:n.substring(0,l),localGui:d.dir,keep:!0})),j++),k.start&&(c.splice(j,0,new e({content:k.start,localGui:d.dir,isSeparator:!0})),j++),c.splice(j,0,new e({content:n.substring(l+k.start.length,m-k.end.length),textDirection:k.subDir,localGui:d.dir,inBounds:!0})),k.end&&(j++,c.splice(j,0,new e({content:k.end,localGui:d.dir,isSeparator:!0}))),m+k.end.length<n.length&&c.splice(j+1,0,new e({content:n.substring(m+k.end.length,n.length),localGui:d.dir,keep:!0})),!k.loops)break}}for(i=0;i<c.length;i++)c[i].inBounds=!1;return c},handleCases:function(a,b,c,d,e){if(0===c.length)return a;var f={};for(var g in b)b.hasOwnProperty(g)&&(f[g]=b[g]);for(var h=0;h<c.length;h++)c[h].handler&&"function"==typeof c[h].handler.handle||(c[h].handler=b.commonHandler),c[h].args?(f.cases=c[h].args.cases,f.points=c[h].args.points,f.bounds=c[h].args.bounds,f.subs=c[h].args.subs):(f.cases=[],f.points=[],f.bounds=[],f.subs={}),c[h].handler.handle(d,a,f,e);return a},handlePoints:function(a,b,c,d,f){for(var g=0;g<c.length;g++)for(var h=0;!0&&!(h>=a.length);h++)if(!(a[h].isParsed||a[h].keep||a[h].isSeparator)){var i=a[h].content,j=i.indexOf(c[g]);j>=0&&(a.splice(h,1),j>0&&(a.splice(h,0,new e({content:i.substring(0,j),textDirection:b.subDir,localGui:b.dir,inPoints:!0})),h++),a.splice(h,0,new e({content:c[g],localGui:b.dir,isSeparator:!0})),j+c[g].length+1<=i.length&&a.splice(h+1,0,new e({content:i.substring(j+c[g].length),textDirection:b.subDir,localGui:b.dir,inPoints:!0})))}for(g=0;g<a.length;g++)a[g].keep?a[g].keep=!1:a[g].inPoints&&(a[g].isParsed=!0,a[g].inPoints=!1);return a}}}(),g=function(){return{handle:function(a,b,c,d){var e=[];Array.isArray(c.cases)&&(e=c.cases);var g=[];"undefined"!=typeof c.points&&(Array.isArray(c.points)?g=c.points:"string"==typeof c.points&&(g=c.points.split("")));var h={};"object"==typeof c.subs&&(h=c.subs);var i=[];return Array.isArray(c.bounds)&&(i=c.bounds),f.handleBounds(b,c,i,a,d),f.handleSubcontents(b,c,h,a,d),f.handleCases(b,c,e,a,d),f.handlePoints(b,c,g,a,d),b}}}(),h=function(){var a=function(a){var b=a?a.split("-")[0]:"";return!(!b||b.length<2)&&["iw","he","ar","fa","ur"].some(function(a){return a===b})},b="‪",c="‫",d="‬",e="‎",f="‏",g="‭",h="‮";return{LRE:b,RLE:c,PDF:d,LRM:e,RLM:f,LRO:g,RLO:h,getLocaleDetails:function(b){if(b||(b="undefined"==typeof navigator?"":navigator.language||navigator.userLanguage||""),b=b.toLowerCase(),a(b)){var c=b.split("-");return{lang:c[0],country:c[1]?c[1]:""}}return{lang:"not-bidi"}},removeUcc:function(a){return a?a.replace(/[\u200E\u200F\u202A-\u202E]/g,""):a},removeTags:function(a){return a?a.replace(/<[^<]*>/g,""):a},getDirection:function(a,b,c,d){if("auto"!==b&&/^(rtl|ltr)$/i.test(b))return b;c=/^(rtl|ltr)$/i.test(c)?c:"ltr";var e=d?a.split("").reverse().join(""):a,f=/[A-Za-z\u05d0-\u065f\u066a-\u06ef\u06fa-\u07ff\ufb1d-\ufdff\ufe70-\ufefc]/.exec(e);return f?f[0]<="z"?"ltr":"rtl":c},hasArabicChar:function(a){var b=/[\u0600-\u065f\u066a-\u06ef\u06fa-\u07ff\ufb1d-\ufdff\ufe70-\ufefc]/.exec(a);return!!b},showMarks:function(a,i){for(var j="",k=0;k<a.length;k++){var l=""+a.charAt(k);switch(l){case e:j+="<LRM>";break;case f:j+="<RLM>";break;case b:j+="<LRE>";break;case c:j+="<RLE>";break;case g:j+="<LRO>";break;case h:j+="<RLO>";break;case d:j+="<PDF>";break;default:j+=l}}var m="undefined"!=typeof i&&/^(rtl|ltr)$/i.test(i)?"rtl"===i?h:g:"";return m+j+(""===m?"":d)},hideMarks:function(a){var b=a.replace(/<LRM>/g,this.LRM).replace(/<RLM>/g,this.RLM).replace(/<LRE>/g,this.LRE);return b.replace(/<RLE>/g,this.RLE).replace(/<LRO>/g,this.LRO).replace(/<RLO>/g,this.RLO).replace(/<PDF>/g,this.PDF)},showTags:function(a){return"<xmp>"+a+"</xmp>"},hideTags:function(a){return a.replace(/<xmp>/g,"").replace(/<\/xmp>/g,"")}}}(),i=function(){function a(a,b,e,f){return a&&b?d(c(a,b,f),b,e):a}function b(a,b){var c=Array.isArray(a)?a[0]:a;return c.guiDir||(c.guiDir="ltr"),c.dir||(c.dir=c.guiDir),b?("undefined"==typeof c.points&&(c.points=[]),c.cases||(c.cases=[]),c.bounds||(c.bounds=[]),c.commonHandler=g,c):c}function c(a,c,d){if(!a||!c)return new e({content:""});var f=b(c,!0),h=[new e({content:a,actual:a,localGui:f.dir})],i=g.handle;return f.handler&&"function"==typeof f.handler&&(i=f.handler.handle),i(a,h,f,d),h}function d(a,c,d){var e=b(c,!1);return d?i(a,e):f(a,e)}function f(a,b,c){for(var d="",e="",f="",g=!1,i=0;i<a.length;i++)if(a[i].isVisible){var j=a[i].textDirection,k=a[i].localGui;if(""!==k&&""===f?d+="rtl"===k?h.RLE:h.LRE:""===f||""!==k&&k===f&&!g||(d+=h.PDF+(i==a.length-1&&""!==k?"":"rtl"===b.dir?h.RLM:h.LRM),""!==k&&(d+="rtl"===k?h.RLE:h.LRE)),"auto"===j&&(j=h.getDirection(a[i].content,j,b.guiDir)),/^(rtl|ltr)$/i.test(j)?(d+=("rtl"===j?h.RLE:h.LRE)+a[i].content+h.PDF,e=j):(d+=a[i].content,e=h.getDirection(a[i].content,j,b.guiDir,!0)),i<a.length-1){var l=k&&a[i+1].localGui?k:b.dir;d+="rtl"===l?h.RLM:h.LRM}else""!==f&&(d+=h.PDF);f=k,g=!1}else g=!0;var m="auto"===b.dir?h.getDirection(a[0].actual,b.dir,b.guiDir):b.dir;return m!==b.guiDir&&(d=("rtl"===m?h.RLE:h.LRE)+d+h.PDF),d}function i(a,b,c){for(var d="",e="",f="",g=0;g<a.length;g++)if(a[g].isVisible){var i=a[g].textDirection,j=a[g].localGui;if(""!==j&&""===f?d+="<bdi dir='"+("rtl"===j?"rtl":"ltr")+"'>":""===f||""!==j&&j===f&&!stop||(d+="</bdi>"+(g==a.length-1&&""!==j?"":"<span style='unicode-bidi: embed; direction: "+("rtl"===b.dir?"rtl":"ltr")+";'></span>"),""!==j&&(d+="<bdi dir='"+("rtl"===j?"rtl":"ltr")+"'>")),"auto"===i&&(i=h.getDirection(a[g].content,i,b.guiDir)),/^(rtl|ltr)$/i.test(i)?(d+="<bdi dir='"+("rtl"===i?"rtl":"ltr")+"'>"+a[g].content+"</bdi>",e=i):(d+=a[g].content,e=h.getDirection(a[g].content,i,b.guiDir,!0)),g<a.length-1){var k=j&&a[g+1].localGui?j:b.dir;d+="<span style='unicode-bidi: embed; direction: "+("rtl"===k?"rtl":"ltr")+";'></span>"}else""!==f&&(d+="</bdi>");f=j,stop=!1}else stop=!0;var l="auto"===b.dir?h.getDirection(a[0].actual,b.dir,b.guiDir):b.dir;return l!==b.guiDir&&(d="<bdi dir='"+("rtl"===l?"rtl":"ltr")+"'>"+d+"</bdi>"),d}function j(a,b){return a}var k={};return k.parseAndDisplayStructure=a,k.parseStructure=c,k.displayStructure=d,k.restore=j,k}(),j=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:b.dir?b.dir:c?"rtl":"ltr",subs:{content:">",continued:!0,subDir:c?"rtl":"ltr"},cases:[{args:{subs:{content:"<",continued:!0,subDir:c?"ltr":"rtl"}}}]};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),k=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:","};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),l=function(){function a(a,b){if("ar"!==h.getLocaleDetails(b).lang)return"ltr";var c=a.indexOf("@");return c>0&&c<a.length-1&&h.hasArabicChar(a.substring(c+1))?"rtl":"ltr"}return{format:function(b,c,d,e,f,h){var j={guiDir:d?"rtl":"ltr",dir:a(b,f),points:"<>.:,;@",cases:[{handler:g,args:{bounds:[{startAfter:'"',endBefore:'"'},{startAfter:"(",endBefore:")"}],points:""}}]};return h?i.parseStructure(b,j,!!e,f):i.parseAndDisplayStructure(b,j,!!e,f)}}}(),m=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:"/\\:."};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),n=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:" /%^&[]<>=!?~:.,|()+-*{}"};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),o=function(){return{format:function(a,b,c,d,e,f){var h={guiDir:c?"rtl":"ltr",dir:"ltr",points:"\t!#%&()*+,-./:;<=>?|[]{}",cases:[{handler:g,args:{bounds:[{startAfter:"/*",endBefore:"*/"},{startAfter:"--",end:"\n"},{startAfter:"--"}]}},{handler:g,args:{subs:{content:" ",continued:!0}}},{handler:g,args:{bounds:[{startAfter:"'",endBefore:"'"},{startAfter:'"',endBefore:'"'}]}}]};return f?i.parseStructure(a,h,!!d,e):i.parseAndDisplayStructure(a,h,!!d,e)}}}(),p=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:"_"};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),q=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:":?#/@.[]="};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),r=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:b.dir?b.dir:c?"rtl":"ltr",points:" ,.!?;:"};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),s=function(){return{format:function(a,b,c,d,e,f){var h={guiDir:c?"rtl":"ltr",dir:"ltr",points:" /[]<>=!:@.|()+-*",cases:[{handler:g,args:{bounds:[{startAfter:'"',endBefore:'"'},{startAfter:"'",endBefore:"'"}],points:""}}]};return f?i.parseStructure(a,h,!!d,e):i.parseAndDisplayStructure(a,h,!!d,e)}}}(),t=function(){return{format:function(a,b,c,d,e,f){var g={},h="",j=Array.isArray(b)?b[0]:b;for(h in j)j.hasOwnProperty(h)&&(g[h]=j[h]);return g.guiDir=c?"rtl":"ltr",g.dir=g.dir?g.dir:g.guiDir,f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),u=(function(){function b(a){return"he"===a||"iw"===a||"ar"===a?"rtl":"ltr"}function c(a){0===a.msgDir.length&&(a.msgDir=b(a.msgLang)),a.msgDir="ltr"!==a.msgDir&&"rtl"!==a.msgDir&&"auto"!=a.msgDir?"ltr":a.msgDir,0===a.guiDir.length&&(a.guiDir=a.msgDir),a.guiDir="rtl"!==a.guiDir?"ltr":"rtl",0===a.phDir.length&&(a.phDir=0===a.phLang.length?a.msgDir:b(a.phLang)),a.phDir="ltr"!==a.phDir&&"rtl"!==a.phDir&&"auto"!=a.phDir?"ltr":a.phDir,"string"==typeof a.phPacking&&(a.phPacking=a.phPacking.split("")),a.phPacking.length<2&&(a.phPacking=["{","}"])}var d={msgLang:"en",msgDir:"",phLang:"",phDir:"",phPacking:["{","}"],phStt:{type:"none",args:{}},guiDir:""},f=!1;return{setDefaults:function(a){for(var b in a)d.hasOwnProperty(b)&&(d[b]=a[b]);c(d),f=!0},format:function(b){f||(c(d),f=!0);var g=!1,h=!1,j=d.phPacking[0].length,k=d.phPacking[1].length;if(arguments.length>0){var l=arguments[arguments.length-1];"boolean"==typeof l&&(g=l,h=!0)}for(var m,n=new RegExp(d.phPacking[0]+"\\d+"+d.phPacking[1]),o=[],p=0,q=b;null!=(m=n.exec(q));){var r=q.indexOf(m[0])+m[0].length;r>m[0].length&&o.push({text:q.substring(0,r-m[0].length),ph:!1}),o.push({text:m[0],ph:!0}),p+=r,q=q.substring(r,q.length)}p<b.length&&o.push({text:b.substring(p,b.length),ph:!1});for(var s=[],t=1;t<arguments.length-(h?1:0);t++){var u=arguments[t],v=u,w=!1,x=0;if(Array.isArray(v)){if(u=v[0],"undefined"==typeof u)continue;w=!0}do"string"==typeof u?s.push({text:u,dir:d.phDir,stt:d.stt}):"boolean"==typeof u?g=u:"object"==typeof u?(s.push(u),u.hasOwnProperty("text")||(s[s.length-1].text="{???}"),u.hasOwnProperty("dir")&&0!==u.dir.length||(s[s.length-1].dir=d.phDir),(!u.hasOwnProperty("stt")||"string"==typeof u.stt&&0===u.stt.length||"object"==typeof u.stt&&0===Object.keys(u.stt).length)&&(s[s.length-1].stt=d.phStt)):s.push({text:""+u,dir:d.phDir,stt:d.phStt}),w&&(x++,x==v.length?w=!1:u=v[x]);while(w)}var y=[];for(t=0;t<o.length;t++){var z=o[t];if(z.ph){var A=parseInt(z.text.substring(j,z.text.length-k));if(isNaN(A)||A>=s.length){y.push(new e({content:z.text,textDirection:d.msgDir}));continue}var B="none";if(s[A].stt||(s[A].stt=d.phStt),s[A].stt&&("string"==typeof s[A].stt?B=s[A].stt:s[A].stt.hasOwnProperty("type")&&(B=s[A].stt.type)),"none"!==B.toLowerCase()){for(var C=a(B).format(s[A].text,s[A].stt.args||{},"rtl"===d.msgDir,!1,d.msgLang,!0),D=0;D<C.length;D++)y.push(C[D]);y.push(new e({isVisible:!1}))}else y.push(new e({content:s[A].text,textDirection:s[A].dir?s[A].dir:d.phDir}))}else y.push(new e({content:z.text,textDirection:d.msgDir}))}var E=i.displayStructure(y,{guiDir:d.guiDir,dir:d.msgDir},g);return E}}}(),null);return{getHtml:function(b,c,d,e,f){return a(c).format(b,d,e,!0,f)},attach:function(a,b,d,e,f){return c(a,b,d,e,f)}}}(),RED.state={DEFAULT:0,MOVING:1,JOINING:2,MOVING_ACTIVE:3,ADDING:4,EDITING:5,EXPORT:6,IMPORT:7,IMPORT_DRAGGING:8,QUICK_JOINING:9},RED.nodes=function(){function a(a){N=a,RED.events.emit("nodes:change",{dirty:N})}function b(){return(1+4294967295*Math.random()).toString(16)}function c(a){if(0!==a.type.indexOf("subflow")?a._=a._def._:a._=RED._,"config"==a._def.category)H[a.id]=a;else{if(a.inputPorts=[],a.inputs)for(var b=0;b<a.inputs;b++)a.inputPorts.push(b);if(a.outputPorts=[],a.wires&&a.wires.length>a.outputs&&(a.outputs=a.wires.length),a.outputs)for(var b=0;b<a.outputs;b++)a.outputPorts.push(b);if(a.dirty=!0,B(a),"subflows"==a._def.category&&"undefined"==typeof a.i){var c=0;RED.nodes.eachNode(function(a){c=Math.max(c,a.i||0)}),a.i=c+1}G.push(a)}RED.events.emit("nodes:add",a)}function d(a){I.push(a)}function e(a){if(a in H)return H[a];for(var b in G)if(G[b].id==a)return G[b];return null}function f(a){var b,c=[],d=[];if(a in H)b=H[a],delete H[a],RED.events.emit("nodes:remove",b),RED.workspaces.refresh();else if(b=e(a)){G.splice(G.indexOf(b),1),c=I.filter(function(a){return a.source===b||a.target===b}),c.forEach(function(a){I.splice(I.indexOf(a),1)});var g=!1;for(var h in b._def.defaults)if(b._def.defaults.hasOwnProperty(h)){var i=b._def.defaults[h];if(i.type){var j=O.getNodeType(i.type);if(j&&"config"==j.category){var k=H[b[h]];if(k)if(g=!0,k._def.exclusive)f(b[h]),d.push(k);else{var l=k.users;l.splice(l.indexOf(b),1)}}}}g&&RED.workspaces.refresh(),RED.events.emit("nodes:remove",b)}return b&&b._def.onremove&&b._def.onremove.call(n),{links:c,nodes:d}}function g(a){var b=I.indexOf(a);b!=-1&&I.splice(b,1)}function h(a){J[a.id]=a,a._def={defaults:{label:{value:""},disabled:{value:!1},info:{value:""}}},K.push(a.id)}function j(a){return J[a]}function k(a){delete J[a],K.splice(K.indexOf(a),1);var b,c,d=[],e=[];for(b=0;b<G.length;b++)c=G[b],c.z==a&&d.push(c);for(b in H)H.hasOwnProperty(b)&&(c=H[b],c.z==a&&d.push(c));for(b=0;b<d.length;b++){var g=f(d[b].id);e=e.concat(g.links)}return{nodes:d,links:e}}function l(a,b){if(b){var c=Object.keys(L).map(function(a){return L[a].name});c.sort();var d=1,e=a.name;c.forEach(function(b){e==b&&(d++,e=a.name+" ("+d+")")}),a.name=e}L[a.id]=a,RED.nodes.registerType("subflow:"+a.id,{defaults:{name:{value:""}},info:a.info,icon:"subflow.png",category:"subflows",inputs:a.in.length,outputs:a.out.length,color:"#da9",label:function(){return this.name||RED.nodes.subflow(a.id).name},labelStyle:function(){return this.name?"node_label_italic":""},paletteLabel:function(){return RED.nodes.subflow(a.id).name},inputLabels:function(b){return a.inputLabels?a.inputLabels[b]:null},outputLabels:function(b){return a.outputLabels?a.outputLabels[b]:null},set:{module:"node-red"}}),a._def=RED.nodes.getType("subflow:"+a.id)}function m(a){return L[a]}function o(a){delete L[a.id],O.removeNodeType("subflow:"+a.id)}function p(a,b){for(var c=0;c<G.length;c++){var d=G[c];if(d.z===a){var e=/^subflow:(.+)$/.exec(d.type);if(e){if(e[1]===b)return!0;var f=p(e[1],b);if(f)return!0}}}return!1}function q(a){var b={};b[a.id]=!0;for(var c=[a],d=[a];0!==d.length;)for(var e=d.shift(),f=I.filter(function(a){return a.source===e||a.target===e}),g=0;g<f.length;g++){var h=f[g].source===e?f[g].target:f[g].source,i=h.id;i||(i=h.direction+":"+h.i),b[i]||(b[i]=!0,c.push(h),d.push(h))}return c}function r(a){var b={};b.id=a.id,b.type=a.type,b.namespace=a.namespace?a.namespace:a.type;for(var c in a._def.defaults)a._def.defaults.hasOwnProperty(c)&&(b[c]=a[c]);return b}function s(a,b){if("tab"===a.type)return r(a);b=b||!1;var c={};if(c.id=a.id,c.type=a.type,c.namespace=a._def.namespace?a._def.namespace:a.type,c.z=a.z,"unknown"==c.type)for(var d in a._orig)a._orig.hasOwnProperty(d)&&(c[d]=a._orig[d]);else{for(var e in a._def.defaults)a._def.defaults.hasOwnProperty(e)&&(c[e]=a[e]);if(b&&a.credentials){var f={};c.credentials={};for(var g in a._def.credentials)a._def.credentials.hasOwnProperty(g)&&("password"==a._def.credentials[g].type?(!a.credentials._||a.credentials["has_"+g]!=a.credentials._["has_"+g]||a.credentials["has_"+g]&&a.credentials[g])&&(f[g]=a.credentials[g]):null==a.credentials[g]||a.credentials._&&a.credentials[g]==a.credentials._[g]||(f[g]=a.credentials[g]));Object.keys(f).length>0&&(c.credentials=f)}}if("config"!=a._def.category){c.x=a.x,c.y=a.y,c.wires=[];for(var h=0;h<a.outputs;h++)c.wires.push([]);for(var i=I.filter(function(b){return b.source===a}),j=0;j<i.length;j++){var k=i[j];"subflow"!=k.target.type&&c.wires[k.sourcePort].push({id:k.target.id,port:k.targetPort})}a.inputs>0&&a.inputLabels&&!/^\s*$/.test(a.inputLabels.join(""))&&(c.inputLabels=a.inputLabels.slice()),a.outputs>0&&a.outputLabels&&!/^\s*$/.test(a.outputLabels.join(""))&&(c.outputLabels=a.outputLabels.slice())}return c}function t(a){var b={};return b.id=a.id,b.type=a.type,b.namespace=a.namespace?a.namespace:a.type,b.name=a.name,b.info=a.info,b.in=[],b.out=[],a.in.forEach(function(a){for(var c={x:a.x,y:a.y,wires:[]},d=I.filter(function(b){return b.source===a}),e=0;e<d.length;e++){var f=d[e];"subflow"!=f.target.type&&c.wires.push({id:f.target.id,port:d[e].targetPort})}b.in.push(c)}),a.out.forEach(function(c,d){var e={x:c.x,y:c.y,wires:[]},f=I.filter(function(a){return a.target===c});for(i=0;i<f.length;i++)"subflow"!=f[i].source.type?e.wires.push({id:f[i].source.id,port:f[i].sourcePort}):e.wires.push({id:a.id,port:f[i].sourcePort});b.out.push(e)}),b.in.length>0&&a.inputLabels&&!/^\s*$/.test(a.inputLabels.join(""))&&(b.inputLabels=a.inputLabels.slice()),b.out.length>0&&a.outputLabels&&!/^\s*$/.test(a.outputLabels.join(""))&&(b.outputLabels=a.outputLabels.slice()),
+var RED={};RED.events=function(){function a(a,b){d[a]=d[a]||[],d[a].push(b)}function b(a,b){var c=d[a];if(c)for(var e=0;e<c.length;e++)if(c[e]===b)return void c.splice(e,1)}function c(a,b){if(d[a])for(var c=0;c<d[a].length;c++)try{d[a][c](b)}catch(b){console.log("RED.events.emit error: ["+a+"] "+b.toString()),console.log(b)}}var d={};return{on:a,off:b,emit:c}}(),RED.i18n=function(){return{init:function(a){i18n.init({resGetPath:"locales/__ns__?lng=__lng__",dynamicLoad:!1,load:"current",ns:{namespaces:["editor","node-red","jsonata","infotips"],defaultNs:"editor"},fallbackLng:["en-US"],fallbackNS:["node-red","editor"],useCookie:!1},function(){a()}),RED._=function(){return i18n.t.apply(null,arguments)}},loadCatalog:function(a,b){i18n.loadNamespace(a,b)},loadNodeCatalogs:function(a){var b=i18n.functions.toLanguages(i18n.detectLanguage()),c=b.length;b.forEach(function(b){$.ajax({headers:{Accept:"application/json"},cache:!1,url:"locales/nodes?lng="+b,success:function(d){var e=Object.keys(d);e.forEach(function(a){i18n.addResourceBundle(b,a,d[a])}),c--,0===c&&a()}})})}}}(),RED.settings=function(){function a(a,b){if(!RED.settings.editorTheme)return b;var c=a.split("."),d=RED.settings.editorTheme;try{for(var e=0;e<c.length;e++)d=d[c[e]];return void 0===d?b:d}catch(a){return b}}var b={},c=function(){try{return"localStorage"in window&&null!==window.localStorage}catch(a){return!1}},d=function(a,b){c()&&localStorage.setItem(a,JSON.stringify(b))},e=function(a){if(c())return JSON.parse(localStorage.getItem(a))},f=function(a){c()&&localStorage.removeItem(a)},g=function(a){for(var c in b)b.hasOwnProperty(c)&&RED.settings.hasOwnProperty(c)&&delete RED.settings[c];for(c in a)a.hasOwnProperty(c)&&(RED.settings[c]=a[c]);b=a},h=function(a){var b=/[?&]access_token=(.*?)(?:$|&)/.exec(window.location.search);if(b){var c=b[1];RED.settings.set("auth-tokens",{access_token:c}),window.location.search=""}$.ajaxSetup({beforeSend:function(a,b){if(!/^\s*(https?:|\/|\.)/.test(b.url)){var c=RED.settings.get("auth-tokens");c&&a.setRequestHeader("Authorization","Bearer "+c.access_token),a.setRequestHeader("Node-RED-API-Version","v2")}}}),i(a)},i=function(a){$.ajax({headers:{Accept:"application/json"},dataType:"json",cache:!1,url:"settings",success:function(b){g(b),RED.settings.user&&!RED.settings.user.anonymous||RED.settings.remove("auth-tokens"),console.log("Node-BLUE: "+b.version),a()},error:function(b,c,d){401===b.status?(/[?&]access_token=(.*?)(?:$|&)/.test(window.location.search)&&(window.location.search=""),RED.user.login(function(){i(a)})):console.log("Unexpected error:",b.status,c)}})};return{init:h,load:i,set:d,get:e,remove:f,theme:a}}(),RED.user=function(){function a(a,b){"function"==typeof a&&(b=a,a={});var d=$('<div id="node-dialog-login" class="hide"><div style="display: inline-block;width: 250px; vertical-align: top; margin-right: 10px; margin-bottom: 20px;"><img id="node-dialog-login-image" src=""/></div><div style="display: inline-block; width: 250px; vertical-align: bottom; margin-left: 10px; margin-bottom: 20px;"><form id="node-dialog-login-fields" class="form-horizontal" style="margin-bottom: 0px;"></form></div></div>');d.dialog({autoOpen:!1,dialogClass:"ui-dialog-no-close",modal:!0,closeOnEscape:!!a.cancelable,width:600,resizable:!1,draggable:!1}),$("#node-dialog-login-fields").empty(),$.ajax({dataType:"json",url:"auth/login",success:function(e){var f=0;if("credentials"==e.type){for(;f<e.prompts.length;f++){var g=e.prompts[f],h=$("<div/>",{class:"form-row"});$('<label for="node-dialog-login-'+g.id+'">'+g.label+":</label><br/>").appendTo(h);var i=$('<input style="width: 100%" id="node-dialog-login-'+g.id+'" type="'+g.type+'" tabIndex="'+(f+1)+'"/>').appendTo(h);f<e.prompts.length-1&&i.keypress(function(){var a=h;return function(b){13==b.keyCode&&(a.next("div").find("input").focus(),b.preventDefault())}}()),h.appendTo("#node-dialog-login-fields")}$('<div class="form-row" style="text-align: right; margin-top: 10px;"><span id="node-dialog-login-failed" style="line-height: 2em;float:left;" class="hide">'+RED._("user.loginFailed")+'</span><img src="red/images/spin.svg" style="height: 30px; margin-right: 10px; " class="login-spinner hide"/>'+(a.cancelable?'<a href="#" id="node-dialog-login-cancel" style="margin-right: 20px;" tabIndex="'+(f+1)+'">'+RED._("common.label.cancel")+"</a>":"")+'<input type="submit" id="node-dialog-login-submit" style="width: auto;" tabIndex="'+(f+2)+'" value="'+RED._("user.login")+'"></div>').appendTo("#node-dialog-login-fields"),$("#node-dialog-login-submit").button(),$("#node-dialog-login-fields").submit(function(d){$("#node-dialog-login-submit").button("option","disabled",!0),$("#node-dialog-login-failed").hide(),$(".login-spinner").show();for(var f={client_id:"node-red-editor",grant_type:"password",scope:""},g=0;g<e.prompts.length;g++){var h=e.prompts[g];f[h.id]=$("#node-dialog-login-"+h.id).val()}$.ajax({url:"auth/token",type:"POST",data:f}).done(function(d,e,f){RED.settings.set("auth-tokens",d),$("#node-dialog-login").dialog("destroy").remove(),a.updateMenu&&c(),b()}).fail(function(a,b,c){RED.settings.remove("auth-tokens"),$("#node-dialog-login-failed").show()}).always(function(){$("#node-dialog-login-submit").button("option","disabled",!1),$(".login-spinner").hide()}),d.preventDefault()})}else if("strategy"==e.type)for(f=0;f<e.prompts.length;f++){var g=e.prompts[f],h=$("<div/>",{class:"form-row",style:"text-align: center"}).appendTo("#node-dialog-login-fields"),j=$('<a href="#"></a>',{style:"padding: 10px"}).appendTo(h).click(function(){document.location=g.url});if(g.image)$("<img>",{src:g.image}).appendTo(j);else if(g.label){var k=$("<span></span>").text(g.label);g.icon&&($("<i></i>",{class:"fa fa-2x "+g.icon,style:"vertical-align: middle"}).appendTo(j),k.css({verticalAlign:"middle",marginLeft:"8px"})),k.appendTo(j)}j.button()}a.cancelable&&$("#node-dialog-login-cancel").button().click(function(a){$("#node-dialog-login").dialog("destroy").remove()});var l=e.image||"red/images/node-red-256.png";$("#node-dialog-login-image").load(function(){d.dialog("open")}).attr("src",l)}})}function b(){$.ajax({url:"auth/revoke",type:"POST",data:{token:RED.settings.get("auth-tokens").access_token},success:function(a){RED.settings.remove("auth-tokens"),a&&a.redirect?document.location.href=a.redirect:document.location.reload(!0)}})}function c(){$("#btn-usermenu-submenu li").remove(),RED.settings.user.anonymous?RED.menu.addItem("btn-usermenu",{id:"usermenu-item-login",label:RED._("menu.label.login"),onselect:function(){RED.user.login({cancelable:!0},function(){RED.settings.load(function(){RED.notify(RED._("user.loggedInAs",{name:RED.settings.user.username}),"success"),c()})})}}):(RED.menu.addItem("btn-usermenu",{id:"usermenu-item-username",label:"<b>"+RED.settings.user.username+"</b>"}),RED.menu.addItem("btn-usermenu",{id:"usermenu-item-logout",label:RED._("menu.label.logout"),onselect:function(){RED.user.logout()}}))}function d(){if(RED.settings.user&&(!RED.settings.editorTheme||!RED.settings.editorTheme.hasOwnProperty("userMenu"))){var a=$('<li><a id="btn-usermenu" class="button hide" data-toggle="dropdown" href="#"></a></li>').prependTo(".header-toolbar");RED.settings.user.image?$('<span class="user-profile"></span>').css({backgroundImage:"url("+RED.settings.user.image+")"}).appendTo(a.find("a")):$('<i class="fa fa-user"></i>').appendTo(a.find("a")),RED.menu.init({id:"btn-usermenu",options:[]}),c()}}return{init:d,login:a,logout:b}}(),RED.comms=function(){function a(){return h}function b(a){var b;return(b=new RegExp("(?:^|; )"+encodeURIComponent(a)+"=([^;]*)").exec(document.cookie))?b[1]:null}function c(a){if("nodeEvents"==a.method){for(var k=0;k<a.params[0].length;k++)c({method:"nodeEvent",params:a.params[0][k]});return}if("nodeEvent"==a.method){a.params[2].format&&!a.params[2].format.match(/string/g)&&(a.params[2].msg=JSON.stringify(a.params[2].msg));for(var b in j)if(j.hasOwnProperty(b)){var c=new RegExp("^"+b.replace(/([\[\]\?\(\)\\\\$\^\*\.|])/g,"\\$1").replace(/\+/g,"[^/]+").replace(/\/#$/,"(/.*)?")+"$");if(c.test(a.params[1])){var d=j[b];if(d)for(var e=0;e<d.length;e++)d[e](a.params[1],a.params[2])}}}}function d(){var a="https:"==window.location.protocol,d="",e=a?"443":"80",f=window.location.host.indexOf("]");if(f>-1)part2=window.location.host.substring(f),part2.length>2&&":"==part2.charAt(1)&&(e=part2.substring(2)),d=window.location.host.substring(0,f+1);else{var g=window.location.host.split(":");d=g[0],g.length>1&&(e=g[1])}var j=b("PHPSESSID");h=new HomegearWS(d,e,"hgflows",a,j),h.ready(function(){i&&(i.close(),i=null)}),h.error(function(a){i&&i.close(),i=RED.notify(RED._("notification.error",{message:RED._("notification.errors.lostConnection")}),"error",!0)}),h.event(c),h.connect()}function e(a,b){null==j[a]&&(j[a]=[]),j[a].push(b)}function f(a,b){if(j[a]){for(var c=0;c<j[a].length;c++)if(j[a][c]===b){j[a].splice(c,1);break}0===j[a].length&&delete j[a]}}function g(){h.invoke("getNodeEvents",function(a){for(var b in a.result)if(a.result.hasOwnProperty(b)){var c=a.result[b];for(var d in c)if(c.hasOwnProperty(d)){var e=c[d];e.format&&!e.format.match(/string/g)&&(e.msg=JSON.stringify(e.msg));for(var f in j)if(j.hasOwnProperty(f)){var g=new RegExp("^"+f.replace(/([\[\]\?\(\)\\\\$\^\*\.|])/g,"\\$1").replace(/\+/g,"[^/]+").replace(/\/#$/,"(/.*)?")+"$");if(g.test(d)){var h=j[f];if(h)for(var i=0;i<h.length;i++)h[i](d,e)}}}}})}var h=null,i=null,j={};return{homegear:a,connect:d,subscribe:e,unsubscribe:f,getEvents:g}}(),RED.text={},RED.text.bidi=function(){function a(a){for(var d=a.length,e=0;e<d;e++){if(b(a.charCodeAt(e)))return!0;if(c(a.charCodeAt(e)))return!1}return!1}function b(a){return a>=1488&&a<=1535||a>=1536&&a<=1631||a>=1642&&a<=1775||a>=1786&&a<=2047||a>=64285&&a<=65023||a>=65136&&a<=65276}function c(a){return a>64&&a<91||a>96&&a<123}function d(b){return"auto"==j?a(b)?"rtl":"ltr":j}function e(){$(this).attr("dir",d($(this).val()))}function f(a){a.on("keyup",e).on("paste",e).on("cut",e),e.call(a)}function g(a){if(a){var b=d(a);if("ltr"==b)return k+a+m;if("rtl"==b)return l+a+m}return a}function h(){$("#workspace").find("span.bidiAware").each(function(){$(this).attr("dir",d($(this).html()))}),$("#sidebar").find("span.bidiAware").each(function(){$(this).attr("dir",d($(this).text()))})}function i(a){j=a,RED.nodes.eachNode(function(a){a.dirty=!0}),RED.view.redraw(),RED.palette.refresh(),h()}var j="",k="‪",l="‫",m="‬";return{setTextDirection:i,enforceTextDirectionWithUCC:g,resolveBaseTextDir:d,prepareInput:f}}(),RED.text.format=function(){function a(a){switch(a){case"breadcrumb":return j;case"comma":return k;case"email":return l;case"filepath":return m;case"formula":return n;case"sql":return o;case"underscore":return p;case"url":return q;case"word":return r;case"xpath":return s;default:return t}}function b(a){var b=window.navigator.userAgent;if(b.indexOf("MSIE")>=0||b.indexOf("Trident")>=0||b.indexOf("Edge")>=0)return!1;var c=document.createElement(a.tagName);c.contentEditable=!0;var d="oninput"in c;return d||(c.setAttribute("oninput","return;"),d="function"==typeof c.oninput),c=null,d}function c(a,c,e,f,g){if(!a||1!=a.nodeType)return!1;u||(u=document.createEvent("Event"),u.initEvent("TF",!0,!0)),a.setAttribute("data-tf-type",c);var i="undefined"===e?"{}":JSON.stringify(Array.isArray(e)?e[0]:e);a.setAttribute("data-tf-args",i);var j="ltr";if("undefined"===f&&(a.dir?j=a.dir:a.style&&a.style.direction&&(j=a.style.direction),f="rtl"===j.toLowerCase()),a.setAttribute("data-tf-dir",f),a.setAttribute("data-tf-locale",h.getLocaleDetails(g).lang),b(a)){a.oninput;a.oninput=function(a){d(a.target)}}else a.onkeyup=function(b){d(b.target),a.dispatchEvent(u)},a.onmouseup=function(b){d(b.target),a.dispatchEvent(u)};return d(a),!0}function d(b){var c=b.textContent||"",d=document.getSelection();if(0===c.length||!d||d.rangeCount<=0)return void b.dispatchEvent(u);var e,f,g=d.getRangeAt(0),h=g.cloneRange();e=g.startContainer,f=g.startOffset;var i=0;3===e.nodeType&&(i+=f),h.setStart(b,0),h.setEndBefore(e);var j=document.createElement("div");j.appendChild(h.cloneContents()),i+=j.textContent.length,b.innerHTML=a(b.getAttribute("data-tf-type")).format(c,JSON.parse(b.getAttribute("data-tf-args")),"true"===b.getAttribute("data-tf-dir"),!0,b.getAttribute("data-tf-locale"));var k=b,l=b,m=0,n=!1;for(d.removeAllRanges(),g.setStart(b,0),g.setEnd(b,0);l;){if(3===l.nodeType){if(m+l.nodeValue.length>=i){g.setStart(l,i-m);break}m+=l.nodeValue.length,l=l.nextSibling}else{if(l.hasChildNodes()){k=l,l=k.firstChild;continue}l=l.nextSibling}for(;!l;){if(k===b){n=!0;break}l=k.nextSibling,k=k.parentNode}if(n)break}d.addRange(g),b.dispatchEvent(u)}var e=function(){var a=function(a){this.content="",this.actual="",this.textDirection="",this.localGui="",this.isVisible=!0,this.isSeparator=!1,this.isParsed=!1,this.keep=!1,this.inBounds=!1,this.inPoints=!1;var b="";for(b in a)a.hasOwnProperty(b)&&(this[b]=a[b])};return a}(),f=function(){function a(a){if(!a)return!1;"undefined"==typeof a.start&&(a.start=""),"undefined"==typeof a.end&&(a.end=""),"undefined"!=typeof a.startAfter?(a.start=a.startAfter,a.after=!0):a.after=!1,"undefined"!=typeof a.endBefore?(a.end=a.endBefore,a.before=!0):a.before=!1;var b=parseInt(a.startPos,10);isNaN(b)?a.usePos=!1:a.usePos=!0;var c=parseInt(a.length,10);return isNaN(c)?a.useLength=!1:a.useLength=!0,a.loops="undefined"==typeof a.loops||!!a.loops,!0}function b(a,b){var c={};for(var d in b)b.hasOwnProperty(d)&&(c[d]=b[d]);var e=a.content,f=c.usePos&&c.startPos<e.length;f&&(c.start="",c.loops=!1),c.bStart=f?c.startPos:c.start.length>0?e.indexOf(c.start):0;var g=c.useLength&&c.length>0&&c.bStart+c.length<e.length;return g&&(c.end=""),c.bEnd=g?c.bStart+c.length:c.end.length>0?e.indexOf(c.end,c.bStart+c.start.length)+1:e.length,c.after||(c.start=""),c.before||(c.end=""),c}return{handleSubcontents:function(a,b,c,d,f){if(!c.content||"string"!=typeof c.content||0===c.content.length)return a;var g=!0;"undefined"!=typeof c.loops&&(g=!!c.loops);for(var h=0;!0&&!(h>=a.length);h++)if(!(a[h].isParsed||a.keep||a[h].isSeparator)){var i=a[h].content,j=i.indexOf(c.content);if(!(j<0)){var k,l=0;if(c.continued){do l++,k=i.indexOf(c.content,j+l*c.content.length);while(0===k)}else l=1;if(k=j+l*c.content.length,a.splice(h,1),j>0&&(a.splice(h,0,new e({content:i.substring(0,j),localGui:b.dir,keep:!0})),h++),a.splice(h,0,new e({content:i.substring(j,k),textDirection:c.subDir,localGui:b.dir})),k<i.length&&a.splice(h+1,0,new e({content:i.substring(k,i.length),localGui:b.dir,keep:!0})),!g)break}}},handleBounds:function(c,d,f,g,h){for(var i=0;i<f.length;i++)if(a(f[i]))for(var j=0;!0&&!(j>=c.length);j++)if(!(c[j].isParsed||c[j].inBounds||c.keep||c[j].isSeparator)){var k=b(c[j],f[i]),l=k.bStart,m=k.bEnd;if(!(l<0||m<0)){var n=c[j].content;if(c.splice(j,1),l>0&&(c.splice(j,0,new e({content:n.substring(0,l),localGui:d.dir,keep:!0})),j++),k.start&&(c.splice(j,0,new e({content:k.start,localGui:d.dir,isSeparator:!0})),j++),c.splice(j,0,new e({content:n.substring(l+k.start.length,m-k.end.length),textDirection:k.subDir,localGui:d.dir,inBounds:!0})),k.end&&(j++,c.splice(j,0,new e({content:k.end,localGui:d.dir,isSeparator:!0}))),m+k.end.length<n.length&&c.splice(j+1,0,new e({content:n.substring(m+k.end.length,n.length),localGui:d.dir,keep:!0})),!k.loops)break}}for(i=0;i<c.length;i++)c[i].inBounds=!1;return c},handleCases:function(a,b,c,d,e){if(0===c.length)return a;var f={};for(var g in b)b.hasOwnProperty(g)&&(f[g]=b[g]);for(var h=0;h<c.length;h++)c[h].handler&&"function"==typeof c[h].handler.handle||(c[h].handler=b.commonHandler),c[h].args?(f.cases=c[h].args.cases,f.points=c[h].args.points,f.bounds=c[h].args.bounds,f.subs=c[h].args.subs):(f.cases=[],f.points=[],f.bounds=[],f.subs={}),c[h].handler.handle(d,a,f,e);return a},handlePoints:function(a,b,c,d,f){for(var g=0;g<c.length;g++)for(var h=0;!0&&!(h>=a.length);h++)if(!(a[h].isParsed||a[h].keep||a[h].isSeparator)){var i=a[h].content,j=i.indexOf(c[g]);j>=0&&(a.splice(h,1),j>0&&(a.splice(h,0,new e({content:i.substring(0,j),textDirection:b.subDir,localGui:b.dir,inPoints:!0})),h++),a.splice(h,0,new e({content:c[g],localGui:b.dir,isSeparator:!0})),j+c[g].length+1<=i.length&&a.splice(h+1,0,new e({content:i.substring(j+c[g].length),textDirection:b.subDir,localGui:b.dir,inPoints:!0})))}for(g=0;g<a.length;g++)a[g].keep?a[g].keep=!1:a[g].inPoints&&(a[g].isParsed=!0,a[g].inPoints=!1);return a}}}(),g=function(){return{handle:function(a,b,c,d){var e=[];Array.isArray(c.cases)&&(e=c.cases);var g=[];"undefined"!=typeof c.points&&(Array.isArray(c.points)?g=c.points:"string"==typeof c.points&&(g=c.points.split("")));var h={};"object"==typeof c.subs&&(h=c.subs);var i=[];return Array.isArray(c.bounds)&&(i=c.bounds),f.handleBounds(b,c,i,a,d),f.handleSubcontents(b,c,h,a,d),f.handleCases(b,c,e,a,d),f.handlePoints(b,c,g,a,d),b}}}(),h=function(){var a=function(a){var b=a?a.split("-")[0]:"";return!(!b||b.length<2)&&["iw","he","ar","fa","ur"].some(function(a){return a===b})},b="‪",c="‫",d="‬",e="‎",f="‏",g="‭",h="‮";return{LRE:b,RLE:c,PDF:d,LRM:e,RLM:f,LRO:g,RLO:h,getLocaleDetails:function(b){if(b||(b="undefined"==typeof navigator?"":navigator.language||navigator.userLanguage||""),b=b.toLowerCase(),a(b)){var c=b.split("-");return{lang:c[0],country:c[1]?c[1]:""}}return{lang:"not-bidi"}},removeUcc:function(a){return a?a.replace(/[\u200E\u200F\u202A-\u202E]/g,""):a},removeTags:function(a){return a?a.replace(/<[^<]*>/g,""):a},getDirection:function(a,b,c,d){if("auto"!==b&&/^(rtl|ltr)$/i.test(b))return b;c=/^(rtl|ltr)$/i.test(c)?c:"ltr";var e=d?a.split("").reverse().join(""):a,f=/[A-Za-z\u05d0-\u065f\u066a-\u06ef\u06fa-\u07ff\ufb1d-\ufdff\ufe70-\ufefc]/.exec(e);return f?f[0]<="z"?"ltr":"rtl":c},hasArabicChar:function(a){var b=/[\u0600-\u065f\u066a-\u06ef\u06fa-\u07ff\ufb1d-\ufdff\ufe70-\ufefc]/.exec(a);return!!b},showMarks:function(a,i){for(var j="",k=0;k<a.length;k++){var l=""+a.charAt(k);switch(l){case e:j+="<LRM>";break;case f:j+="<RLM>";break;case b:j+="<LRE>";break;case c:j+="<RLE>";break;case g:j+="<LRO>";break;case h:j+="<RLO>";break;case d:j+="<PDF>";break;default:j+=l}}var m="undefined"!=typeof i&&/^(rtl|ltr)$/i.test(i)?"rtl"===i?h:g:"";return m+j+(""===m?"":d)},hideMarks:function(a){var b=a.replace(/<LRM>/g,this.LRM).replace(/<RLM>/g,this.RLM).replace(/<LRE>/g,this.LRE);return b.replace(/<RLE>/g,this.RLE).replace(/<LRO>/g,this.LRO).replace(/<RLO>/g,this.RLO).replace(/<PDF>/g,this.PDF)},showTags:function(a){return"<xmp>"+a+"</xmp>"},hideTags:function(a){return a.replace(/<xmp>/g,"").replace(/<\/xmp>/g,"")}}}(),i=function(){function a(a,b,e,f){return a&&b?d(c(a,b,f),b,e):a}function b(a,b){var c=Array.isArray(a)?a[0]:a;return c.guiDir||(c.guiDir="ltr"),c.dir||(c.dir=c.guiDir),b?("undefined"==typeof c.points&&(c.points=[]),c.cases||(c.cases=[]),c.bounds||(c.bounds=[]),c.commonHandler=g,c):c}function c(a,c,d){if(!a||!c)return new e({content:""});var f=b(c,!0),h=[new e({content:a,actual:a,localGui:f.dir})],i=g.handle;return f.handler&&"function"==typeof f.handler&&(i=f.handler.handle),i(a,h,f,d),h}function d(a,c,d){var e=b(c,!1);return d?i(a,e):f(a,e)}function f(a,b,c){for(var d="",e="",f="",g=!1,i=0;i<a.length;i++)if(a[i].isVisible){var j=a[i].textDirection,k=a[i].localGui;if(""!==k&&""===f?d+="rtl"===k?h.RLE:h.LRE:""===f||""!==k&&k===f&&!g||(d+=h.PDF+(i==a.length-1&&""!==k?"":"rtl"===b.dir?h.RLM:h.LRM),""!==k&&(d+="rtl"===k?h.RLE:h.LRE)),"auto"===j&&(j=h.getDirection(a[i].content,j,b.guiDir)),/^(rtl|ltr)$/i.test(j)?(d+=("rtl"===j?h.RLE:h.LRE)+a[i].content+h.PDF,e=j):(d+=a[i].content,e=h.getDirection(a[i].content,j,b.guiDir,!0)),i<a.length-1){var l=k&&a[i+1].localGui?k:b.dir;d+="rtl"===l?h.RLM:h.LRM}else""!==f&&(d+=h.PDF);f=k,g=!1}else g=!0;var m="auto"===b.dir?h.getDirection(a[0].actual,b.dir,b.guiDir):b.dir;return m!==b.guiDir&&(d=("rtl"===m?h.RLE:h.LRE)+d+h.PDF),d}function i(a,b,c){for(var d="",e="",f="",g=0;g<a.length;g++)if(a[g].isVisible){var i=a[g].textDirection,j=a[g].localGui;if(""!==j&&""===f?d+="<bdi dir='"+("rtl"===j?"rtl":"ltr")+"'>":""===f||""!==j&&j===f&&!stop||(d+="</bdi>"+(g==a.length-1&&""!==j?"":"<span style='unicode-bidi: embed; direction: "+("rtl"===b.dir?"rtl":"ltr")+";'></span>"),""!==j&&(d+="<bdi dir='"+("rtl"===j?"rtl":"ltr")+"'>")),"auto"===i&&(i=h.getDirection(a[g].content,i,b.guiDir)),/^(rtl|ltr)$/i.test(i)?(d+="<bdi dir='"+("rtl"===i?"rtl":"ltr")+"'>"+a[g].content+"</bdi>",e=i):(d+=a[g].content,e=h.getDirection(a[g].content,i,b.guiDir,!0)),g<a.length-1){var k=j&&a[g+1].localGui?j:b.dir;d+="<span style='unicode-bidi: embed; direction: "+("rtl"===k?"rtl":"ltr")+";'></span>"}else""!==f&&(d+="</bdi>");f=j,stop=!1}else stop=!0;var l="auto"===b.dir?h.getDirection(a[0].actual,b.dir,b.guiDir):b.dir;return l!==b.guiDir&&(d="<bdi dir='"+("rtl"===l?"rtl":"ltr")+"'>"+d+"</bdi>"),d}function j(a,b){return a}var k={};return k.parseAndDisplayStructure=a,k.parseStructure=c,k.displayStructure=d,k.restore=j,k}(),j=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:b.dir?b.dir:c?"rtl":"ltr",subs:{content:">",continued:!0,subDir:c?"rtl":"ltr"},cases:[{args:{subs:{content:"<",continued:!0,subDir:c?"ltr":"rtl"}}}]};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),k=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:","};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),l=function(){function a(a,b){if("ar"!==h.getLocaleDetails(b).lang)return"ltr";var c=a.indexOf("@");return c>0&&c<a.length-1&&h.hasArabicChar(a.substring(c+1))?"rtl":"ltr"}return{format:function(b,c,d,e,f,h){var j={guiDir:d?"rtl":"ltr",dir:a(b,f),points:"<>.:,;@",cases:[{handler:g,args:{bounds:[{startAfter:'"',endBefore:'"'},{startAfter:"(",endBefore:")"}],points:""}}]};return h?i.parseStructure(b,j,!!e,f):i.parseAndDisplayStructure(b,j,!!e,f)}}}(),m=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:"/\\:."};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),n=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:" /%^&[]<>=!?~:.,|()+-*{}"};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),o=function(){return{format:function(a,b,c,d,e,f){var h={guiDir:c?"rtl":"ltr",dir:"ltr",points:"\t!#%&()*+,-./:;<=>?|[]{}",cases:[{handler:g,args:{bounds:[{startAfter:"/*",endBefore:"*/"},{startAfter:"--",end:"\n"},{startAfter:"--"}]}},{handler:g,args:{subs:{content:" ",continued:!0}}},{handler:g,args:{bounds:[{startAfter:"'",endBefore:"'"},{startAfter:'"',endBefore:'"'}]}}]};return f?i.parseStructure(a,h,!!d,e):i.parseAndDisplayStructure(a,h,!!d,e)}}}(),p=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:"_"};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),q=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:"ltr",points:":?#/@.[]="};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),r=function(){return{format:function(a,b,c,d,e,f){var g={guiDir:c?"rtl":"ltr",dir:b.dir?b.dir:c?"rtl":"ltr",points:" ,.!?;:"};return f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),s=function(){return{format:function(a,b,c,d,e,f){var h={guiDir:c?"rtl":"ltr",dir:"ltr",points:" /[]<>=!:@.|()+-*",cases:[{handler:g,args:{bounds:[{startAfter:'"',endBefore:'"'},{startAfter:"'",endBefore:"'"}],points:""}}]};return f?i.parseStructure(a,h,!!d,e):i.parseAndDisplayStructure(a,h,!!d,e)}}}(),t=function(){return{format:function(a,b,c,d,e,f){var g={},h="",j=Array.isArray(b)?b[0]:b;for(h in j)j.hasOwnProperty(h)&&(g[h]=j[h]);return g.guiDir=c?"rtl":"ltr",g.dir=g.dir?g.dir:g.guiDir,f?i.parseStructure(a,g,!!d,e):i.parseAndDisplayStructure(a,g,!!d,e)}}}(),u=(function(){function b(a){return"he"===a||"iw"===a||"ar"===a?"rtl":"ltr"}function c(a){0===a.msgDir.length&&(a.msgDir=b(a.msgLang)),a.msgDir="ltr"!==a.msgDir&&"rtl"!==a.msgDir&&"auto"!=a.msgDir?"ltr":a.msgDir,0===a.guiDir.length&&(a.guiDir=a.msgDir),a.guiDir="rtl"!==a.guiDir?"ltr":"rtl",0===a.phDir.length&&(a.phDir=0===a.phLang.length?a.msgDir:b(a.phLang)),a.phDir="ltr"!==a.phDir&&"rtl"!==a.phDir&&"auto"!=a.phDir?"ltr":a.phDir,"string"==typeof a.phPacking&&(a.phPacking=a.phPacking.split("")),a.phPacking.length<2&&(a.phPacking=["{","}"])}var d={msgLang:"en",msgDir:"",phLang:"",phDir:"",phPacking:["{","}"],phStt:{type:"none",args:{}},guiDir:""},f=!1;return{setDefaults:function(a){for(var b in a)d.hasOwnProperty(b)&&(d[b]=a[b]);c(d),f=!0},format:function(b){f||(c(d),f=!0);var g=!1,h=!1,j=d.phPacking[0].length,k=d.phPacking[1].length;if(arguments.length>0){var l=arguments[arguments.length-1];"boolean"==typeof l&&(g=l,h=!0)}for(var m,n=new RegExp(d.phPacking[0]+"\\d+"+d.phPacking[1]),o=[],p=0,q=b;null!=(m=n.exec(q));){var r=q.indexOf(m[0])+m[0].length;r>m[0].length&&o.push({text:q.substring(0,r-m[0].length),ph:!1}),o.push({text:m[0],ph:!0}),p+=r,q=q.substring(r,q.length)}p<b.length&&o.push({text:b.substring(p,b.length),ph:!1});for(var s=[],t=1;t<arguments.length-(h?1:0);t++){var u=arguments[t],v=u,w=!1,x=0;if(Array.isArray(v)){if(u=v[0],"undefined"==typeof u)continue;w=!0}do"string"==typeof u?s.push({text:u,dir:d.phDir,stt:d.stt}):"boolean"==typeof u?g=u:"object"==typeof u?(s.push(u),u.hasOwnProperty("text")||(s[s.length-1].text="{???}"),u.hasOwnProperty("dir")&&0!==u.dir.length||(s[s.length-1].dir=d.phDir),(!u.hasOwnProperty("stt")||"string"==typeof u.stt&&0===u.stt.length||"object"==typeof u.stt&&0===Object.keys(u.stt).length)&&(s[s.length-1].stt=d.phStt)):s.push({text:""+u,dir:d.phDir,stt:d.phStt}),w&&(x++,x==v.length?w=!1:u=v[x]);while(w)}var y=[];for(t=0;t<o.length;t++){var z=o[t];if(z.ph){var A=parseInt(z.text.substring(j,z.text.length-k));if(isNaN(A)||A>=s.length){y.push(new e({content:z.text,textDirection:d.msgDir}));continue}var B="none";if(s[A].stt||(s[A].stt=d.phStt),s[A].stt&&("string"==typeof s[A].stt?B=s[A].stt:s[A].stt.hasOwnProperty("type")&&(B=s[A].stt.type)),"none"!==B.toLowerCase()){for(var C=a(B).format(s[A].text,s[A].stt.args||{},"rtl"===d.msgDir,!1,d.msgLang,!0),D=0;D<C.length;D++)y.push(C[D]);y.push(new e({isVisible:!1}))}else y.push(new e({content:s[A].text,textDirection:s[A].dir?s[A].dir:d.phDir}))}else y.push(new e({content:z.text,textDirection:d.msgDir}))}var E=i.displayStructure(y,{guiDir:d.guiDir,dir:d.msgDir},g);return E}}}(),null);return{getHtml:function(b,c,d,e,f){return a(c).format(b,d,e,!0,f)},attach:function(a,b,d,e,f){return c(a,b,d,e,f)}}}(),RED.state={DEFAULT:0,MOVING:1,JOINING:2,MOVING_ACTIVE:3,ADDING:4,EDITING:5,EXPORT:6,IMPORT:7,IMPORT_DRAGGING:8,QUICK_JOINING:9},RED.nodes=function(){function a(a){N=a,RED.events.emit("nodes:change",{dirty:N})}function b(){return(1+4294967295*Math.random()).toString(16)}function c(a){if(0!==a.type.indexOf("subflow")?a._=a._def._:a._=RED._,"config"==a._def.category)H[a.id]=a;else{if(a.inputPorts=[],a.inputs)for(var b=0;b<a.inputs;b++)a.inputPorts.push(b);if(a.outputPorts=[],a.wires&&a.wires.length>a.outputs&&(a.outputs=a.wires.length),a.outputs)for(var b=0;b<a.outputs;b++)a.outputPorts.push(b);if(a.dirty=!0,B(a),"subflows"==a._def.category&&"undefined"==typeof a.i){var c=0;RED.nodes.eachNode(function(a){c=Math.max(c,a.i||0)}),a.i=c+1}G.push(a)}RED.events.emit("nodes:add",a)}function d(a){I.push(a)}function e(a){if(a in H)return H[a];for(var b in G)if(G[b].id==a)return G[b];return null}function f(a){var b,c=[],d=[];if(a in H)b=H[a],delete H[a],RED.events.emit("nodes:remove",b),RED.workspaces.refresh();else if(b=e(a)){G.splice(G.indexOf(b),1),c=I.filter(function(a){return a.source===b||a.target===b}),c.forEach(function(a){I.splice(I.indexOf(a),1)});var g=!1;for(var h in b._def.defaults)if(b._def.defaults.hasOwnProperty(h)){var i=b._def.defaults[h];if(i.type){var j=O.getNodeType(i.type);if(j&&"config"==j.category){var k=H[b[h]];if(k)if(g=!0,k._def.exclusive)f(b[h]),d.push(k);else{var l=k.users;l.splice(l.indexOf(b),1)}}}}g&&RED.workspaces.refresh(),RED.events.emit("nodes:remove",b)}return b&&b._def.onremove&&b._def.onremove.call(n),{links:c,nodes:d}}function g(a){var b=I.indexOf(a);b!=-1&&I.splice(b,1)}function h(a){J[a.id]=a,a._def={defaults:{label:{value:""},disabled:{value:!1},info:{value:""}}},K.push(a.id)}function j(a){return J[a]}function k(a){delete J[a],K.splice(K.indexOf(a),1);var b,c,d=[],e=[];for(b=0;b<G.length;b++)c=G[b],c.z==a&&d.push(c);for(b in H)H.hasOwnProperty(b)&&(c=H[b],c.z==a&&d.push(c));for(b=0;b<d.length;b++){var g=f(d[b].id);e=e.concat(g.links)}return{nodes:d,links:e}}function l(a,b){if(b){var c=Object.keys(L).map(function(a){return L[a].name});c.sort();var d=1,e=a.name;c.forEach(function(b){e==b&&(d++,e=a.name+" ("+d+")")}),a.name=e}L[a.id]=a,RED.nodes.registerType("subflow:"+a.id,{defaults:{name:{value:""}},info:a.info,icon:"subflow.png",category:"subflows",inputs:a.in.length,outputs:a.out.length,color:"#da9",label:function(){return this.name||RED.nodes.subflow(a.id).name},labelStyle:function(){return this.name?"node_label_italic":""},paletteLabel:function(){return RED.nodes.subflow(a.id).name},inputLabels:function(b){return a.inputLabels?a.inputLabels[b]:null},outputLabels:function(b){return a.outputLabels?a.outputLabels[b]:null},set:{module:"node-red"}}),a._def=RED.nodes.getType("subflow:"+a.id)}function m(a){return L[a]}function o(a){delete L[a.id],O.removeNodeType("subflow:"+a.id)}function p(a,b){for(var c=0;c<G.length;c++){var d=G[c];if(d.z===a){var e=/^subflow:(.+)$/.exec(d.type);if(e){if(e[1]===b)return!0;var f=p(e[1],b);if(f)return!0}}}return!1}function q(a){var b={};b[a.id]=!0;for(var c=[a],d=[a];0!==d.length;)for(var e=d.shift(),f=I.filter(function(a){return a.source===e||a.target===e}),g=0;g<f.length;g++){var h=f[g].source===e?f[g].target:f[g].source,i=h.id;i||(i=h.direction+":"+h.i),b[i]||(b[i]=!0,c.push(h),d.push(h))}return c}function r(a){var b={};b.id=a.id,b.type=a.type,b.namespace=a.namespace?a.namespace:a.type;for(var c in a._def.defaults)a._def.defaults.hasOwnProperty(c)&&(b[c]=a[c]);return b}function s(a,b){if("tab"===a.type)return r(a);b=b||!1;var c={};if(c.id=a.id,c.type=a.type,c.namespace=a._def.namespace?a._def.namespace:a.type,c.z=a.z,"unknown"==c.type)for(var d in a._orig)a._orig.hasOwnProperty(d)&&(c[d]=a._orig[d]);else{for(var e in a._def.defaults)a._def.defaults.hasOwnProperty(e)&&(c[e]=a[e]);if(b&&a.credentials){var f={};c.credentials={};for(var g in a._def.credentials)a._def.credentials.hasOwnProperty(g)&&("password"==a._def.credentials[g].type?(!a.credentials._||a.credentials["has_"+g]!=a.credentials._["has_"+g]||a.credentials["has_"+g]&&a.credentials[g])&&(f[g]=a.credentials[g]):null==a.credentials[g]||a.credentials._&&a.credentials[g]==a.credentials._[g]||(f[g]=a.credentials[g]));Object.keys(f).length>0&&(c.credentials=f)}}if("config"!=a._def.category){c.x=a.x,c.y=a.y,c.wires=[];for(var h=0;h<a.outputs;h++)c.wires.push([]);for(var i=I.filter(function(b){return b.source===a}),j=0;j<i.length;j++){var k=i[j];"subflow"!=k.target.type&&c.wires[k.sourcePort].push({id:k.target.id,port:k.targetPort})}a.inputs>0&&a.inputLabels&&!/^\s*$/.test(a.inputLabels.join(""))&&(c.inputLabels=a.inputLabels.slice()),a.outputs>0&&a.outputLabels&&!/^\s*$/.test(a.outputLabels.join(""))&&(c.outputLabels=a.outputLabels.slice())}return c}function t(a){var b={};return b.id=a.id,b.type=a.type,b.namespace=a.namespace?a.namespace:a.type,b.name=a.name,b.info=a.info,b.in=[],b.out=[],a.in.forEach(function(a){for(var c={x:a.x,y:a.y,wires:[]},d=I.filter(function(b){return b.source===a}),e=0;e<d.length;e++){var f=d[e];"subflow"!=f.target.type&&c.wires.push({id:f.target.id,port:d[e].targetPort})}b.in.push(c)}),a.out.forEach(function(c,d){var e={x:c.x,y:c.y,wires:[]},f=I.filter(function(a){return a.target===c});for(i=0;i<f.length;i++)"subflow"!=f[i].source.type?e.wires.push({id:f[i].source.id,port:f[i].sourcePort}):e.wires.push({id:a.id,port:f[i].sourcePort});b.out.push(e)}),b.in.length>0&&a.inputLabels&&!/^\s*$/.test(a.inputLabels.join(""))&&(b.inputLabels=a.inputLabels.slice()),b.out.length>0&&a.outputLabels&&!/^\s*$/.test(a.outputLabels.join(""))&&(b.outputLabels=a.outputLabels.slice()),
 b}function u(a){for(var b=[],c={},d={},e=0;e<a.length;e++){var f=a[e];if("subflow:"==f.type.substring(0,8)){var g=f.type.substring(8);if(!d[g]){d[g]=!0;var h=m(g),i=[h];RED.nodes.eachNode(function(a){a.z==g&&i.push(a)});var j=u(i);b=j.concat(b)}}if("subflow"!=f.type){var k=RED.nodes.convertNode(f);for(var l in f._def.defaults)if(f._def.defaults[l].type&&f[l]in H){var n=H[f[l]],o=O.getNodeType(f._def.defaults[l].type).exportable;null==o||o?f[l]in c||(c[f[l]]=!0,a.push(n)):k[l]=""}b.push(k)}else{var p=t(f);b.push(p)}}return b}function v(a){void 0===a&&(a=!0);var b,c=[];for(b=0;b<K.length;b++)"tab"==J[K[b]].type&&c.push(r(J[K[b]]));for(b in L)L.hasOwnProperty(b)&&c.push(t(L[b]));for(b in H)H.hasOwnProperty(b)&&c.push(s(H[b],a));for(b=0;b<G.length;b++){var d=G[b];c.push(s(d,a))}return c}function w(a,b){var c,d=null;try{RED.nodes.eachSubflow(function(e){if(e.name==a.name&&e.info==a.info&&e.in.length==a.in.length&&e.out.length==a.out.length){var f=RED.nodes.filterNodes({z:e.id});if(f.length==b.length){var g=[a].concat(b),h=[e].concat(f),i=JSON.stringify(g),j=JSON.stringify(u(h));for(c=0;c<f.length;c++)i=i.replace(new RegExp('"'+b[c].id+'"',"g"),'"'+f[c].id+'"');if(i=i.replace(new RegExp('"'+a.id+'"',"g"),'"'+e.id+'"'),i===j)throw d=e,new Error}}})}catch(a){console.log(a.stack)}return d}function x(a,b,c){if(c&&a.id!=b.id)return!1;if(a.type!=b.type)return!1;var d=a._def;for(var e in d.defaults)if(d.defaults.hasOwnProperty(e)){var f=a[e],g=b[e];if(typeof f!=typeof g)return!1;if(null===f||"string"==typeof f||"number"==typeof f){if(f!==g)return!1}else if(JSON.stringify(f)!==JSON.stringify(g))return!1}return!0}function y(a,e,f){var g,i,j,k={};if("string"==typeof a){if(""===a)return;try{j=JSON.parse(a)}catch(a){var n=new Error(RED._("clipboard.invalidFlow",{message:a.message}));throw n.code="NODE_RED",n}}else j=a;$.isArray(j)||(j=[j]),F||(F=JSON.parse(JSON.stringify(j)));var o=[];for(g=0;g<j.length;g++)i=j[g],"workspace"==i.type||"tab"==i.type||"subflow"==i.type||O.getNodeType(i.type)||"subflow:"==i.type.substring(0,8)||o.indexOf(i.type)!=-1||o.push(i.type),i.z&&(k[i.z]=k[i.z]||[],k[i.z].push(i));if(o.length>0){var q="<ul><li>"+o.join("</li><li>")+"</li></ul>";"type"+(o.length>1?"s":"");RED.notify("<strong>"+RED._("clipboard.importUnrecognised",{count:o.length})+"</strong>"+q,"error",!1,1e4)}var r=RED.workspaces.active(),s=m(r);for(g=0;g<j.length;g++){var t=/^subflow:(.+)$/.exec(j[g].type);if(t){var u=t[1],v=m(j[g].z||r);if(v){var y;if(u===v.id&&(y=new Error(RED._("notification.errors.cannotAddSubflowToItself"))),p(u,v.id)&&(y=new Error(RED._("notification.errors.cannotAddCircularReference"))),y)throw y.code="NODE_RED",y}}}var z,A,B,C,D=[],G={},I=[],K={},L={},M={},N=[],P=[],Q=null;for(g=0;g<j.length;g++)if(i=j[g],"workspace"===i.type||"tab"===i.type)"workspace"===i.type&&(i.type="tab"),null==E&&(E=i),e&&(z=b(),G[i.id]=z,i.id=z),h(i),RED.workspaces.add(i),D.push(i);else if("subflow"===i.type){var R=w(i,k[i.id]);R?L[i.id]=R:(K[i.id]=i,e&&(z=b(),i.id=z),i.in.forEach(function(a,c){a.type="subflow",a.direction="in",a.z=i.id,a.i=c,a.id=b()}),i.out.forEach(function(a,c){a.type="subflow",a.direction="out",a.z=i.id,a.i=c,a.id=b()}),I.push(i),l(i,e))}for(null==E&&(E={type:"tab",id:b(),label:RED._("workspace.defaultName",{number:1})},h(E),RED.workspaces.add(E),D.push(E),r=RED.workspaces.active()),g=0;g<j.length;g++)if(i=j[g],A=O.getNodeType(i.type),A&&"config"==A.category){var S=null;if(e){if(i.z){if(L[i.z])continue;K[i.z]?i.z=K[i.z].id:(i.z=G[i.z],J[i.z]||(f?(null===Q&&(Q=RED.workspaces.add(null,!0),D.push(Q)),i.z=Q.id):i.z=r))}if(S=RED.nodes.node(i.id),S&&i.z&&S.z!==i.z){S=null;for(var T in H)if(H.hasOwnProperty(T)&&H[T].z===i.z&&x(H[T],i,!1)){S=H[T],M[i.id]=H[T];break}}}if(!S){B={id:i.id,z:i.z,type:i.type,namespace:i.namespace,users:[],_config:{}};for(C in A.defaults)A.defaults.hasOwnProperty(C)&&(B[C]=i[C],B._config[C]=JSON.stringify(i[C]));if(A.hasOwnProperty("credentials")&&i.hasOwnProperty("credentials")){B.credentials={};for(C in A.credentials)A.credentials.hasOwnProperty(C)&&i.credentials.hasOwnProperty(C)&&(B.credentials[C]=i.credentials[C])}B.label=A.label,B._def=A,e&&(B.id=b()),M[i.id]=B,N.push(B),RED.nodes.add(B)}}for(g=0;g<j.length;g++)if(i=j[g],"workspace"!==i.type&&"tab"!==i.type&&"subflow"!==i.type&&(A=O.getNodeType(i.type),!A||"config"!=A.category)){var U={x:i.x,y:i.y,z:i.z,type:0,wires:i.wires,inputLabels:i.inputLabels,outputLabels:i.outputLabels,changed:!1,_config:{}};if(e){if(L[i.z])continue;K[U.z]?U.z=K[U.z].id:(U.z=G[U.z],J[U.z]||(f?(null===Q&&(Q=RED.workspaces.add(null,!0),D.push(Q)),U.z=Q.id):U.z=r)),U.id=b()}else U.id=i.id,null!=U.z&&(J[U.z]||K[U.z])||(f?(null===Q&&(Q=RED.workspaces.add(null,!0),D.push(Q)),U.z=Q.id):U.z=r);if(U.type=i.type,U.namespace=i.namespace?i.namespace:A.namespace?A.namespace:i.type,U._def=A,"subflow"===i.type.substring(0,7)){var V=i.type.split(":")[1],W=L[V]||K[V]||m(V);e&&(V=W.id,U.type="subflow:"+V,U.namespace=U.type,U._def=O.getNodeType(U.type),delete U.i),U.name=i.name,U.outputs=W.out.length,U.inputs=W.in.length}else{if(!U._def){U.x&&U.y?U._def={color:"#fee",defaults:{},label:"unknown: "+i.type,labelStyle:"node_label_italic",outputs:i.outputs||i.wires.length,set:O.getNodeSet("node-red/unknown")}:(U._def={category:"config",set:O.getNodeSet("node-red/unknown")},U.users=[]);var X={};for(var Y in i)i.hasOwnProperty(Y)&&"x"!=Y&&"y"!=Y&&"z"!=Y&&"id"!=Y&&"wires"!=Y&&(X[Y]=i[Y]);U._orig=X,U.name=i.type,U.type="unknown",U.namespace="unknown"}if("config"!=U._def.category){U.inputs=i.inputs||U._def.inputs,U.outputs=i.outputs||U._def.outputs;for(C in U._def.defaults)U._def.defaults.hasOwnProperty(C)&&(U[C]=i[C],U._config[C]=JSON.stringify(i[C]));if(U._config.x=U.x,U._config.y=U.y,U._def.hasOwnProperty("credentials")&&i.hasOwnProperty("credentials")){U.credentials={};for(C in U._def.credentials)U._def.credentials.hasOwnProperty(C)&&i.credentials.hasOwnProperty(C)&&(U.credentials[C]=i.credentials[C])}}}c(U),RED.editor.validateNode(U),M[i.id]=U,"config"!=U._def.category&&N.push(U)}var Z={catch:"scope",status:"scope","link-in":"links","link-out":"links"};for(g=0;g<N.length;g++){if(i=N[g],i.wires){for(var _=0;_<i.wires.length;_++)for(var aa=i.wires[_]instanceof Array?i.wires[_]:[i.wires[_]],ba=0;ba<aa.length;ba++)if(M.hasOwnProperty(aa[ba].id)&&aa[ba].port<M[aa[ba].id].inputs)if(i.z===M[aa[ba].id].z){var ca={source:i,sourcePort:_,target:M[aa[ba].id],targetPort:aa[ba].port};d(ca),P.push(ca)}else console.log("Warning: dropping link that crosses tabs:",i.id,"->",M[aa[ba]].id);delete i.wires}for(var da in i._def.defaults)if(i._def.defaults.hasOwnProperty(da))if(i._def.defaults[da].type&&M[i[da]])i[da]=M[i[da]].id,B=RED.nodes.node(i[da]),B&&B.users.indexOf(i)===-1&&B.users.push(i);else if(Z.hasOwnProperty(i.type)&&Z[i.type]===da&&void 0!==i[da]&&null!==i[da])for(var ea=0;ea<i[da].length;ea++)M[i[da][ea]]&&(i[da][ea]=M[i[da][ea]].id);s&&/^link /.test(i.type)&&i.links&&(i.links=i.links.filter(function(a){var b=RED.nodes.node(a);return b&&b.z===r})),RED.editor.validateNode(i)}for(g=0;g<I.length;g++)i=I[g],i.in.forEach(function(a){a.wires.forEach(function(b,c){var e={source:a,sourcePort:c,target:M[b.id],targetPort:b.port};d(e),P.push(e)}),delete a.wires}),i.out.forEach(function(a){a.wires.forEach(function(b){var c;c=K[b.id]&&K[b.id].id==i.id?{source:i.in[b.port],sourcePort:b.port,target:a}:{source:M[b.id]||K[b.id],sourcePort:b.port,target:a},d(c),P.push(c)}),delete a.wires});return RED.workspaces.refresh(),[N,P,D,I,Q]}function z(a){for(var b=[],c=0;c<G.length;c++){var d=G[c];a.hasOwnProperty("z")&&d.z!==a.z||a.hasOwnProperty("type")&&d.type!==a.type||b.push(d)}return b}function A(a){for(var b=[],c=0;c<I.length;c++){var d=I[c];if(a.source){if(a.source.hasOwnProperty("id")&&d.source.id!==a.source.id)continue;if(a.source.hasOwnProperty("z")&&d.source.z!==a.source.z)continue}if(a.target){if(a.target.hasOwnProperty("id")&&d.target.id!==a.target.id)continue;if(a.target.hasOwnProperty("z")&&d.target.z!==a.target.z)continue}a.hasOwnProperty("sourcePort")&&d.sourcePort!==a.sourcePort||a.hasOwnProperty("targetPort")&&d.targetPort!==a.targetPort||b.push(d)}return b}function B(a){for(var b in a._def.defaults)if(a._def.defaults.hasOwnProperty(b)){var c=a._def.defaults[b];if(c.type){var d=O.getNodeType(c.type);if(d&&"config"==d.category){var e=H[a[b]];e&&e.users.indexOf(a)===-1&&e.users.push(a)}}}}function C(a){return void 0===a?M:void(M=a)}function D(){G=[],I=[],H={},K=[];var a=Object.keys(L);a.forEach(function(a){RED.subflow.removeSubflow(a)});var b=Object.keys(J);b.forEach(function(a){RED.workspaces.remove(J[a])}),E=null,RED.nodes.dirty(!0),RED.view.redraw(!0),RED.palette.refresh(),RED.workspaces.refresh(),RED.sidebar.config.refresh()}var E,F,G=[],H={},I=[],J={},K=[],L={},M=null,N=!1,O=function(){var a={},b=[],c={},d={},e={},f={setModulePendingUpdated:function(b,c){a[b].pending_version=c,RED.events.emit("registry:module-updated",{module:b,version:c})},getModule:function(b){return a[b]},getNodeSetForType:function(a){return f.getNodeSet(d[a])},getModuleList:function(){return a},getNodeList:function(){return b},getNodeTypes:function(){return Object.keys(e)},setNodeList:function(a){b=[];for(var c=0;c<a.length;c++){var d=a[c];f.addNodeSet(d)}},addNodeSet:function(e){e.added=!1,c[e.id]=e;for(var f=0;f<e.types.length;f++)d[e.types[f]]=e.id;b.push(e),a[e.module]=a[e.module]||{name:e.module,version:e.version,local:e.local,sets:{}},e.pending_version&&(a[e.module].pending_version=e.pending_version),a[e.module].sets[e.name]=e,RED.events.emit("registry:node-set-added",e)},removeNodeSet:function(e){for(var f=c[e],g=0;g<f.types.length;g++)delete d[f.types[g]];delete c[e];for(var h=0;h<b.length;h++)if(b[h].id===e){b.splice(h,1);break}return delete a[f.module].sets[f.name],0===Object.keys(a[f.module].sets).length&&delete a[f.module],RED.events.emit("registry:node-set-removed",f),f},getNodeSet:function(a){return c[a]},enableNodeSet:function(a){var b=c[a];b.enabled=!0,RED.events.emit("registry:node-set-enabled",b)},disableNodeSet:function(a){var b=c[a];b.enabled=!1,RED.events.emit("registry:node-set-disabled",b)},registerNodeType:function(a,b){if(e[a]=b,b.type=a,"subflows"!=b.category){b.set=c[d[a]],c[d[a]].added=!0,c[d[a]].enabled=!0;var f;f="node-red"===b.set.module?"node-red":b.set.id,b._=function(){var a=Array.prototype.slice.call(arguments,0),b=a[0];a[0].indexOf(":")===-1&&(a[0]=f+":"+a[0]);var c=RED._.apply(null,a);return c===a[0]&&(c=b),c}}RED.events.emit("registry:node-type-added",a)},removeNodeType:function(a){if("subflow:"!=a.substring(0,8))throw new Error("this api is subflow only. called with:",a);delete e[a],RED.events.emit("registry:node-type-removed",a)},getNodeType:function(a){return e[a]}};return f}();return{registry:O,setNodeList:O.setNodeList,getNodeSet:O.getNodeSet,addNodeSet:O.addNodeSet,removeNodeSet:O.removeNodeSet,enableNodeSet:O.enableNodeSet,disableNodeSet:O.disableNodeSet,registerType:O.registerNodeType,getType:O.getNodeType,convertNode:s,add:c,remove:f,clear:D,addLink:d,removeLink:g,addWorkspace:h,removeWorkspace:k,getWorkspaceOrder:function(){return K},setWorkspaceOrder:function(a){K=a},workspace:j,addSubflow:l,removeSubflow:o,subflow:m,subflowContains:p,eachNode:function(a){for(var b=0;b<G.length;b++)a(G[b])},eachLink:function(a){for(var b=0;b<I.length;b++)a(I[b])},eachConfig:function(a){for(var b in H)H.hasOwnProperty(b)&&a(H[b])},eachSubflow:function(a){for(var b in L)L.hasOwnProperty(b)&&a(L[b])},eachWorkspace:function(a){for(var b=0;b<K.length;b++)a(J[K[b]])},node:e,version:C,originalFlow:function(a){return void 0===a?F:void(F=a)},filterNodes:z,filterLinks:A,import:y,getAllFlowNodes:q,createExportableNodeSet:u,createCompleteNodeSet:v,updateConfigNodeUsers:B,id:b,dirty:function(b){return null==b?N:void a(b)}}}(),RED.history=function(){function a(b){var c,d,e,f,g={};if(b){if("multi"==b.t)for(d=b.events.length,c=d-1;c>=0;c--)a(b.events[c]);else if("replace"==b.t){RED.nodes.clear();var h=RED.nodes.import(b.config);h[0].forEach(function(a){b.changed[a.id]&&(a.changed=!0)}),RED.nodes.version(b.rev)}else if("add"==b.t){if(b.nodes)for(c=0;c<b.nodes.length;c++)e=RED.nodes.node(b.nodes[c]),e.z&&(g[e.z]=!0),RED.nodes.remove(b.nodes[c]);if(b.links)for(c=0;c<b.links.length;c++)RED.nodes.removeLink(b.links[c]);if(b.workspaces)for(c=0;c<b.workspaces.length;c++)RED.nodes.removeWorkspace(b.workspaces[c].id),RED.workspaces.remove(b.workspaces[c]);if(b.subflows)for(c=0;c<b.subflows.length;c++)RED.nodes.removeSubflow(b.subflows[c]),RED.workspaces.remove(b.subflows[c]);if(b.subflow&&(b.subflow.instances&&b.subflow.instances.forEach(function(a){var b=RED.nodes.node(a.id);b&&(b.changed=a.changed,b.dirty=!0)}),b.subflow.hasOwnProperty("changed")&&(f=RED.nodes.subflow(b.subflow.id),f&&(f.changed=b.subflow.changed))),b.removedLinks)for(c=0;c<b.removedLinks.length;c++)RED.nodes.addLink(b.removedLinks[c])}else if("delete"==b.t){if(b.workspaces)for(c=0;c<b.workspaces.length;c++)RED.nodes.addWorkspace(b.workspaces[c]),RED.workspaces.add(b.workspaces[c]);if(b.subflow&&b.subflow.subflow&&RED.nodes.addSubflow(b.subflow.subflow),b.subflowInputs&&b.subflowInputs.length>0&&(f=RED.nodes.subflow(b.subflowInputs[0].z),f.in.push(b.subflowInputs[0]),f.in[0].dirty=!0),b.subflowOutputs&&b.subflowOutputs.length>0)for(f=RED.nodes.subflow(b.subflowOutputs[0].z),b.subflowOutputs.sort(function(a,b){return a.i-b.i}),c=0;c<b.subflowOutputs.length;c++){var i=b.subflowOutputs[c];f.out.splice(i.i,0,i);for(var j=i.i+1;j<f.out.length;j++)f.out[j].i++,f.out[j].dirty=!0;RED.nodes.eachLink(function(a){a.source.type=="subflow:"+f.id&&a.sourcePort>=i.i&&a.sourcePort++})}if(b.subflow&&b.subflow.hasOwnProperty("instances")&&b.subflow.instances.forEach(function(a){var b=RED.nodes.node(a.id);b&&(b.changed=a.changed,b.dirty=!0)}),f&&RED.nodes.filterNodes({type:"subflow:"+f.id}).forEach(function(a){for(a.inputs=f.in.length;a.inputs>a.inputPorts.length;)a.inputPorts.push(a.inputPorts.length);for(a.outputs=f.out.length;a.outputs>a.outputPorts.length;)a.outputPorts.push(a.outputPorts.length);a.resize=!0,a.dirty=!0}),b.nodes)for(c=0;c<b.nodes.length;c++)RED.nodes.add(b.nodes[c]),g[b.nodes[c].z]=!0;if(b.links)for(c=0;c<b.links.length;c++)RED.nodes.addLink(b.links[c]);if(b.changes)for(c in b.changes)if(b.changes.hasOwnProperty(c)&&(e=RED.nodes.node(c))){for(var k in b.changes[c])b.changes[c].hasOwnProperty(k)&&(e[k]=b.changes[c][k]);e.dirty=!0}}else if("move"==b.t){for(c=0;c<b.nodes.length;c++){var l=b.nodes[c];l.n.x=l.ox,l.n.y=l.oy,l.n.dirty=!0,l.n.moved=l.moved}if(b.links)for(c=0;c<b.links.length;c++)RED.nodes.removeLink(b.links[c]);if(b.removedLinks)for(c=0;c<b.removedLinks.length;c++)RED.nodes.addLink(b.removedLinks[c])}else if("edit"==b.t){for(c in b.changes)if(b.changes.hasOwnProperty(c)){if(b.node._def.defaults[c]&&b.node._def.defaults[c].type){var m=RED.nodes.node(b.node[c]);m&&m.users.splice(m.users.indexOf(b.node),1);var n=RED.nodes.node(b.changes[c]);n&&n.users.push(b.node)}b.node[c]=b.changes[c]}if(b.subflow)b.subflow.hasOwnProperty("inputCount")&&(b.node.in.length>b.subflow.inputCount?b.node.in.splice(b.subflow.inputCount):b.subflow.inputs.length>0&&(b.node.in=b.node.in.concat(b.subflow.inputs))),b.subflow.hasOwnProperty("outputCount")&&(b.node.out.length>b.subflow.outputCount?b.node.out.splice(b.subflow.outputCount):b.subflow.outputs.length>0&&(b.node.out=b.node.out.concat(b.subflow.outputs))),b.subflow.hasOwnProperty("instances")&&b.subflow.instances.forEach(function(a){var b=RED.nodes.node(a.id);b&&(b.changed=a.changed,b.dirty=!0)}),RED.nodes.filterNodes({type:"subflow:"+b.node.id}).forEach(function(a){a.inputs=b.node.in.length,a.outputs=b.node.out.length,RED.editor.updateNodeProperties(a)});else{var o;if(b.outputMap){o={};for(var p in b.outputMap)b.outputMap.hasOwnProperty(p)&&"-1"!==b.outputMap[p]&&(o[b.outputMap[p]]=p)}RED.editor.updateNodeProperties(b.node,o),RED.editor.validateNode(b.node)}if(b.links)for(c=0;c<b.links.length;c++)RED.nodes.addLink(b.links[c]);b.node.dirty=!0,b.node.changed=b.changed}else if("createSubflow"==b.t){if(b.nodes)for(RED.nodes.filterNodes({z:b.subflow.subflow.id}).forEach(function(a){a.z=b.activeWorkspace,a.dirty=!0}),c=0;c<b.nodes.length;c++)RED.nodes.remove(b.nodes[c]);if(b.links)for(c=0;c<b.links.length;c++)RED.nodes.removeLink(b.links[c]);if(RED.nodes.removeSubflow(b.subflow.subflow),RED.workspaces.remove(b.subflow.subflow),b.removedLinks)for(c=0;c<b.removedLinks.length;c++)RED.nodes.addLink(b.removedLinks[c])}else"reorder"==b.t&&b.order&&RED.workspaces.order(b.order);Object.keys(g).forEach(function(a){var b=RED.nodes.subflow(a);b&&RED.editor.validateNode(b)}),RED.nodes.dirty(b.dirty),RED.view.redraw(!0),RED.palette.refresh(),RED.workspaces.refresh(),RED.sidebar.config.refresh()}}var b=[];return{markAllDirty:function(){for(var a=0;a<b.length;a++)b[a].dirty=!0},list:function(){return b},depth:function(){return b.length},push:function(a){b.push(a)},pop:function(){var c=b.pop();a(c)},peek:function(){return b[b.length-1]}}}(),RED.validators={number:function(a){return function(b){return a&&(""===b||void 0===b)||""!==b&&!isNaN(b)}},regex:function(a){return function(b){return a.test(b)}},typedInput:function(a,b){return function(c){var d=$("#node-"+(b?"config-":"")+"input-"+a);return!d||d.typedInput("validate")}}},RED.utils=function(){function a(a){return a.replace(/\r?\n/g,"&crarr;").replace(/\t/g,"&rarr;")}function b(a){return a.replace(/&/g,"&amp;").replace(/</g,"&lt;").replace(/>/g,"&gt;")}function c(c){var d;if(Array.isArray(c))d=$('<span class="debug-message-object-value debug-message-type-meta"></span>').html("array["+c.length+"]");else if(null===c)d=$('<span class="debug-message-object-value debug-message-type-null">null</span>');else if("object"==typeof c)d=c.hasOwnProperty("type")&&"Buffer"===c.type&&c.hasOwnProperty("data")?$('<span class="debug-message-object-value debug-message-type-meta"></span>').html("buffer["+c.length+"]"):c.hasOwnProperty("type")&&"array"===c.type&&c.hasOwnProperty("data")?$('<span class="debug-message-object-value debug-message-type-meta"></span>').html("array["+c.length+"]"):$('<span class="debug-message-object-value debug-message-type-meta">object</span>');else if("string"==typeof c){var e;e=c.length>30?b(c.substring(0,30))+"&hellip;":b(c),d=$('<span class="debug-message-object-value debug-message-type-string"></span>').html('"'+a(e)+'"')}else d=$('<span class="debug-message-object-value debug-message-type-other"></span>').text(""+c);return d}function d(a,b,c){a.addClass("debug-message-expandable"),a.click(function(a){var c=$(this).parent();c.hasClass("collapsed")?(b&&!c.hasClass("built")&&(b(),c.addClass("built")),c.removeClass("collapsed")):c.addClass("collapsed"),a.preventDefault()}),c&&a.click()}function e(a,b,c,d,e,f){o.hasOwnProperty(b)||(o[b]={});var g=$('<span class="debug-message-tools"></span>').appendTo(a),h=$('<span class="debug-message-tools-copy button-group"></span>').appendTo(g);if(c)var i=$('<button class="editor-button editor-button-small"><i class="fa fa-terminal"></i></button>').appendTo(h).click(function(a){a.preventDefault(),a.stopPropagation(),RED.clipboard.copyText(c,i,"clipboard.copyMessagePath")});var k=$('<button class="editor-button editor-button-small"><i class="fa fa-clipboard"></i></button>').appendTo(h).click(function(a){a.preventDefault(),a.stopPropagation(),RED.clipboard.copyText(d,k,"clipboard.copyMessageValue")});if(""!==f){var l=o[b].hasOwnProperty(f);$('<button class="editor-button editor-button-small debug-message-tools-pin"><i class="fa fa-map-pin"></i></button>').appendTo(g).click(function(c){if(c.preventDefault(),c.stopPropagation(),o[b].hasOwnProperty(f))delete o[b][f],$(this).removeClass("selected"),a.removeClass("debug-message-row-pinned");else{var d="$"+("["===f[0]?"":".")+f;o[b][f]=j(d),$(this).addClass("selected"),a.addClass("debug-message-row-pinned")}}).toggleClass("selected",l);a.toggleClass("debug-message-row-pinned",l)}}function f(a,b,c,d){if(b&&b.length>0){if(""===a&&void 0===c)return!0;for(var e=0;e<b.length;e++){var f=b[e];if(0===f.indexOf(a)&&("."===f[a.length]||"["===f[a.length])){if(void 0===c||"["!==f[a.length])return!0;var g=f.substring(a.length),h=/\[(\d+)\]/.exec(g);if(h){var i=parseInt(h[1]);return c<=i&&i<=d}}}}return!1}function g(a,b,c,d,e,f){var g=p[c]&&p[c][d]||f||"dec";e?(g="dec"===g?13===b.toString().length&&b<=2147483647e3?"dateMS":10===b.toString().length&&b<=2147483647?"dateS":"hex":"dateMS"===g||"dateS"==g?"hex":"dec",p[c]=p[c]||{},p[c][d]=g):void 0!==f&&(p[c]=p[c]||{},p[c][d]=g),"dec"===g?a.text(""+b):"dateMS"===g?a.text(new Date(b).toISOString()):"dateS"===g?a.text(new Date(1e3*b).toISOString()):"hex"===g&&a.text("0x"+b.toString(16))}function h(a,b,c,d,e){var f=p[c]&&p[c][d]||"raw";e&&(f="raw"===f?"string":"raw",p[c]=p[c]||{},p[c][d]=f),"raw"===f?(b.text("raw"),a.removeClass("debug-message-buffer-string").addClass("debug-message-buffer-raw")):"string"===f&&(b.text("string"),a.addClass("debug-message-buffer-string").removeClass("debug-message-buffer-raw"))}function i(j,k,m,n,p,q,r,s){var t,u,v,w,x,y;void 0!==p&&void 0!==r?y=p.substring(r.length+("."===p[r.length]?1:0)):(p="",r="");var z=$('<span class="debug-message-element"></span>');if(z.collapse=function(){z.find(".debug-message-expandable").parent().addClass("collapsed")},w=$('<span class="debug-message-row"></span>').appendTo(z),q&&e(w,q,p,j,r,y),k)n||($('<span class="debug-message-object-key"></span>').text(k).appendTo(w),$("<span>: </span>").appendTo(w));else if(z.addClass("debug-message-top-level"),q){var A=o[q];if(s=[],A){for(var B in A)if(A.hasOwnProperty(B))try{var C=l({$:j},A[B]);void 0!==C&&s.push(B)}catch(a){}s.sort()}z.clearPinned=function(){z.find(".debug-message-row-pinned").removeClass("debug-message-row-pinned"),o[q]={}}}v=$('<span class="debug-message-object-value"></span>').appendTo(w);var D=Array.isArray(j),E=!1;if(j&&"object"==typeof j&&j.hasOwnProperty("type")&&j.hasOwnProperty("data")&&(j.__encoded__&&"array"===j.type||"Buffer"===j.type)&&(D=!0,E=!0),null===j||void 0===j)$('<span class="debug-message-type-null">'+j+"</span>").appendTo(v);else if("string"==typeof j)/[\t\n\r]/.test(j)&&(z.addClass("collapsed"),$('<i class="fa fa-caret-right debug-message-object-handle"></i> ').prependTo(w),d(w,function(){$('<span class="debug-message-type-meta debug-message-object-type-header"></span>').html(m||"string").appendTo(w);var a=$('<div class="debug-message-object-entry collapsed"></div>').appendTo(z);$('<pre class="debug-message-type-string"></pre>').text(j).appendTo(a)},f(y,s))),u=$('<span class="debug-message-type-string debug-message-object-header"></span>').html('"'+a(b(j))+'"').appendTo(v),/^#[0-9a-f]{6}$/i.test(j)&&$('<span class="debug-message-type-string-swatch"></span>').css("backgroundColor",j).appendTo(u);else if("number"==typeof j)u=$('<span class="debug-message-type-number"></span>').appendTo(v),Number.isInteger(j)&&j>=0&&(u.addClass("debug-message-type-number-toggle"),u.click(function(a){a.preventDefault(),g($(this),j,q,p,!0)})),g(u,j,q,p,!1,"hex"===m?"hex":void 0);else if(D){z.addClass("collapsed");var F=j.length;if(m){var G=/\[(\d+)\]/.exec(m);G&&(F=parseInt(G[1]))}var H=j,I="array";E?(H=j.data,void 0===F&&(F=H.length),H.__encoded__&&(H=H.data),I=j.type.toLowerCase()):/buffer/.test(m)&&(I="buffer");var J=H.length;if(F>0){$('<i class="fa fa-caret-right debug-message-object-handle"></i> ').prependTo(w);var K=$('<div class="debug-message-array-rows"></div>').appendTo(z);z.addClass("debug-message-buffer-raw")}if(k)x=$('<span class="debug-message-type-meta"></span>').html(m||I+"["+F+"]").appendTo(v);else{x=$('<span class="debug-message-object-header"></span>').appendTo(v),$("<span>[ </span>").appendTo(x);var L=Math.min(F,10);for(t=0;t<L;t++)c(H[t]).appendTo(x),t<L-1&&$("<span>, </span>").appendTo(x);F>L&&$("<span> &hellip;</span>").appendTo(x),0===L&&$('<span class="debug-message-type-meta">empty</span>').appendTo(x),$("<span> ]</span>").appendTo(x)}F>0&&d(w,function(){if(k||(x=$('<span class="debug-message-type-meta debug-message-object-type-header"></span>').html(m||I+"["+F+"]").appendTo(w)),"buffer"===I){var a=$('<div class="debug-message-string-rows"></div>').appendTo(z),b=$('<div class="debug-message-object-entry collapsed"></div>').appendTo(a),c="";try{c=String.fromCharCode.apply(null,new Uint16Array(H))}catch(a){console.log(a)}$('<pre class="debug-message-type-string"></pre>').text(c).appendTo(b);var e=$('<span class="debug-message-buffer-opts"></span>').appendTo(x),g=$('<a href="#"></a>').addClass("selected").html("raw").appendTo(e).click(function(a){a.preventDefault(),a.stopPropagation(),h(z,$(this),q,p,!0)});h(z,g,q,p,!1)}var j;if(J<=10)for(t=0;t<J;t++)j=$('<div class="debug-message-object-entry collapsed"></div>').appendTo(K),i(H[t],""+t,"buffer"===I&&"hex",!1,p+"["+t+"]",q,r,s).appendTo(j);else{for(t=0;t<J;t+=10){var l=t;j=$('<div class="debug-message-object-entry collapsed"></div>').appendTo(K),w=$("<span></span>").appendTo(j),$('<i class="fa fa-caret-right debug-message-object-handle"></i> ').appendTo(w),d(w,function(){var a=l,b=Math.min(J-1,l+9),c=j;return function(){for(var d=a;d<=b;d++){var e=$('<div class="debug-message-object-entry collapsed"></div>').appendTo(c);i(H[d],""+d,"buffer"===I&&"hex",!1,p+"["+d+"]",q,r,s).appendTo(e)}}}(),f(y,s,l,Math.min(J-1,l+9))),$('<span class="debug-message-object-key"></span>').html("["+l+" &hellip; "+Math.min(J-1,l+9)+"]").appendTo(w)}J<F&&$('<div class="debug-message-object-entry collapsed"><span class="debug-message-object-key">['+J+" &hellip; "+F+"]</span></div>").appendTo(K)}},f(y,s))}else if("object"==typeof j){z.addClass("collapsed");var M=Object.keys(j);if((k||M.length>0)&&($('<i class="fa fa-caret-right debug-message-object-handle"></i> ').prependTo(w),d(w,function(){for(k||$('<span class="debug-message-type-meta debug-message-object-type-header"></span>').html("object").appendTo(w),t=0;t<M.length;t++){var a=$('<div class="debug-message-object-entry collapsed"></div>').appendTo(z),b=p;b+=/^[a-zA-Z_$][0-9a-zA-Z_$]*$/.test(M[t])?(b.length>0?".":"")+M[t]:'["'+M[t].replace(/"/,'\\"')+'"]',i(j[M[t]],M[t],!1,!1,b,q,r,s).appendTo(a)}0===M.length&&$('<div class="debug-message-object-entry debug-message-type-meta collapsed"></div>').text("empty").appendTo(z)},f(y,s))),k)$('<span class="debug-message-type-meta"></span>').html("object").appendTo(v);else{x=$('<span class="debug-message-object-header"></span>').appendTo(v),$("<span>{ </span>").appendTo(x);var N=Math.min(M.length,5);for(t=0;t<N;t++)$('<span class="debug-message-object-key"></span>').text(M[t]).appendTo(x),$("<span>: </span>").appendTo(x),c(j[M[t]]).appendTo(x),t<N-1&&$("<span>, </span>").appendTo(x);M.length>N&&$("<span> &hellip;</span>").appendTo(x),0===N&&$('<span class="debug-message-type-meta">empty</span>').appendTo(x),$("<span> }</span>").appendTo(x)}}else $('<span class="debug-message-type-other"></span>').text(""+j).appendTo(v);return z}function j(a){var b=a.length;if(0===b)throw new Error("Invalid property expression: zero-length");for(var c,d,e=[],f=0,g=!1,h=!1,i=0;i<b;i++){var j=a[i];if(g){if(j===c){if(i-f===0)throw new Error("Invalid property expression: zero-length string at position "+f);if(e.push(a.substring(f,i)),h&&!/\]/.test(a[i+1]))throw new Error("Invalid property expression: unexpected array expression at position "+f);if(!h&&i+1!==b&&!/[\[\.]/.test(a[i+1]))throw new Error("Invalid property expression: unexpected "+a[i+1]+" expression at position "+(i+1));f=i+1,g=!1}}else if("'"===j||'"'===j){if(i!=f)throw new Error("Invalid property expression: unexpected "+j+" at position "+i);g=!0,c=j,f=i+1}else if("."===j){if(0===i)throw new Error("Invalid property expression: unexpected . at position 0");if(f!=i&&(d=a.substring(f,i),/^\d+$/.test(d)?e.push(parseInt(d)):e.push(d)),i===b-1)throw new Error("Invalid property expression: unterminated expression");if(!/[a-z0-9\$\_]/i.test(a[i+1]))throw new Error("Invalid property expression: unexpected "+a[i+1]+" at position "+(i+1));f=i+1}else if("["===j){if(0===i)throw new Error("Invalid property expression: unexpected "+j+" at position "+i);if(f!=i&&e.push(a.substring(f,i)),i===b-1)throw new Error("Invalid property expression: unterminated expression");if(!/["'\d]/.test(a[i+1]))throw new Error("Invalid property expression: unexpected "+a[i+1]+" at position "+(i+1));f=i+1,h=!0}else if("]"===j){if(!h)throw new Error("Invalid property expression: unexpected "+j+" at position "+i);if(f!=i){if(d=a.substring(f,i),!/^\d+$/.test(d))throw new Error("Invalid property expression: unexpected array expression at position "+f);e.push(parseInt(d))}f=i+1,h=!1}else if(" "===j)throw new Error("Invalid property expression: unexpected ' ' at position "+i)}if(h||g)throw new Error("Invalid property expression: unterminated expression");return f<b&&e.push(a.substring(f)),e}function k(a){try{j(a);return!0}catch(a){return!1}}function l(a,b){var c,d=null;"string"==typeof b?(0===b.indexOf("msg.")&&(b=b.substring(4)),c=j(b)):c=b;return c.reduce(function(a,b){return d="undefined"!=typeof a[b]?a[b]:void 0,void 0===d&&a.hasOwnProperty("type")&&a.hasOwnProperty("data")&&a.hasOwnProperty("length")&&(d="undefined"!=typeof a.data[b]?a.data[b]:void 0),d},a),d}function m(a,b){if("config"===a.category)return"icons/node-red/cog.png";if(b&&"tab"===b.type)return"icons/node-red/subflow.png";if(b&&"unknown"===b.type)return"icons/node-red/alert.png";var c;if("function"==typeof a.icon)try{c=a.icon.call(b)}catch(b){console.log("Definition error: "+a.type+".icon",b),c="arrow-in.png"}else c=a.icon;return"icons/"+a.namespace+"/"+c}function n(a,b){b=b||"";var c;if("tab"===a.type)c=a.label||b;else{c=a._def.label;try{c=("function"==typeof c?c.call(a):c)||b}catch(d){console.log("Definition error: "+a.type+".label",d),c=b}}return RED.text.bidi.enforceTextDirectionWithUCC(c)}var o={},p={};return{createObjectElement:i,getMessageProperty:l,normalisePropertyExpression:j,validatePropertyExpression:k,getNodeIcon:m,getNodeLabel:n}}(),function(a){a.widget("nodered.editableList",{_create:function(){var b=this;if(this.element.addClass("red-ui-editableList-list"),this.uiWidth=this.element.width(),this.uiContainer=this.element.wrap("<div>").parent(),this.options.header?(this.options.header.addClass("red-ui-editableList-header"),this.borderContainer=this.uiContainer.wrap("<div>").parent(),this.borderContainer.prepend(this.options.header),this.topContainer=this.borderContainer.wrap("<div>").parent()):this.topContainer=this.uiContainer.wrap("<div>").parent(),this.topContainer.addClass("red-ui-editableList"),this.options.class&&this.topContainer.addClass(this.options.class),this.options.addButton!==!1){var c;c="string"==typeof this.options.addButton?this.options.addButton:RED&&RED._?RED._("editableList.add"):"add",a('<a href="#" class="editor-button editor-button-small" style="margin-top: 4px;"><i class="fa fa-plus"></i> '+c+"</a>").appendTo(this.topContainer).click(function(a){a.preventDefault(),b.addItem({})})}"absolute"===this.element.css("position")&&(["top","left","bottom","right"].forEach(function(a){var c=b.element.css(a);"auto"!==a&&""!==a&&(b.topContainer.css(a,c),b.uiContainer.css(a,"0"),b.element.css(a,"auto"))}),this.element.css("position","static"),this.topContainer.css("position","absolute"),this.uiContainer.css("position","absolute")),this.options.header?this.borderContainer.addClass("red-ui-editableList-border"):this.uiContainer.addClass("red-ui-editableList-border"),this.uiContainer.addClass("red-ui-editableList-container"),this.uiHeight=this.element.height(),this.activeFilter=this.options.filter||null,this.activeSort=this.options.sort||null,this.scrollOnAdd=this.options.scrollOnAdd,void 0===this.scrollOnAdd&&(this.scrollOnAdd=!0);var d=this.element.css("minHeight");"0px"!==d&&(this.uiContainer.css("minHeight",d),this.element.css("minHeight",0)),"auto"!==this.options.height&&(this.uiContainer.css("overflow-y","scroll"),isNaN(this.options.height)||(this.uiHeight=this.options.height)),this.element.height("auto");var e,f=this.element.attr("style");if(null!==(e=/width\s*:\s*(\d+%)/i.exec(f))&&(this.element.width("100%"),
 this.uiContainer.width(e[1])),this.options.sortable){var g="string"==typeof this.options.sortable?this.options.sortable:".red-ui-editableList-item-handle",h={axis:"y",update:function(a,c){b.options.sortItems&&b.options.sortItems(b.items())},handle:g,cursor:"move",tolerance:"pointer",forcePlaceholderSize:!0,placeholder:"red-ui-editabelList-item-placeholder",start:function(a,b){b.placeholder.height(b.item.height()-4)}};this.options.connectWith&&(h.connectWith=this.options.connectWith),this.element.sortable(h)}this._resize()},_resize:function(){var b=this.topContainer.height(),c=this.uiContainer.height(),d=b-c;if(0!==this.uiHeight&&this.uiContainer.height(this.uiHeight-d),this.options.resize&&this.options.resize(),this.options.resizeItem){var e=this;this.element.children().each(function(b){e.options.resizeItem(a(this).find(".red-ui-editableList-item-content"),b)})}},_destroy:function(){},_refreshFilter:function(){var a=this,b=0;if(!this.activeFilter)return this.element.children().show();var c=this.items();return c.each(function(c,d){var e=d.data("data");try{a.activeFilter(e)?(d.parent().show(),b++):d.parent().hide()}catch(a){console.log(a),d.parent().show(),b++}}),b},_refreshSort:function(){if(this.activeSort){var b=this.element.children(),c=this;b.sort(function(b,d){return c.activeSort(a(b).find(".red-ui-editableList-item-content").data("data"),a(d).find(".red-ui-editableList-item-content").data("data"))}),a.each(b,function(a,b){c.element.append(b)})}},width:function(a){this.uiWidth=a,this._resize()},height:function(a){this.uiHeight=a,this._resize()},addItem:function(b){var c=this;b=b||{};var d=a("<li>"),e=!1;if(this.activeSort){var f=this.items();f.each(function(a,f){if(!e){var g=f.data("data");c.activeSort(b,g)<0&&(d.insertBefore(f.closest("li")),e=!0)}})}e||d.appendTo(this.element);var g=a("<div/>").addClass("red-ui-editableList-item-content").appendTo(d);if(g.data("data",b),this.options.sortable===!0&&(a('<i class="red-ui-editableList-item-handle fa fa-bars"></i>').appendTo(d),d.addClass("red-ui-editableList-item-sortable")),this.options.removable){var h=a("<a/>",{href:"#",class:"red-ui-editableList-item-remove editor-button editor-button-small"}).appendTo(d);a("<i/>",{class:"fa fa-remove"}).appendTo(h),d.addClass("red-ui-editableList-item-removable"),h.click(function(b){b.preventDefault();var e=g.data("data");d.addClass("red-ui-editableList-item-deleting"),d.fadeOut(300,function(){a(this).remove(),c.options.removeItem&&c.options.removeItem(e)})})}if(this.options.addItem){var i=c.element.children().length-1;setTimeout(function(){if(c.options.addItem(g,i,b),c.activeFilter)try{c.activeFilter(b)||d.hide()}catch(a){}!c.activeSort&&c.scrollOnAdd&&setTimeout(function(){c.uiContainer.scrollTop(c.element.height())},0)},0)}},addItems:function(a){for(var b=0;b<a.length;b++)this.addItem(a[b])},removeItem:function(b){var c=this.element.children().filter(function(c){return b===a(this).find(".red-ui-editableList-item-content").data("data")});c.remove(),this.options.removeItem&&this.options.removeItem(b)},items:function(){return this.element.children().map(function(b){return a(this).find(".red-ui-editableList-item-content")})},empty:function(){this.element.empty()},filter:function(a){return void 0!==a&&(this.activeFilter=a),this._refreshFilter()},sort:function(a){return void 0!==a&&(this.activeSort=a),this._refreshSort()},length:function(){return this.element.children().length}})}(jQuery),function(a){a.widget("nodered.checkboxSet",{_create:function(){var b=this;this.uiElement=this.element.wrap("<span>").parent(),this.uiElement.addClass("red-ui-checkboxSet"),this.options.parent&&(this.parent=this.options.parent,this.parent.checkboxSet("addChild",this.element)),this.children=[],this.partialFlag=!1,this.stateValue=0;var c=this.element.prop("checked");this.options=[a('<span class="red-ui-checkboxSet-option hide"><i class="fa fa-square-o"></i></span>').appendTo(this.uiElement),a('<span class="red-ui-checkboxSet-option hide"><i class="fa fa-check-square-o"></i></span>').appendTo(this.uiElement),a('<span class="red-ui-checkboxSet-option hide"><i class="fa fa-minus-square-o"></i></span>').appendTo(this.uiElement)],c?this.options[1].show():this.options[0].show(),this.element.change(function(){this.checked?(b.options[0].hide(),b.options[1].show(),b.options[2].hide()):(b.options[1].hide(),b.options[0].show(),b.options[2].hide());var a=this.checked;b.children.forEach(function(b){b.checkboxSet("state",a,!1,!0)})}),this.uiElement.click(function(a){a.stopPropagation(),b.state(b.state()===!1)}),this.parent&&this.parent.checkboxSet("updateChild",this)},_destroy:function(){this.parent&&this.parent.checkboxSet("removeChild",this.element)},addChild:function(a){this.children.push(a)},removeChild:function(a){var b=this.children.indexOf(a);b>-1&&this.children.splice(b,1)},updateChild:function(a){var b=0;this.children.forEach(function(a,c){a.checkboxSet("state")===!0&&b++}),0===b?this.state(!1,!0):b===this.children.length?this.state(!0,!0):this.state(null,!0)},disable:function(){this.uiElement.addClass("disabled")},state:function(a,b,c){if(0===arguments.length)return this.partialFlag?null:this.element.is(":checked");this.partialFlag=null===a;var d=this.partialFlag||a;this.element.prop("checked",d),a===!0?(this.options[0].hide(),this.options[1].show(),this.options[2].hide()):a===!1?(this.options[2].hide(),this.options[1].hide(),this.options[0].show()):null===a&&(this.options[0].hide(),this.options[1].hide(),this.options[2].show()),b||this.element.trigger("change",null),!c&&this.parent&&this.parent.checkboxSet("updateChild",this)}})}(jQuery),RED.menu=function(){function a(b){function f(){var a=RED.settings.get("menu-"+b.id);b.setting&&(null!==a?(RED.settings.set(b.setting,a),RED.settings.remove("menu-"+b.id)):a=RED.settings.get(b.setting)),a?(j.addClass("active"),c(b.id,!0)):a===!1?(j.removeClass("active"),c(b.id,!1)):b.hasOwnProperty("selected")&&(b.selected?j.addClass("active"):j.removeClass("active"),c(b.id,b.selected))}var g;if(null!==b&&b.id){var h=RED.settings.theme("menu."+b.id);if(h===!1)return null}if(null===b)g=$('<li class="divider"></li>');else{g=$("<li></li>"),b.group&&g.addClass("menu-group-"+b.group);var i="<a "+(b.id?'id="'+b.id+'" ':"")+'tabindex="-1" href="#">';b.toggle&&(i+='<i class="fa fa-square pull-left"></i>',i+='<i class="fa fa-check-square pull-left"></i>'),void 0!==b.icon&&(i+=/\.png/.test(b.icon)?'<img src="'+b.icon+'"/> ':'<i class="'+(b.icon?b.icon:'" style="display: inline-block;"')+'"></i> '),i+=b.sublabel?'<span class="menu-label-container"><span class="menu-label">'+b.label+'</span><span class="menu-sublabel">'+b.sublabel+"</span></span>":'<span class="menu-label">'+b.label+"</span>",i+="</a>";var j=$(i).appendTo(g);if(k[b.id]=b,b.onselect?(j.click(function(a){if(a.preventDefault(),!$(this).parent().hasClass("disabled"))if(b.toggle){var f=d(b.id);if("string"==typeof b.toggle){if(!f){for(var g in k)if(k.hasOwnProperty(g)){var h=k[g];h.id!=b.id&&b.toggle==h.toggle&&e(h.id,!1)}e(b.id,!0)}}else e(b.id,!f)}else c(b.id)}),b.toggle&&f()):b.href?j.attr("target","_blank").attr("href",b.href):b.hrefLocal?j.attr("target","_self").attr("href",b.hrefLocal):b.options||(g.addClass("disabled"),j.click(function(a){a.preventDefault()})),b.options){g.addClass("dropdown-submenu pull-left");for(var l=$('<ul id="'+b.id+'-submenu" class="dropdown-menu"></ul>').appendTo(g),m=0;m<b.options.length;m++){var n=a(b.options[m]);n&&n.appendTo(l)}}b.disabled&&g.addClass("disabled")}return g}function b(b){var c=$("#"+b.id),d=$("<ul/>",{id:b.id+"-submenu",class:"dropdown-menu pull-right"});1===c.length&&d.insertAfter(c);for(var e=!1,f=0;f<b.options.length;f++){var g=b.options[f];if(null!==g||!e){var h=a(g);h&&(h.appendTo(d),e=null===g)}}return d}function c(a,b){var c=k[a],d=c.onselect;"string"==typeof c.onselect&&(d=RED.actions.get(c.onselect)),d?d.call(c,b):console.log("No callback for",a,c.onselect)}function d(a){return $("#"+a).hasClass("active")}function e(a,b){if(d(a)!=b){var e=k[a];b?$("#"+a).addClass("active"):$("#"+a).removeClass("active"),e&&e.onselect&&c(e.id,b),RED.settings.set(e.setting||"menu-"+e.id,b)}}function f(a){e(a,!d(a))}function g(a,b){b?$("#"+a).parent().addClass("disabled"):$("#"+a).parent().removeClass("disabled")}function h(b,c){var d=a(c);if(c.group){var e=$("#"+b+"-submenu").children(".menu-group-"+c.group);if(0===e.length)d.appendTo("#"+b+"-submenu");else{for(var f=0;f<e.length;f++){var g=e[f],h=$(g).find(".menu-label").html();if(c.label<h){$(g).before(d);break}}f===e.length&&d.appendTo("#"+b+"-submenu")}}else d.appendTo("#"+b+"-submenu")}function i(a){$("#"+a).parent().remove()}function j(a,b){var c=k[a];c&&(c.onselect=b)}var k={};return{init:b,setSelected:e,isSelected:d,toggleSelected:f,setDisabled:g,addItem:h,removeItem:i,setAction:j}}(),RED.panels=function(){function a(a){var b=a.container||$("#"+a.id),c=b.children();if(2!==c.length)throw new Error("Container must have exactly two children");b.addClass("red-ui-panels");var d,e,f=$('<div class="red-ui-panels-separator"></div>').insertAfter(c[0]),g=[],h=!1;return f.draggable({axis:"y",containment:b,scroll:!1,start:function(a,e){var f=b.height();d=e.position.top,g=[$(c[0]).height(),$(c[1]).height()],console.log("START",f,g,g[0]+g[1],f-(g[0]+g[1]))},drag:function(f,h){var i=b.height(),j=h.position.top-d,k=[g[0]+j,g[1]-j];$(c[0]).height(k[0]),$(c[1]).height(k[1]),a.resize&&a.resize(k[0],k[1]),h.position.top-=j,e=k[0]/i},stop:function(a,b){h=!0}}),{resize:function(d){var f=[$(c[0]).height(),$(c[1]).height()];if(b.height(d),h){var g=e*d,i=d-g-48;f=[g,i],$(c[0]).height(f[0]),$(c[1]).height(f[1]),console.log("SET",d,f,f[0]+f[1],d-(f[0]+f[1]))}a.resize&&a.resize(f[0],f[1])}}}return{create:a}}(),RED.popover=function(){function a(a){var c=a.target,d=a.direction||"right",e=a.trigger,f=a.content,g=a.delay,h=a.width||"auto",i=a.size||"default",j=a.offsetX||0,k=a.offsetY||0;if(!b[i])throw new Error("Invalid RED.popover size value:",i);var l,m,n=null,o=function(){if(l){m=$('<div class="red-ui-popover red-ui-popover-'+d+'"></div>').appendTo("body"),"default"!==i&&m.addClass("red-ui-popover-size-"+i),"function"==typeof f?f.call(q).appendTo(m):m.html(f),"auto"!==h&&m.width(h);var a=c.offset();a.top+=k,a.left+=j;var e=c.width(),g=c.height(),n=m.height(),o=m.width();"right"===d?m.css({top:a.top+g/2-n/2-b[i].top,left:a.left+e+b[i].leftRight}):"left"===d&&m.css({top:a.top+g/2-n/2-b[i].top,left:a.left-b[i].leftLeft-o}),m.fadeIn("fast")}},p=function(){l||m&&(m.fadeOut("fast",function(){$(this).remove()}),m=null)};"hover"===e?(c.on("mouseenter",function(a){clearTimeout(n),l=!0,n=setTimeout(o,g.show)}),c.on("mouseleave",function(a){n&&clearTimeout(n),l=!1,setTimeout(p,g.hide)})):"click"===e&&c.click(function(a){a.preventDefault(),a.stopPropagation(),l=!l,l?o():p()});var q={setContent:function(a){f=a},open:function(){l=!0,o()},close:function(){l=!1,p()}};return q}var b={default:{top:10,leftRight:17,leftLeft:25},small:{top:5,leftRight:8,leftLeft:16}};return{create:a}}(),function(a){a.widget("nodered.searchBox",{_create:function(){var b=this;this.currentTimeout=null,this.lastSent="",this.element.val(""),this.uiContainer=this.element.wrap("<div>").parent(),this.uiContainer.addClass("red-ui-searchBox-container"),a('<i class="fa fa-search"></i>').prependTo(this.uiContainer),this.clearButton=a('<a href="#"><i class="fa fa-times"></i></a>').appendTo(this.uiContainer),this.clearButton.on("click",function(a){a.preventDefault(),b.element.val(""),b._change("",!0),b.element.focus()}),this.resultCount=a("<span>",{class:"red-ui-searchBox-resultCount hide"}).appendTo(this.uiContainer),this.element.val(""),this.element.on("keydown",function(a){27===a.keyCode&&b.element.val("")}),this.element.on("keyup",function(c){b._change(a(this).val())}),this.element.on("focus",function(){a("body").one("mousedown",function(){b.element.blur()})})},_change:function(a,b){var c=!1;""===a?(this.clearButton.hide(),c=!0):(this.clearButton.show(),c=a.length>=(this.options.minimumLength||0));var d=this.element.val();if(c=c&&d!==this.lastSent)if(!b&&this.options.delay>0){clearTimeout(this.currentTimeout);var e=this;this.currentTimeout=setTimeout(function(){e.lastSent=e.element.val(),e._trigger("change")},this.options.delay)}else this._trigger("change")},value:function(a){return void 0===a?this.element.val():(this.element.val(a),void this._change(a))},count:function(a){void 0===a||null===a||""===a?this.resultCount.text("").hide():this.resultCount.text(a).show()},change:function(){this._trigger("change")}})}(jQuery),RED.tabs=function(){function a(a){function b(a,b){if(a.preventDefault(),!$(this).hasClass("disabled")){var c=p.scrollLeft();p.animate({scrollLeft:b},100);var d=setInterval(function(){var a=p.scrollLeft();return a===c?void clearInterval(d):(c=a,void p.animate({scrollLeft:b},100))},100);$(this).one("mouseup",function(){clearInterval(d)})}}function c(){return a.onclick&&a.onclick(l[$(this).attr("href").slice(1)]),f($(this)),!1}function d(){if(0!==n.children().length){var a=p.scrollLeft(),b=p.width(),c=n.width();0===a?r.hide():r.show(),a===c-b?s.hide():s.show()}}function e(){return a.ondblclick&&a.ondblclick(l[$(this).attr("href").slice(1)]),!1}function f(b){if("string"==typeof b&&(b=n.find("a[href='#"+b+"']")),0!==b.length&&!b.parent().hasClass("active")){if(n.children().removeClass("active"),n.children().css({transition:"width 100ms"}),b.parent().addClass("active"),a.scrollable){var c=b.parent().position().left;c-21<0?p.animate({scrollLeft:"+="+(c-50)},300):c+120>p.width()&&p.animate({scrollLeft:"+="+(c+140-p.width())},300)}a.onchange&&a.onchange(l[b.attr("href").slice(1)]),i(),setTimeout(function(){n.children().css({transition:""})},100)}}function g(){var a=n.find("li.active").prev();a.length>0&&f(a.find("a"))}function h(){var a=n.find("li.active").next();a.length>0&&f(a.find("a"))}function i(){if(!a.vertical){var b=n.find("li.red-ui-tab"),c=o.width(),e=b.size(),f=(c-12-6*e)/e;if(k=100*f/c+"%",m=k+"%",a.scrollable){f=Math.max(f,140),k=f+"px",m=0;var g=Math.max(o.width(),12+(f+6)*e);n.width(g),d()}else a.hasOwnProperty("minimumActiveTabWidth")&&(f<a.minimumActiveTabWidth?(e-=1,f=(c-12-a.minimumActiveTabWidth-6*e)/e,k=100*f/c+"%",m=a.minimumActiveTabWidth+"px"):m=0);b.css({width:k}),f<50?(n.find(".red-ui-tab-close").hide(),n.find(".red-ui-tab-icon").hide(),n.find(".red-ui-tab-label").css({paddingLeft:Math.min(12,Math.max(0,f-38))+"px"})):(n.find(".red-ui-tab-close").show(),n.find(".red-ui-tab-icon").show(),n.find(".red-ui-tab-label").css({paddingLeft:""})),0!==m&&(n.find("li.red-ui-tab.active").css({width:a.minimumActiveTabWidth}),n.find("li.red-ui-tab.active .red-ui-tab-close").show(),n.find("li.red-ui-tab.active .red-ui-tab-icon").show(),n.find("li.red-ui-tab.active .red-ui-tab-label").css({paddingLeft:""}))}}function j(b){var c=n.find("a[href='#"+b+"']").parent();if(c.hasClass("active")){var d=c.prev();0===d.size()&&(d=c.next()),f(d.find("a"))}c.remove(),a.onremove&&a.onremove(l[b]),delete l[b],i()}var k,l={},m=0,n=a.element||$("#"+a.id),o=n.wrap("<div>").parent(),p=n.wrap("<div>").parent();if(o.addClass("red-ui-tabs"),a.vertical&&o.addClass("red-ui-tabs-vertical"),a.addButton&&"function"==typeof a.addButton){o.addClass("red-ui-tabs-add");var q=$('<div class="red-ui-tab-button"><a href="#"><i class="fa fa-plus"></i></a></div>').appendTo(o);q.find("a").click(function(b){b.preventDefault(),a.addButton()})}var r,s;return a.scrollable&&(o.addClass("red-ui-tabs-scrollable"),p.addClass("red-ui-tabs-scroll-container"),p.scroll(d),r=$('<div class="red-ui-tab-button red-ui-tab-scroll red-ui-tab-scroll-left"><a href="#" style="display:none;"><i class="fa fa-caret-left"></i></a></div>').appendTo(o).find("a"),r.on("mousedown",function(a){b(a,"-=150")}).on("click",function(a){a.preventDefault()}),s=$('<div class="red-ui-tab-button red-ui-tab-scroll red-ui-tab-scroll-right"><a href="#" style="display:none;"><i class="fa fa-caret-right"></i></a></div>').appendTo(o).find("a"),s.on("mousedown",function(a){b(a,"+=150")}).on("click",function(a){a.preventDefault()})),n.children().first().addClass("active"),n.children().addClass("red-ui-tab"),n.find("li.red-ui-tab a").on("click",c).on("dblclick",e),setTimeout(function(){i()},0),{addTab:function(b){l[b.id]=b;var d=$("<li/>",{class:"red-ui-tab"}).appendTo(n);d.attr("id","red-ui-tab-"+b.id.replace(".","-")),d.data("tabId",b.id);var g=$("<a/>",{href:"#"+b.id,class:"red-ui-tab-label"}).appendTo(d);b.icon&&$('<img src="'+b.icon+'" class="red-ui-tab-icon"/>').appendTo(g);var h=$("<span/>",{class:"bidiAware"}).text(b.label).appendTo(g);if(h.attr("dir",RED.text.bidi.resolveBaseTextDir(b.label)),g.on("click",c),g.on("dblclick",e),b.closeable){var k=$("<a/>",{href:"#",class:"red-ui-tab-close"}).appendTo(d);k.append('<i class="fa fa-times" />'),k.on("click",function(a){a.preventDefault(),j(b.id)})}if(i(),a.onadd&&a.onadd(b),g.attr("title",b.label),1==n.find("li.red-ui-tab").size()&&f(g),a.onreorder){var m,o,q,r=[];d.draggable({axis:"x",distance:20,start:function(a,b){m=[],r=[],n.children().each(function(a){r[a]={el:$(this),text:$(this).text(),left:$(this).position().left,width:$(this).width()},$(this).is(d)&&(o=a,q=a),m.push($(this).data("tabId"))}),n.children().each(function(a){a!==o&&$(this).css({position:"absolute",left:r[a].left+"px",width:r[a].width+2,transition:"left 0.3s"})}),d.hasClass("active")||d.css({zIndex:1})},drag:function(a,b){b.position.left+=r[o].left+p.scrollLeft();for(var c=b.position.left+r[o].width/2-p.scrollLeft(),d=0;d<r.length;d++)if(d!==o&&c>r[d].left&&c<r[d].left+r[d].width){d<o?(r[d].left+=r[o].width+8,r[o].el.detach().insertBefore(r[d].el)):(r[d].left-=r[o].width+8,r[o].el.detach().insertAfter(r[d].el)),r[d].el.css({left:r[d].left+"px"}),r.splice(d,0,r.splice(o,1)[0]),o=d;break}},stop:function(b,c){n.children().css({position:"relative",left:"",transition:""}),d.hasClass("active")||d.css({zIndex:""}),i(),q!==o&&a.onreorder(m,$.makeArray(n.children().map(function(){return $(this).data("tabId")}))),f(r[o].el.data("tabId"))}})}},removeTab:j,activateTab:f,nextTab:h,previousTab:g,resize:i,count:function(){return n.find("li.red-ui-tab").size()},contains:function(a){return n.find("a[href='#"+a+"']").length>0},renameTab:function(a,b){l[a].label=b;var c=n.find("a[href='#"+a+"']");c.attr("title",b),c.find("span.bidiAware").text(b).attr("dir",RED.text.bidi.resolveBaseTextDir(b)),i()},order:function(a){var b=$.makeArray(n.children().map(function(){return $(this).data("tabId")}));if(b.length===a.length){var c,d=!0;for(c=0;c<a.length;c++)if(a[c]!==b[c]){d=!1;break}if(!d){var e={};n.children().detach().each(function(){e[$(this).data("tabId")]=$(this)});for(c=0;c<a.length;c++)e[a[c]].appendTo(n)}}}}}return{create:a}}(),RED.stack=function(){function a(a){var b=a.container,c=[],d=!0;return{add:function(e){c.push(e),e.container=$('<div class="palette-category">').appendTo(b),d||e.container.hide();var f=$('<div class="palette-header"></div>').appendTo(e.container);if(e.content=$("<div></div>").appendTo(e.container),e.collapsible!==!1){f.click(function(){if(a.singleExpanded){if(!e.isExpanded()){for(var b=0;b<c.length;b++)c[b].isExpanded()&&c[b].collapse();e.expand()}}else e.toggle()});var g=$('<i class="fa fa-angle-down"></i>').appendTo(f);e.expanded?g.addClass("expanded"):e.content.hide()}else f.css("cursor","default");return e.title=$("<span></span>").html(e.title).appendTo(f),e.toggle=function(){return e.isExpanded()?(e.collapse(),!1):(e.expand(),!0)},e.expand=function(){if(!e.isExpanded())return e.onexpand&&e.onexpand.call(e),g.addClass("expanded"),e.content.slideDown(200),!0},e.collapse=function(){if(e.isExpanded())return g.removeClass("expanded"),e.content.slideUp(200),!0},e.isExpanded=function(){return g.hasClass("expanded")},e},hide:function(){return d=!1,c.forEach(function(a){a.container.hide()}),this},show:function(){return d=!0,c.forEach(function(a){a.container.show()}),this}}}return{create:a}}(),function(a){var b={bool:{value:"bool",label:"bool",icon:"red/images/typedInput/bool.png",options:["true","false"]},string:{value:"string",label:"string",icon:"red/images/typedInput/az.png"},int:{value:"int",label:"int",icon:"red/images/typedInput/09.png",validate:/^[+-]?[0-9]*$/},float:{value:"float",label:"float",icon:"red/images/typedInput/09.png",validate:/^[+-]?[0-9]*\.?[0-9]*([eE][-+]?[0-9]+)?$/},suntime:{value:"suntime",label:"sun",icon:"red/images/typedInput/bool.png",options:["sunrise","sunset","sunriseEnd","sunsetStart","dawn","dusk","nauticalDawn","nauticalDusk","nightEnd","night","goldenHourEnd","goldenHour","solarNoon","nadir"]},time:{value:"time",defaultValue:"HH:MM[:SS]",label:"time",icon:"red/images/typedInput/time.png",validate:/^([0-9]|0[0-9]|1[0-9]|2[0-3])(:[0-5][0-9]){1,2}$/},array:{value:"array",label:"array",icon:"red/images/typedInput/array.png",validate:function(a){try{return JSON.parse(a),!0}catch(a){return!1}},expand:function(){var a=this,b=this.value();try{b=JSON.stringify(JSON.parse(b),null,4)}catch(a){}RED.editor.editJSON({value:b,complete:function(b){var c=b;try{c=JSON.stringify(JSON.parse(b))}catch(a){}a.value(c)}})}},struct:{value:"struct",label:"struct",icon:"red/images/typedInput/json.png",validate:function(a){try{return JSON.parse(a),!0}catch(a){return!1}},expand:function(){var a=this,b=this.value();try{b=JSON.stringify(JSON.parse(b),null,4)}catch(a){}RED.editor.editJSON({value:b,complete:function(b){var c=b;try{c=JSON.stringify(JSON.parse(b))}catch(a){}a.value(c)}})}}},c=!1;a.widget("nodered.typedInput",{_create:function(){if(!c&&RED&&RED._)for(var d in b)b.hasOwnProperty(d)&&(b[d].label=RED._("typedInput.type."+d,{defaultValue:b[d].label}));c=!0;var e=this;this.disarmClick=!1,this.element.addClass("red-ui-typedInput"),this.uiWidth=this.element.outerWidth(),this.elementDiv=this.element.wrap("<div>").parent().addClass("red-ui-typedInput-input"),this.uiSelect=this.elementDiv.wrap("<div>").parent();var f,g=this.element.attr("style");if(null!==(f=/width\s*:\s*(\d+(%|px))/i.exec(g))?(this.element.css("width","100%"),this.uiSelect.width(f[1]),this.uiWidth=null):this.uiSelect.width(this.uiWidth),["Right","Left"].forEach(function(a){var b=e.element.css("margin"+a);e.uiSelect.css("margin"+a,b),e.element.css("margin"+a,0)}),this.uiSelect.addClass("red-ui-typedInput-container"),this.options.types=this.options.types||Object.keys(b),this.selectTrigger=a('<button tabindex="0"></button>').prependTo(this.uiSelect),a('<i class="fa fa-sort-desc"></i>').appendTo(this.selectTrigger),this.selectLabel=a("<span></span>").appendTo(this.selectTrigger),this.types(this.options.types),this.options.typeField){this.typeField=a(this.options.typeField).hide();var h=this.typeField.val();h&&this.typeMap[h]&&(this.options.default=h)}else this.typeField=a("<input>",{type:"hidden"}).appendTo(this.uiSelect);this.element.on("focus",function(){e.uiSelect.addClass("red-ui-typedInput-focus")}),this.element.on("blur",function(){e.uiSelect.removeClass("red-ui-typedInput-focus")}),this.element.on("change",function(){e.validate()}),this.selectTrigger.click(function(a){a.preventDefault(),e._showTypeMenu()}),this.selectTrigger.on("keydown",function(a){40===a.keyCode&&e._showTypeMenu()}).on("focus",function(){e.uiSelect.addClass("red-ui-typedInput-focus")}),this.optionSelectTrigger=a('<button tabindex="0" class="red-ui-typedInput-option-trigger" style="display:inline-block"><span class="red-ui-typedInput-option-caret"><i class="fa fa-sort-desc"></i></span></button>').appendTo(this.uiSelect),this.optionSelectLabel=a('<span class="red-ui-typedInput-option-label"></span>').prependTo(this.optionSelectTrigger),this.optionSelectTrigger.click(function(a){a.preventDefault(),e._showOptionSelectMenu()}).on("keydown",function(a){40===a.keyCode&&e._showOptionSelectMenu()}).on("blur",function(){e.uiSelect.removeClass("red-ui-typedInput-focus")}).on("focus",function(){e.uiSelect.addClass("red-ui-typedInput-focus")}),this.optionExpandButton=a('<button tabindex="0" class="red-ui-typedInput-option-expand" style="display:inline-block"><i class="fa fa-ellipsis-h"></i></button>').appendTo(this.uiSelect),this.type(this.options.default||this.typeList[0].value)},_showTypeMenu:function(){this.typeList.length>1?(this._showMenu(this.menu,this.selectTrigger),this.menu.find("[value='"+this.propertyType+"']").focus()):this.element.focus()},_showOptionSelectMenu:function(){if(this.optionMenu){this.optionMenu.css({minWidth:this.optionSelectLabel.width()}),this._showMenu(this.optionMenu,this.optionSelectLabel);var a=this.optionMenu.find("[value='"+this.value()+"']");0===a.length&&(a=this.optionMenu.children(":first")),a.focus()}},_hideMenu:function(b){a(document).off("mousedown.close-property-select"),b.hide(),this.elementDiv.is(":visible")?this.element.focus():this.optionSelectTrigger.is(":visible")?this.optionSelectTrigger.focus():this.selectTrigger.focus()},_createMenu:function(b,c){var d=this,e=a("<div>").addClass("red-ui-typedInput-options");return b.forEach(function(b){"string"==typeof b&&(b={value:b,label:b});var f=a('<a href="#"></a>').attr("value",b.value).appendTo(e);b.label&&f.text(b.label),b.icon?a("<img>",{src:b.icon,style:"margin-right: 4px; height: 18px;"}).prependTo(f):f.css({paddingLeft:"18px"}),f.click(function(a){a.preventDefault(),c(b.value),d._hideMenu(e)})}),e.css({display:"none"}),e.appendTo(document.body),e.on("keydown",function(b){40===b.keyCode?a(this).children(":focus").next().focus():38===b.keyCode?a(this).children(":focus").prev().focus():27===b.keyCode&&d._hideMenu(e)}),e},_showMenu:function(b,c){if(this.disarmClick)return void(this.disarmClick=!1);var d=this,e=c.offset(),f=c.height(),g=b.height(),h=f+e.top-3;h+g>a(window).height()&&(h-=h+g-a(window).height()+5),b.css({top:h+"px",left:2+e.left+"px"}),b.slideDown(100),this._delay(function(){d.uiSelect.addClass("red-ui-typedInput-focus"),a(document).on("mousedown.close-property-select",function(e){a(e.target).closest(b).length||d._hideMenu(b),a(e.target).closest(c).length&&(d.disarmClick=!0,e.preventDefault())})})},_getLabelWidth:function(b){var c=b.outerWidth();if(0===c){var d=a('<div class="red-ui-typedInput-container"></div>').css({position:"absolute",top:0,left:-1e3}).appendTo(document.body),e=b.clone().appendTo(d);c=e.outerWidth(),d.remove()}return c},_resize:function(){if(null!==this.uiWidth&&this.uiSelect.width(this.uiWidth),this.typeMap[this.propertyType]&&this.typeMap[this.propertyType].hasValue===!1)this.selectTrigger.addClass("red-ui-typedInput-full-width");else{this.selectTrigger.removeClass("red-ui-typedInput-full-width");var a=this._getLabelWidth(this.selectTrigger);this.elementDiv.css("left",a+"px"),this.optionExpandButton.is(":visible")?this.elementDiv.css("right","22px"):this.elementDiv.css("right","0"),this.optionSelectTrigger&&this.optionSelectTrigger.css({left:a+"px",width:"calc( 100% - "+a+"px )"})}},_destroy:function(){this.menu.remove()},types:function(a){var c=this,d=this.type();this.typeMap={},this.typeList=a.map(function(a){var d;return d="string"==typeof a?b[a]:a,c.typeMap[d.value]=d,d}),this.selectTrigger.toggleClass("disabled",1===this.typeList.length),this.menu&&this.menu.remove(),this.menu=this._createMenu(this.typeList,function(a){c.type(a)}),d&&!this.typeMap.hasOwnProperty(d)&&this.type(this.typeList[0].value)},width:function(a){this.uiWidth=a,this._resize()},value:function(a){return arguments.length?(this.typeMap[this.propertyType].options&&(this.typeMap[this.propertyType].options.indexOf(a)===-1&&(a=""),this.optionSelectLabel.text(a)),this.element.val(a),this.element.trigger("change",this.type(),a),void 0):this.element.val()},type:function(b){if(!arguments.length)return this.propertyType;var c=this,d=this.typeMap[b];if(d&&this.propertyType!==b){this.propertyType=b,this.typeField.val(b),this.selectLabel.empty();var e;if(d.icon?(e=new Image,e.name=d.icon,e.src=d.icon,a("<img>",{src:d.icon,style:"margin-right: 4px;height: 18px;"}).prependTo(this.selectLabel)):this.selectLabel.text(d.label),d.options){if(this.optionExpandButton&&this.optionExpandButton.hide(),this.optionSelectTrigger){this.optionSelectTrigger.show(),this.elementDiv.hide(),this.optionMenu=this._createMenu(d.options,function(a){c.optionSelectLabel.text(a),c.value(a)});var f=this.element.val();d.options.indexOf(f)!==-1?this.optionSelectLabel.text(f):this.value(d.options[0])}}else{if(this.optionMenu&&(this.optionMenu.remove(),this.optionMenu=null),this.optionSelectTrigger&&this.optionSelectTrigger.hide(),d.hasValue===!1)this.oldValue=this.element.val(),this.element.val(""),this.elementDiv.hide();else{if(void 0!==this.oldValue)this.element.val(this.oldValue),delete this.oldValue;else if(d.defaultValue)if(this.element.val()){var g,h=d.validate;g="function"==typeof h?h(this.element.val()):h.test(this.element.val()),g||this.element.val(d.defaultValue)}else this.element.val(d.defaultValue);this.elementDiv.show()}d.expand&&"function"==typeof d.expand?(this.optionExpandButton.show(),this.optionExpandButton.off("click"),this.optionExpandButton.on("click",function(a){a.preventDefault(),d.expand.call(c)})):this.optionExpandButton.hide(),this.element.trigger("change",this.propertyType,this.value())}e?(e.onload=function(){c._resize()},e.onerror=function(){c._resize()}):this._resize()}},validate:function(){var a,b=this.value(),c=this.type();if(this.typeMap[c]&&this.typeMap[c].validate){var d=this.typeMap[c].validate;a="function"==typeof d?d(b):d.test(b)}else a=!0;return a?this.uiSelect.removeClass("input-error"):this.uiSelect.addClass("input-error"),a},show:function(){this.uiSelect.show(),this._resize()},hide:function(){this.uiSelect.hide()}})}(jQuery),RED.actions=function(){function a(a,b){f[a]=b}function b(a){delete f[a]}function c(a){return f[a]}function d(a){f.hasOwnProperty(a)&&f[a]()}function e(){var a=[];return Object.keys(f).forEach(function(b){var c=RED.keyboard.getShortcut(b);a.push({id:b,scope:c?c.scope:void 0,key:c?c.key:void 0,user:c?c.user:void 0})}),a}var f={};return{add:a,remove:b,get:c,invoke:d,list:e}}(),RED.deploy=function(){function a(a){a=a||{};var b=a.type||"default";if("default"==b)$('<li><span class="deploy-button-group button-group"><a id="btn-deploy" class="deploy-button disabled" href="#"><span class="deploy-button-content"><img id="btn-deploy-icon" src="red/images/deploy-full-o.png"> <span>'+RED._("deploy.deploy")+'</span></span><span class="deploy-button-spinner hide"><img src="red/images/spin.svg"/></span></a>').prependTo(".header-toolbar");else if("simple"==b){var c=a.label||RED._("deploy.deploy"),g="red/images/deploy-full-o.png";a.hasOwnProperty("icon")&&(g=a.icon),$('<li><span class="deploy-button-group button-group"><a id="btn-deploy" class="deploy-button disabled" href="#"><span class="deploy-button-content">'+(g?'<img id="btn-deploy-icon" src="'+g+'"> ':"")+"<span>"+c+'</span></span><span class="deploy-button-spinner hide"><img src="red/images/spin.svg"/></span></a></span></li>').prependTo(".header-toolbar")}$("#btn-deploy").click(function(a){a.preventDefault(),e()}),RED.actions.add("core:deploy-flows",e),$("#node-dialog-confirm-deploy").dialog({title:RED._("deploy.confirm.button.confirm"),modal:!0,autoOpen:!1,width:550,height:"auto",buttons:[{text:RED._("common.label.cancel"),click:function(){$(this).dialog("close")}},{id:"node-dialog-confirm-deploy-review",text:RED._("deploy.confirm.button.review"),class:"primary disabled",click:function(){$("#node-dialog-confirm-deploy-review").hasClass("disabled")||(RED.diff.showRemoteDiff(),$(this).dialog("close"))}},{id:"node-dialog-confirm-deploy-merge",text:RED._("deploy.confirm.button.merge"),class:"primary disabled",click:function(){RED.diff.mergeDiff(i),$(this).dialog("close")}},{id:"node-dialog-confirm-deploy-deploy",text:RED._("deploy.confirm.button.confirm"),class:"primary",click:function(){var a=$("#node-dialog-confirm-deploy-hide").prop("checked");a&&(f[$("#node-dialog-confirm-deploy-type").val()]=!0),e(!0,/conflict/.test($("#node-dialog-confirm-deploy-type").val())),$(this).dialog("close")}},{id:"node-dialog-confirm-deploy-overwrite",text:RED._("deploy.confirm.button.overwrite"),
 class:"primary",click:function(){e(!0,/conflict/.test($("#node-dialog-confirm-deploy-type").val())),$(this).dialog("close")}}],create:function(){$("#node-dialog-confirm-deploy").parent().find("div.ui-dialog-buttonpane").prepend('<div style="height:0; vertical-align: middle; display:inline-block; margin-top: 13px; float:left;"><input style="vertical-align:top;" type="checkbox" id="node-dialog-confirm-deploy-hide"><label style="display:inline;" for="node-dialog-confirm-deploy-hide"> do not warn about this again</label><input type="hidden" id="node-dialog-confirm-deploy-type"></div>')},open:function(){var a=$("#node-dialog-confirm-deploy-type").val();if(/conflict/.test(a)){$("#node-dialog-confirm-deploy").dialog("option","title",RED._("deploy.confirm.button.review")),$("#node-dialog-confirm-deploy-deploy").hide(),$("#node-dialog-confirm-deploy-review").addClass("disabled").show(),$("#node-dialog-confirm-deploy-merge").addClass("disabled").show(),$("#node-dialog-confirm-deploy-overwrite").toggle("deploy-conflict"===a),i=null,$("#node-dialog-confirm-deploy-conflict-checking").show(),$("#node-dialog-confirm-deploy-conflict-auto-merge").hide(),$("#node-dialog-confirm-deploy-conflict-manual-merge").hide();var b=Date.now();RED.diff.getRemoteDiff(function(a){var c=Math.max(1e3-(Date.now()-b),0);i=a,setTimeout(function(){$("#node-dialog-confirm-deploy-conflict-checking").hide();var b=Object.keys(a.conflicts);0===b.length?($("#node-dialog-confirm-deploy-conflict-auto-merge").show(),$("#node-dialog-confirm-deploy-merge").removeClass("disabled")):$("#node-dialog-confirm-deploy-conflict-manual-merge").show(),$("#node-dialog-confirm-deploy-review").removeClass("disabled")},c)}),$("#node-dialog-confirm-deploy-hide").parent().hide()}else $("#node-dialog-confirm-deploy").dialog("option","title",RED._("deploy.confirm.button.confirm")),$("#node-dialog-confirm-deploy-deploy").show(),$("#node-dialog-confirm-deploy-overwrite").hide(),$("#node-dialog-confirm-deploy-review").hide(),$("#node-dialog-confirm-deploy-merge").hide(),$("#node-dialog-confirm-deploy-hide").parent().show()}}),RED.events.on("nodes:change",function(a){a.dirty?(window.onbeforeunload=function(){return RED._("deploy.confirm.undeployedChanges")},$("#btn-deploy").removeClass("disabled")):(window.onbeforeunload=null,$("#btn-deploy").addClass("disabled"))});var j;RED.comms.subscribe("notification/runtime-deploy",function(a,b){if(!j){var c=RED.nodes.version();if(null===c||h||c===b.revision)return;var e=$("<div>"+RED._("deploy.confirm.backgroundUpdate")+'<br><br><div class="ui-dialog-buttonset"><button>'+RED._("deploy.confirm.button.ignore")+'</button><button class="primary">'+RED._("deploy.confirm.button.review")+"</button></div></div>");$(e.find("button")[0]).click(function(a){a.preventDefault(),j.close(),j=null}),$(e.find("button")[1]).click(function(a){a.preventDefault(),j.close();var b=RED.nodes.createCompleteNodeSet();d(b,!1),j=null}),j=RED.notify(e,null,!0)}})}function b(a){var b="";if(a.z){var c=RED.nodes.workspace(a.z);c?b=c.label:(c=RED.nodes.subflow(a.z),b=c.name)}var d=RED.utils.getNodeLabel(a,a.id);return{tab:b,type:a.type,label:d}}function c(a,b){return a.tab<b.tab?-1:a.tab>b.tab?1:a.type<b.type?-1:a.type>b.type?1:a.name<b.name?-1:a.name>b.name?1:0}function d(a,b){$("#node-dialog-confirm-deploy-config").hide(),$("#node-dialog-confirm-deploy-unknown").hide(),$("#node-dialog-confirm-deploy-unused").hide(),$("#node-dialog-confirm-deploy-conflict").show(),$("#node-dialog-confirm-deploy-type").val(b?"deploy-conflict":"background-conflict"),$("#node-dialog-confirm-deploy").dialog("open")}function e(a,e){if(!$("#btn-deploy").hasClass("disabled")){if(!a){var i=!1,j=!1,k=!1,l=[],m=[];RED.nodes.eachNode(function(a){j=j||!a.valid,a.valid||m.push(b(a)),"unknown"===a.type&&l.indexOf(a.name)==-1&&l.push(a.name)}),i=l.length>0;var n=[];RED.nodes.eachConfig(function(a){0===a.users.length&&a._def.hasUsers!==!1&&(n.push(b(a)),k=!0)}),$("#node-dialog-confirm-deploy-config").hide(),$("#node-dialog-confirm-deploy-unknown").hide(),$("#node-dialog-confirm-deploy-unused").hide(),$("#node-dialog-confirm-deploy-conflict").hide();var o=!1;if(i&&!f.unknown?(o=!0,$("#node-dialog-confirm-deploy-type").val("unknown"),$("#node-dialog-confirm-deploy-unknown").show(),$("#node-dialog-confirm-deploy-unknown-list").html("<li>"+l.join("</li><li>")+"</li>")):j&&!f.invalid?(o=!0,$("#node-dialog-confirm-deploy-type").val("invalid"),$("#node-dialog-confirm-deploy-config").show(),m.sort(c),$("#node-dialog-confirm-deploy-invalid-list").html("<li>"+m.map(function(a){return(a.tab?"["+a.tab+"] ":"")+a.label+" ("+a.type+")"}).join("</li><li>")+"</li>")):k&&!f.unusedConfig,o)return $("#node-dialog-confirm-deploy-hide").prop("checked",!1),void $("#node-dialog-confirm-deploy").dialog("open")}var p=RED.nodes.createCompleteNodeSet(),q=Date.now();$(".deploy-button-content").css("opacity",0),$(".deploy-button-spinner").show(),$("#btn-deploy").addClass("disabled");var r={flows:p};e||(r.rev=RED.nodes.version()),h=!0,$.ajax({url:"flows",type:"POST",data:JSON.stringify(r),contentType:"application/json; charset=utf-8",headers:{"Node-RED-Deployment-Type":g}}).done(function(a,b,c){RED.nodes.dirty(!1),RED.nodes.version(a.rev),RED.nodes.originalFlow(p),k?RED.notify("<p>"+RED._("deploy.successfulDeploy")+"</p><p>"+RED._("deploy.unusedConfigNodes")+' <a href="#" onclick="RED.sidebar.config.show(true); return false;">'+RED._("deploy.unusedConfigNodesLink")+"</a></p>","success",!1,6e3):RED.notify(RED._("deploy.successfulDeploy"),"success"),RED.nodes.eachNode(function(a){a.changed&&(a.dirty=!0,a.changed=!1),a.credentials&&delete a.credentials}),RED.nodes.eachConfig(function(a){a.changed=!1,a.credentials&&delete a.credentials}),RED.nodes.eachWorkspace(function(a){a.changed=!1}),RED.history.markAllDirty(),RED.view.redraw(),RED.events.emit("deploy")}).fail(function(a,b,c){RED.nodes.dirty(!0),$("#btn-deploy").removeClass("disabled"),401===a.status?RED.notify(RED._("deploy.deployFailed",{message:RED._("user.notAuthorized")}),"error"):409===a.status?d(p,!0):a.responseText?RED.notify(RED._("deploy.deployFailed",{message:a.responseText}),"error"):RED.notify(RED._("deploy.deployFailed",{message:RED._("deploy.errors.noResponse")}),"error")}).always(function(){h=!1;var a=Math.max(0,300-(Date.now()-q));setTimeout(function(){$(".deploy-button-content").css("opacity",1),$(".deploy-button-spinner").hide()},a)})}}var f={unknown:!1,unusedConfig:!1,invalid:!1},g="full",h=!1,i=null;return{init:a}}(),RED.diff=function(){function a(){RED.actions.add("core:show-remote-diff",j),RED.keyboard.add("*","ctrl-shift-r","core:show-remote-diff");var a=$('<div id="node-dialog-view-diff" class="hide"><div id="node-dialog-view-diff-headers"></div><ol id="node-dialog-view-diff-diff"></ol></div>').appendTo(document.body);$('<div class="node-diff-toolbar"><span><span id="node-diff-toolbar-resolved-conflicts"></span></span> </div>').prependTo(a);$("#node-dialog-view-diff").dialog({title:RED._("deploy.confirm.button.review"),modal:!0,autoOpen:!1,buttons:[{text:RED._("common.label.cancel"),click:function(){$(this).dialog("close")}},{id:"node-diff-view-diff-merge",text:RED._("deploy.confirm.button.merge"),class:"primary disabled",click:function(){$("#node-diff-view-diff-merge").hasClass("disabled")||(h(),o(p),$(this).dialog("close"))}}],open:function(){$(this).dialog({width:Math.min($(window).width(),900),height:Math.min($(window).height(),600)})}});$("#node-dialog-view-diff-diff").editableList({addButton:!1,scrollOnAdd:!1,addItem:function(a,b,d){var h=d.diff,i=d.remoteDiff,j=d.tab.n,k=d.def,l=p.conflicts,m=$("<div>",{class:"node-diff-tab"}).appendTo(a);m.addClass("collapsed");var n,o,q=$("<div>",{class:"node-diff-tab-title"}).appendTo(m),r=$("<div>").appendTo(m),s=$("<div>",{class:"node-diff-node-entry-cell"}).appendTo(q),t=$("<div>",{class:"node-diff-node-entry-cell node-diff-node-local"}).appendTo(q);i&&(n=$("<div>",{class:"node-diff-node-entry-cell node-diff-node-remote"}).appendTo(q)),$('<span class="node-diff-chevron"><i class="fa fa-angle-down"></i></span>').appendTo(s),c(j,k).appendTo(s);var u=(d.newTab||d.tab).n,v=$("<span>",{class:"node-diff-tab-title-meta"}).appendTo(s);"tab"===u.type?v.html(u.label||u.id):"subflow"===j.type?v.html(u.name||u.id):v.html("Global nodes");var w={local:{addedCount:0,deletedCount:0,changedCount:0,unchangedCount:0},remote:{addedCount:0,deletedCount:0,changedCount:0,unchangedCount:0},conflicts:0};if(d.newTab||d.remoteTab){var x,y={node:h.newConfig.all[j.id],all:h.newConfig.all,diff:h};if(i&&(x={node:i.newConfig.all[j.id]||null,all:i.newConfig.all,diff:i}),void 0!==j.type){var z=$("<div>",{class:"node-diff-node-entry node-diff-node-props collapsed"}).appendTo(r),A=$("<div>",{class:"node-diff-node-entry-header"}).appendTo(z),B=$("<div>",{class:"node-diff-node-entry-cell"}).appendTo(A),C=$("<div>",{class:"node-diff-node-entry-cell node-diff-node-local"}).appendTo(A),D=!1,E=!1;h.newConfig.all[j.id]?h.added[j.id]?(C.addClass("node-diff-node-added"),D=!0,$('<span class="node-diff-status"><i class="fa fa-plus-square"></i> <span data-i18n="diff.type.added"></span></span>').appendTo(C)):h.changed[j.id]?(C.addClass("node-diff-node-changed"),D=!0,$('<span class="node-diff-status"><i class="fa fa-square"></i> <span data-i18n="diff.type.changed"></span></span>').appendTo(C)):(C.addClass("node-diff-node-unchanged"),$('<span class="node-diff-status"><i class="fa fa-square-o"></i> <span data-i18n="diff.type.unchanged"></span></span>').appendTo(C)):C.addClass("node-diff-empty");var F;i&&(F=$("<div>",{class:"node-diff-node-entry-cell node-diff-node-remote"}).appendTo(A),i.newConfig.all[j.id]?i.added[j.id]?(F.addClass("node-diff-node-added"),E=!0,$('<span class="node-diff-status"><i class="fa fa-plus-square"></i> <span data-i18n="diff.type.added"></span></span>').appendTo(F)):i.changed[j.id]?(F.addClass("node-diff-node-changed"),E=!0,$('<span class="node-diff-status"><i class="fa fa-square"></i> <span data-i18n="diff.type.changed"></span></span>').appendTo(F)):(F.addClass("node-diff-node-unchanged"),$('<span class="node-diff-status"><i class="fa fa-square-o"></i> <span data-i18n="diff.type.unchanged"></span></span>').appendTo(F)):(F.addClass("node-diff-empty"),i.deleted[j.id]&&(E=!0))),$('<span class="node-diff-chevron"><i class="fa fa-angle-down"></i></span>').appendTo(B),$("<span>").html("Flow Properties").appendTo(B),A.click(function(a){a.preventDefault(),$(this).parent().toggleClass("collapsed")}),f(k,j,y,x,l).appendTo(z),o="",l[j.id]?(w.conflicts++,C.hasClass("node-diff-empty")||$('<span class="node-diff-node-conflict"><span class="node-diff-status"><i class="fa fa-exclamation"></i></span></span>').prependTo(C),F.hasClass("node-diff-empty")||$('<span class="node-diff-node-conflict"><span class="node-diff-status"><i class="fa fa-exclamation"></i></span></span>').prependTo(F),z.addClass("node-diff-node-entry-conflict")):o=p.resolutions[j.id],g(j,z,C,F,!0,!l[j.id],o)}}var G=0,H=0,I={};if(d.tab.nodes.forEach(function(a){I[a.id]=!0,e(a,w).appendTo(r)}),d.newTab&&(G=d.newTab.nodes.length,d.newTab.nodes.forEach(function(a){I[a.id]||(I[a.id]=!0,e(a,w).appendTo(r))})),d.remoteTab&&(H=d.remoteTab.nodes.length,d.remoteTab.nodes.forEach(function(a){I[a.id]||e(a,w).appendTo(r)})),q.click(function(a){q.parent().toggleClass("collapsed"),$(this).parent().hasClass("collapsed")&&($(this).parent().find(".node-diff-node-entry").addClass("collapsed"),$(this).parent().find(".debug-message-element").addClass("collapsed"))}),h.deleted[j.id])$('<span class="node-diff-node-deleted"><span class="node-diff-status"><i class="fa fa-minus-square"></i> <span data-i18n="diff.type.flowDeleted"></span></span></span>').appendTo(t);else if(d.newTab)if(h.added[j.id])$('<span class="node-diff-node-added"><span class="node-diff-status"><i class="fa fa-plus-square"></i> <span data-i18n="diff.type.flowAdded"></span></span></span>').appendTo(t);else{j.id&&(h.changed[j.id]?w.local.changedCount++:w.local.unchangedCount++);var J=$("<span>",{class:"node-diff-tab-stats"}).appendTo(t);$('<span class="node-diff-status"></span>').html(RED._("diff.nodeCount",{count:G})).appendTo(J),w.conflicts+w.local.addedCount+w.local.changedCount+w.local.deletedCount>0&&($('<span class="node-diff-status"> [ </span>').appendTo(J),w.conflicts>0&&$('<span class="node-diff-node-conflict"><span class="node-diff-status"><i class="fa fa-exclamation"></i> '+w.conflicts+"</span></span>").appendTo(J),w.local.addedCount>0&&$('<span class="node-diff-node-added"><span class="node-diff-status"><i class="fa fa-plus-square"></i> '+w.local.addedCount+"</span></span>").appendTo(J),w.local.changedCount>0&&$('<span class="node-diff-node-changed"><span class="node-diff-status"><i class="fa fa-square"></i> '+w.local.changedCount+"</span></span>").appendTo(J),w.local.deletedCount>0&&$('<span class="node-diff-node-deleted"><span class="node-diff-status"><i class="fa fa-minus-square"></i> '+w.local.deletedCount+"</span></span>").appendTo(J),$('<span class="node-diff-status"> ] </span>').appendTo(J))}else t.addClass("node-diff-empty");if(i){if(i.deleted[j.id])$('<span class="node-diff-node-deleted"><span class="node-diff-status"><i class="fa fa-minus-square"></i> <span data-i18n="diff.type.flowDeleted"></span></span></span>').appendTo(n);else if(d.remoteTab)if(i.added[j.id])$('<span class="node-diff-node-added"><span class="node-diff-status"><i class="fa fa-plus-square"></i> <span data-i18n="diff.type.flowAdded"></span></span></span>').appendTo(n);else{j.id&&(i.changed[j.id]?w.remote.changedCount++:w.remote.unchangedCount++);var K=$("<span>",{class:"node-diff-tab-stats"}).appendTo(n);$('<span class="node-diff-status"></span>').html(RED._("diff.nodeCount",{count:H})).appendTo(K),w.conflicts+w.remote.addedCount+w.remote.changedCount+w.remote.deletedCount>0&&($('<span class="node-diff-status"> [ </span>').appendTo(K),w.conflicts>0&&$('<span class="node-diff-node-conflict"><span class="node-diff-status"><i class="fa fa-exclamation"></i> '+w.conflicts+"</span></span>").appendTo(K),w.remote.addedCount>0&&$('<span class="node-diff-node-added"><span class="node-diff-status"><i class="fa fa-plus-square"></i> '+w.remote.addedCount+"</span></span>").appendTo(K),w.remote.changedCount>0&&$('<span class="node-diff-node-changed"><span class="node-diff-status"><i class="fa fa-square"></i> '+w.remote.changedCount+"</span></span>").appendTo(K),w.remote.deletedCount>0&&$('<span class="node-diff-node-deleted"><span class="node-diff-status"><i class="fa fa-minus-square"></i> '+w.remote.deletedCount+"</span></span>").appendTo(K),$('<span class="node-diff-status"> ] </span>').appendTo(K))}else n.addClass("node-diff-empty");if(o="",w.conflicts>0?q.addClass("node-diff-node-entry-conflict"):o=p.resolutions[j.id],j.id){var L=!(w.conflicts>0&&(h.deleted[j.id]||i.deleted[j.id]));g(j,q,t,n,!1,L,o)}}0===m.find(".node-diff-node-entry").length&&m.addClass("node-diff-tab-empty"),a.i18n()}})}function b(a,b){var c=$("<div>",{class:"node-diff-property-wires"}),e=$("<ol></ol>"),f=0;return a.forEach(function(a,c){var g=$("<li>").appendTo(e);if(a&&a.length>0){$("<span>").html(c+1).appendTo(g);var h=$("<ul>").appendTo(g);a.forEach(function(a){f++;var c=$("<li>").appendTo(h),e=b[a];if(e){var g=RED.nodes.getType(e.type)||{};d(e,g).appendTo(c)}else c.html(a)})}else g.html("none")}),0===f?c.html("none"):e.appendTo(c),c}function c(a,b){var c=$("<div>",{class:"node-diff-node-entry-node"}),d=b.color,e=RED.utils.getNodeIcon(b,a);"tab"===a.type&&(d="#C0DEED"),c.css("backgroundColor",d);var f=$("<div/>",{class:"palette_icon_container"}).appendTo(c);return $("<div/>",{class:"palette_icon",style:"background-image: url("+e+")"}).appendTo(f),c}function d(a,b){var d=$("<div>",{class:"node-diff-node-entry-title"});c(a,b).appendTo(d);var e=$("<div>",{class:"node-diff-node-description"}).appendTo(d),f=a.label||a.name||a.id;return $("<span>",{class:"node-diff-node-label"}).html(f).appendTo(e),d}function e(a,b){var c=p.localDiff,e=p.remoteDiff,h=p.conflicts[a.id],i=!1,j=!0,k=!1;c.added[a.id]&&(b.local.addedCount++,j=!1),e&&e.added[a.id]&&(b.remote.addedCount++,j=!1),c.deleted[a.id]&&(b.local.deletedCount++,j=!1),e&&e.deleted[a.id]&&(b.remote.deletedCount++,j=!1),c.changed[a.id]&&(b.local.changedCount++,i=!0,j=!1),e&&e.changed[a.id]&&(b.remote.changedCount++,i=!0,j=!1);var l=RED.nodes.getType(a.type);void 0===l&&(l=/^subflow:/.test(a.type)?{icon:"subflow.png",category:"subflows",color:"#da9",defaults:{name:{value:""}}}:{});var m,n=$("<div>",{class:"node-diff-node-entry collapsed"}),o=$("<div>",{class:"node-diff-node-entry-header"}).appendTo(n),q=$("<div>",{class:"node-diff-node-entry-cell"}).appendTo(o),r=$("<div>",{class:"node-diff-node-entry-cell node-diff-node-local"}).appendTo(o);if(e&&(m=$("<div>",{class:"node-diff-node-entry-cell node-diff-node-remote"}).appendTo(o)),$('<span class="node-diff-chevron"><i class="fa fa-angle-down"></i></span>').appendTo(q),j)b.local.unchangedCount++,d(a,l).appendTo(q),r.addClass("node-diff-node-unchanged"),$('<span class="node-diff-status"><i class="fa fa-square-o"></i> <span data-i18n="diff.type.unchanged"></span></span>').appendTo(r),e&&(b.remote.unchangedCount++,m.addClass("node-diff-node-unchanged"),$('<span class="node-diff-status"><i class="fa fa-square-o"></i> <span data-i18n="diff.type.unchanged"></span></span>').appendTo(m)),n.addClass("node-diff-node-unchanged");else if(c.added[a.id])r.addClass("node-diff-node-added"),m&&m.addClass("node-diff-empty"),$('<span class="node-diff-status"><i class="fa fa-plus-square"></i> <span data-i18n="diff.type.added"></span></span>').appendTo(r),d(a,l).appendTo(q);else if(e&&e.added[a.id])r.addClass("node-diff-empty"),m.addClass("node-diff-node-added"),$('<span class="node-diff-status"><i class="fa fa-plus-square"></i> <span data-i18n="diff.type.added"></span></span>').appendTo(m),d(a,l).appendTo(q);else{if(d(a,l).appendTo(q),c.moved[a.id]){var s=c.newConfig.all[a.id];if(c.deleted[a.z]||a.z===s.z||""===a.z||c.newConfig.all[a.z]){r.addClass("node-diff-node-moved");var t="";t=a.z===s.z?RED._("diff.type.movedFrom",{id:c.currentConfig.all[a.id].z||"global"}):RED._("diff.type.movedTo",{id:s.z||"global"}),$('<span class="node-diff-status"><i class="fa fa-caret-square-o-right"></i> '+t+"</span>").appendTo(r)}else r.addClass("node-diff-empty");k=!0}else c.deleted[a.z]?(r.addClass("node-diff-empty"),k=!0):c.deleted[a.id]?(r.addClass("node-diff-node-deleted"),$('<span class="node-diff-status"><i class="fa fa-minus-square"></i> <span data-i18n="diff.type.deleted"></span></span>').appendTo(r),k=!0):c.changed[a.id]?c.newConfig.all[a.id].z!==a.z?r.addClass("node-diff-empty"):(r.addClass("node-diff-node-changed"),$('<span class="node-diff-status"><i class="fa fa-square"></i> <span data-i18n="diff.type.changed"></span></span>').appendTo(r),k=!0):c.newConfig.all[a.id].z!==a.z?r.addClass("node-diff-empty"):(b.local.unchangedCount++,r.addClass("node-diff-node-unchanged"),$('<span class="node-diff-status"><i class="fa fa-square-o"></i> <span data-i18n="diff.type.unchanged"></span></span>').appendTo(r));if(e)if(e.moved[a.id]){var u=e.newConfig.all[a.id];if(e.deleted[a.z]||a.z===u.z||""===a.z||e.newConfig.all[a.z]){m.addClass("node-diff-node-moved");var v="";v=a.z===u.z?RED._("diff.type.movedFrom",{id:e.currentConfig.all[a.id].z||"global"}):RED._("diff.type.movedTo",{id:u.z||"global"}),$('<span class="node-diff-status"><i class="fa fa-caret-square-o-right"></i> '+v+"</span>").appendTo(m)}else m.addClass("node-diff-empty")}else e.deleted[a.z]?m.addClass("node-diff-empty"):e.deleted[a.id]?(m.addClass("node-diff-node-deleted"),$('<span class="node-diff-status"><i class="fa fa-minus-square"></i> <span data-i18n="diff.type.deleted"></span></span>').appendTo(m)):e.changed[a.id]?e.newConfig.all[a.id].z!==a.z?m.addClass("node-diff-empty"):(m.addClass("node-diff-node-changed"),$('<span class="node-diff-status"><i class="fa fa-square"></i> <span data-i18n="diff.type.changed"></span></span>').appendTo(m)):e.newConfig.all[a.id].z!==a.z?m.addClass("node-diff-empty"):(b.remote.unchangedCount++,m.addClass("node-diff-node-unchanged"),$('<span class="node-diff-status"><i class="fa fa-square-o"></i> <span data-i18n="diff.type.unchanged"></span></span>').appendTo(m))}var w,x={node:c.newConfig.all[a.id],all:c.newConfig.all,diff:c};e&&(w={node:e.newConfig.all[a.id]||null,all:e.newConfig.all,diff:e}),f(l,a,x,w).appendTo(n);var y="";return h?(b.conflicts++,r.hasClass("node-diff-empty")||$('<span class="node-diff-node-conflict"><span class="node-diff-status"><i class="fa fa-exclamation"></i></span></span>').prependTo(r),m.hasClass("node-diff-empty")||$('<span class="node-diff-node-conflict"><span class="node-diff-status"><i class="fa fa-exclamation"></i></span></span>').prependTo(m),n.addClass("node-diff-node-entry-conflict")):y=p.resolutions[a.id],g(a,n,r,m,!1,!h,y),o.click(function(a){$(this).parent().toggleClass("collapsed")}),n}function f(a,c,d,e){var f,g=d.node;e&&(f=e.node);var h,i,j,k,l,m,n=$("<div>",{class:"node-diff-node-entry-properties"}),o=$("<table>").appendTo(n),p=!1,q=!1,r=0,s=0,t=!1;h=$("<tr>").appendTo(o),$("<td>",{class:"node-diff-property-cell-label"}).html("id").appendTo(h),i=$("<td>",{class:"node-diff-property-cell node-diff-node-local"}).appendTo(h),g?(i.addClass("node-diff-node-unchanged"),$('<span class="node-diff-status"></span>').appendTo(i),RED.utils.createObjectElement(g.id).appendTo(i)):i.addClass("node-diff-empty"),void 0!==f&&(j=$("<td>",{class:"node-diff-property-cell node-diff-node-remote"}).appendTo(h),j.addClass("node-diff-node-unchanged"),f?($('<span class="node-diff-status"></span>').appendTo(j),RED.utils.createObjectElement(f.id).appendTo(j)):j.addClass("node-diff-empty")),c.hasOwnProperty("x")&&(g&&(g.x===c.x&&g.y===c.y||(p=!0,r++)),f&&(f.x===c.x&&f.y===c.y||(q=!0,s++)),(q&&p&&(g.x!==f.x||g.y!==f.y)||!p&&q&&d.diff.deleted[c.id]||p&&!q&&e.diff.deleted[c.id])&&(t=!0),h=$("<tr>").appendTo(o),$("<td>",{class:"node-diff-property-cell-label"}).html("position").appendTo(h),i=$("<td>",{class:"node-diff-property-cell node-diff-node-local"}).appendTo(h),g?(i.addClass("node-diff-node-"+(p?"changed":"unchanged")),$('<span class="node-diff-status">'+(p?'<i class="fa fa-square"></i>':"")+"</span>").appendTo(i),RED.utils.createObjectElement({x:g.x,y:g.y}).appendTo(i)):i.addClass("node-diff-empty"),void 0!==f&&(j=$("<td>",{class:"node-diff-property-cell node-diff-node-remote"}).appendTo(h),j.addClass("node-diff-node-"+(q?"changed":"unchanged")),f?($('<span class="node-diff-status">'+(q?'<i class="fa fa-square"></i>':"")+"</span>").appendTo(j),RED.utils.createObjectElement({x:f.x,y:f.y}).appendTo(j)):j.addClass("node-diff-empty"))),p=q=t=!1,c.hasOwnProperty("wires")&&(k=JSON.stringify(c.wires),g&&(l=JSON.stringify(g.wires),k!==l&&(p=!0,r++)),f&&(m=JSON.stringify(f.wires),k!==m&&(q=!0,s++)),(q&&p&&l!==m||!p&&q&&d.diff.deleted[c.id]||p&&!q&&e.diff.deleted[c.id])&&(t=!0),h=$("<tr>").appendTo(o),$("<td>",{class:"node-diff-property-cell-label"}).html("wires").appendTo(h),i=$("<td>",{class:"node-diff-property-cell node-diff-node-local"}).appendTo(h),g?(t?(i.addClass("node-diff-node-conflict"),$('<span class="node-diff-status"><i class="fa fa-exclamation"></i></span>').appendTo(i)):(i.addClass("node-diff-node-"+(p?"changed":"unchanged")),$('<span class="node-diff-status">'+(p?'<i class="fa fa-square"></i>':"")+"</span>").appendTo(i)),b(g.wires,d.all).appendTo(i)):i.addClass("node-diff-empty"),void 0!==f&&(j=$("<td>",{class:"node-diff-property-cell node-diff-node-remote"}).appendTo(h),f?(t?(j.addClass("node-diff-node-conflict"),$('<span class="node-diff-status"><i class="fa fa-exclamation"></i></span>').appendTo(j)):(j.addClass("node-diff-node-"+(q?"changed":"unchanged")),$('<span class="node-diff-status">'+(q?'<i class="fa fa-square"></i>':"")+"</span>").appendTo(j)),b(f.wires,e.all).appendTo(j)):j.addClass("node-diff-empty")));var u=Object.keys(c).filter(function(b){return!("z"==b||"wires"==b||"x"===b||"y"===b||"id"===b||"type"===b||a.defaults&&a.defaults.hasOwnProperty(b))});return a.defaults&&(u=u.concat(Object.keys(a.defaults))),u.forEach(function(a){p=!1,q=!1,t=!1,k=JSON.stringify(c[a]),g&&(l=JSON.stringify(g[a]),k!==l&&(p=!0,r++)),f&&(m=JSON.stringify(f[a]),k!==m&&(q=!0,s++)),(q&&p&&l!==m||!p&&q&&d.diff.deleted[c.id]||p&&!q&&e.diff.deleted[c.id])&&(t=!0),h=$("<tr>").appendTo(o),$("<td>",{class:"node-diff-property-cell-label"}).html(a).appendTo(h),i=$("<td>",{class:"node-diff-property-cell node-diff-node-local"}).appendTo(h),g?(t?(i.addClass("node-diff-node-conflict"),$('<span class="node-diff-status"><i class="fa fa-exclamation"></i></span>').appendTo(i)):(i.addClass("node-diff-node-"+(p?"changed":"unchanged")),$('<span class="node-diff-status">'+(p?'<i class="fa fa-square"></i>':"")+"</span>").appendTo(i)),RED.utils.createObjectElement(g[a]).appendTo(i)):i.addClass("node-diff-empty"),void 0!==f&&(j=$("<td>",{class:"node-diff-property-cell node-diff-node-remote"}).appendTo(h),f?(t?(j.addClass("node-diff-node-conflict"),$('<span class="node-diff-status"><i class="fa fa-exclamation"></i></span>').appendTo(j)):(j.addClass("node-diff-node-"+(q?"changed":"unchanged")),$('<span class="node-diff-status">'+(q?'<i class="fa fa-square"></i>':"")+"</span>").appendTo(j)),RED.utils.createObjectElement(f[a]).appendTo(j)):j.addClass("node-diff-empty"))}),n}function g(a,b,c,d,e,f,g){var i="node-diff-selectbox-"+a.id.replace(/\./g,"-")+(e?"-props":""),j="";(a.z||e)&&(j="node-diff-selectbox-tab-"+(e?a.id:a.z).replace(/\./g,"-"));var k=!e&&("tab"===a.type||"subflow"===a.type),l=function(c){var d;if(void 0===a.type);else if(k)d="node-diff-selectbox-tab-"+a.id.replace(/\./g,"-"),$("."+d+"-"+this.value).prop("checked",!0),"local"===this.value?($("."+d+"-"+this.value).closest(".node-diff-node-entry").addClass("node-diff-select-local"),$("."+d+"-"+this.value).closest(".node-diff-node-entry").removeClass("node-diff-select-remote")):($("."+d+"-"+this.value).closest(".node-diff-node-entry").removeClass("node-diff-select-local"),$("."+d+"-"+this.value).closest(".node-diff-node-entry").addClass("node-diff-select-remote"));else{var f="node-diff-selectbox-"+(e?a.id:a.z).replace(/\./g,"-");$("#"+f+"-local").prop("checked",!1),$("#"+f+"-remote").prop("checked",!1);var g=$("#"+f+"-local").closest(".node-diff-tab").find(".node-diff-tab-title");g.removeClass("node-diff-select-local"),g.removeClass("node-diff-select-remote")}"local"===this.value?(b.removeClass("node-diff-select-remote"),b.addClass("node-diff-select-local")):"remote"===this.value&&(b.addClass("node-diff-select-remote"),b.removeClass("node-diff-select-local")),h()},m=$("<label>",{class:"node-diff-selectbox",for:i+"-local"}).click(function(a){a.stopPropagation()}).appendTo(c),n=$("<input>",{id:i+"-local",type:"radio",value:"local",name:i,class:j+"-local"+(k?"":" node-diff-select-node")}).data("node-id",a.id).change(l).appendTo(m),o=$("<label>",{class:"node-diff-selectbox",for:i+"-remote"}).click(function(a){a.stopPropagation()}).appendTo(d),p=$("<input>",{id:i+"-remote",type:"radio",value:"remote",name:i,class:j+"-remote"+(k?"":" node-diff-select-node")}).data("node-id",a.id).change(l).appendTo(o);"local"===g?n.prop("checked",!0):"remote"===g&&p.prop("checked",!0),(f||c.hasClass("node-diff-empty")||d.hasClass("node-diff-empty"))&&(m.hide(),o.hide())}function h(){var a=0;$(".node-diff-selectbox>input:checked").each(function(){p.conflicts[$(this).data("node-id")]&&a++,p.resolutions[$(this).data("node-id")]=$(this).val()});var b=Object.keys(p.conflicts).length;b-a===0?$("#node-diff-toolbar-resolved-conflicts").html('<span class="node-diff-node-added"><span class="node-diff-status"><i class="fa fa-check"></i></span></span> '+RED._("diff.unresolvedCount",{count:b-a})):$("#node-diff-toolbar-resolved-conflicts").html('<span class="node-diff-node-conflict"><span class="node-diff-status"><i class="fa fa-exclamation"></i></span></span> '+RED._("diff.unresolvedCount",{count:b-a})),b===a&&$("#node-diff-view-diff-merge").removeClass("disabled")}function i(a){$.ajax({headers:{Accept:"application/json"},cache:!1,url:"flows",success:function(b){var c=RED.nodes.createCompleteNodeSet(),d=RED.nodes.originalFlow(),e=b.flows,f=l(d,c),g=l(d,e);g.rev=b.rev,a(m(f,g))}})}function j(a){void 0===a?i(j):n(a)}function k(a){var b=[],c={},d={},e=[],f={};return a.forEach(function(a){f[a.id]=a,"tab"===a.type?(b.push(a.id),c[a.id]={n:a,nodes:[]}):"subflow"===a.type&&(d[a.id]={n:a,nodes:[]})}),a.forEach(function(a){"tab"!==a.type&&"subflow"!==a.type&&(c[a.z]?c[a.z].nodes.push(a):d[a.z]?d[a.z].nodes.push(a):e.push(a))}),{all:f,tabOrder:b,tabs:c,subflows:d,globals:e}}function l(a,b){var c=k(a),d=k(b),e={},f={},g={},h={};return Object.keys(c.all).forEach(function(a){RED.nodes.workspace(a)||RED.nodes.subflow(a)||RED.nodes.node(a);d.all.hasOwnProperty(a)?JSON.stringify(c.all[a])!==JSON.stringify(d.all[a])&&(g[a]=!0,c.all[a].z!==d.all[a].z&&(h[a]=!0)):f[a]=!0}),Object.keys(d.all).forEach(function(a){c.all.hasOwnProperty(a)||(e[a]=!0)}),{currentConfig:c,newConfig:d,added:e,deleted:f,changed:g,moved:h}}function m(a,b){var c,d,e={},f={},g={localDiff:a,remoteDiff:b,conflicts:e,resolutions:f},h={};for(c in a.currentConfig.all)if(a.currentConfig.all.hasOwnProperty(c)){h[c]=!0;var i=a.newConfig.all[c];if(a.changed[c]&&b.deleted[c])e[c]=!0;else if(a.deleted[c]&&b.changed[c])e[c]=!0;else if(a.changed[c]&&b.changed[c]){var j=b.newConfig.all[c];JSON.stringify(i)!==JSON.stringify(j)&&(e[c]=!0)}e[c]||(b.added[c]||b.changed[c]||b.deleted[c]?f[c]="remote":f[c]="local")}for(c in a.added)a.added.hasOwnProperty(c)&&(d=a.newConfig.all[c],b.deleted[d.z]?e[c]=!0:f[c]="local");for(c in b.added)b.added.hasOwnProperty(c)&&(d=b.newConfig.all[c],a.deleted[d.z]?e[c]=!0:f[c]="remote");return g}function n(a){var b=a.localDiff,c=a.remoteDiff,d=a.conflicts;p=a;var e=$("#node-dialog-view-diff-diff");e.editableList("empty"),c?($("#node-diff-view-diff-merge").show(),0===Object.keys(d).length?$("#node-diff-view-diff-merge").removeClass("disabled"):$("#node-diff-view-diff-merge").addClass("disabled")):$("#node-diff-view-diff-merge").hide(),h(),$("#node-dialog-view-diff-headers").empty();var f=b.currentConfig,g=b.newConfig;d=d||{};var i={diff:b,def:{category:"config",color:"#f0f0f0"},tab:{n:{},nodes:f.globals},newTab:{n:{},nodes:g.globals}};void 0!==c?($("#node-dialog-view-diff").addClass("node-diff-three-way"),$('<div class="node-diff-node-entry-cell"></div><div class="node-diff-node-entry-cell" data-i18n="diff.local"></div><div class="node-diff-node-entry-cell" data-i18n="diff.remote"></div>').i18n().appendTo("#node-dialog-view-diff-headers"),i.remoteTab={n:{},nodes:c.newConfig.globals},i.remoteDiff=c):$("#node-dialog-view-diff").removeClass("node-diff-three-way"),e.editableList("addItem",i);var j={};f.tabOrder.forEach(function(a){var d=f.tabs[a],h={diff:b,def:{},tab:d};g.tabs.hasOwnProperty(a)&&(h.newTab=g.tabs[a]),void 0!==c&&(h.remoteTab=c.newConfig.tabs[a],h.remoteDiff=c),j[a]=!0,e.editableList("addItem",h)}),g.tabOrder.forEach(function(a){if(!j[a]){j[a]=!0;var d=g.tabs[a],f={diff:b,def:{},tab:d,newTab:d};void 0!==c&&(f.remoteDiff=c),e.editableList("addItem",f)}}),void 0!==c&&c.newConfig.tabOrder.forEach(function(a){if(!j[a]){var d=c.newConfig.tabs[a],f={diff:b,remoteDiff:c,def:{},tab:d,remoteTab:d};e.editableList("addItem",f)}});var k;for(k in f.subflows)f.subflows.hasOwnProperty(k)&&(j[k]=!0,i={diff:b,def:{defaults:{},icon:"subflow.png",category:"subflows",color:"#da9"},tab:f.subflows[k]},g.subflows.hasOwnProperty(k)&&(i.newTab=g.subflows[k]),void 0!==c&&(i.remoteTab=c.newConfig.subflows[k],i.remoteDiff=c),e.editableList("addItem",i));for(k in g.subflows)g.subflows.hasOwnProperty(k)&&!j[k]&&(j[k]=!0,i={diff:b,def:{defaults:{},icon:"subflow.png",category:"subflows",color:"#da9"},tab:g.subflows[k],newTab:g.subflows[k]},void 0!==c&&(i.remoteDiff=c),e.editableList("addItem",i));if(void 0!==c)for(k in c.newConfig.subflows)c.newConfig.subflows.hasOwnProperty(k)&&!j[k]&&(i={diff:b,remoteDiff:c,def:{defaults:{},icon:"subflow.png",category:"subflows",color:"#da9"
@@ -29,6 +29,9 @@ class User
 
     public function logout()
     {
+        //Homegear caches validated session IDs. Remove this one before the session is destroyed.
+        $hg = new \Homegear\Homegear();
+        $hg->invalidateSessionId(session_id());
         if (ini_get("session.use_cookies"))
         {
             $params = session_get_cookie_params();
@@ -976,6 +976,7 @@ std::string Server::handleGlobalCommand(std::string& command)
 			stringStream << "rpcservers (rpc)     Lists all active RPC servers" << std::endl;
 			stringStream << "rpcclients (rcl)     Lists all active RPC clients" << std::endl;
 			stringStream << "threads              Prints current thread count" << std::endl;
+			stringStream << "nodeeventcache       Prints size and eviction statistics of the node event cache" << std::endl;
 			stringStream << "lifetick (lt)        Checks the lifeticks of all components." << std::endl;
 			stringStream << "users [COMMAND]      Execute user commands. Type \"users help\" for more information." << std::endl;
 			stringStream << "families [COMMAND]   Execute device family commands. Type \"families help\" for more information." << std::endl;
@@ -1346,6 +1347,16 @@ std::string Server::handleGlobalCommand(std::string& command)
 			stringStream << GD::bl->threadManager.getCurrentThreadCount() << " of " << GD::bl->threadManager.getMaxThreadCount() << std::endl << "Maximum thread count since start: " << GD::bl->threadManager.getMaxRegisteredThreadCount() << std::endl;
 			return stringStream.str();
 		}
+		else if(command.compare(0, 14, "nodeeventcache") == 0)
+		{
+			BaseLib::PVariable info = GD::rpcClient->getNodeEventCacheInfo();
+			if(info->errorStruct) return "Error: " + info->structValue->at("faultString")->stringValue + "\n";
+			stringStream << "Nodes:     " << info->structValue->at("nodes")->integerValue64 << std::endl;
+			stringStream << "Topics:    " << info->structValue->at("topics")->integerValue64 << std::endl;
+			stringStream << "Size:      " << info->structValue->at("size")->integerValue64 << " of " << info->structValue->at("maxSize")->integerValue64 << " bytes" << std::endl;
+			stringStream << "Evictions: " << info->structValue->at("evictions")->integerValue64 << std::endl;
+			return stringStream.str();
+		}
 		else if(BaseLib::HelperFunctions::checkCliCommand(command, "lifetick", "lt", "", 2, arguments, showHelp))
 		{
 			int32_t exitCode = 0;
@@ -49,12 +49,25 @@ void EventHandler::dispose()
 {
 	if(_disposing) return;
 	_disposing = true;
+	{
+		std::lock_guard<std::mutex> eventsGuard(_eventsMutex);
+		_mainThreadConditionVariable.notify_all();
+	}
 	GD::bl->threadManager.join(_mainThread);
+	{
+		std::lock_guard<std::mutex> dirtyEventsGuard(_dirtyEventsMutex);
+		_saveStateConditionVariable.notify_all();
+	}
+	GD::bl->threadManager.join(_saveStateThread);
 	stopQueue(0);
+	flushStates();
 	_timedEvents.clear();
 	_triggeredEvents.clear();
 	_eventsToReset.clear();
 	_timesToReset.clear();
+	_timedEventTimes.clear();
+	_eventToResetTimes.clear();
+	_timeToResetTimes.clear();
 	_rpcDecoder.reset();
 	_rpcEncoder.reset();
 }
@@ -65,6 +78,7 @@ void EventHandler::init()
 	_rpcEncoder = std::unique_ptr<BaseLib::Rpc::RpcEncoder>(new BaseLib::Rpc::RpcEncoder(GD::bl.get(), false, true));
 
 	startQueue(0, false, GD::bl->settings.eventThreadCount(), GD::bl->settings.eventThreadPriority(), GD::bl->settings.eventThreadPolicy());
+	GD::bl->threadManager.start(_saveStateThread, true, &EventHandler::saveStateThread, this);
 }
 
 void EventHandler::mainThread()
@@ -73,102 +87,157 @@ void EventHandler::mainThread()
 	{
 		try
 		{
-			uint64_t currentTime = BaseLib::HelperFunctions::getTime();
 			if(!GD::rpcServers.begin()->second.isRunning())
 			{
 				std::this_thread::sleep_for(std::chrono::milliseconds(300));
 				continue;
 			}
-			_eventsMutex.lock();
-			if(!_timedEvents.empty() && _timedEvents.begin()->first <= currentTime)
+
+			std::vector<std::pair<std::shared_ptr<Event>, uint64_t>> timedEvents; //Event and next execution time (0 when the event is finished)
+			std::vector<std::shared_ptr<Event>> eventsToReset;
+			std::vector<std::shared_ptr<Event>> timesToReset;
+			uint64_t currentTime = BaseLib::HelperFunctions::getTime();
 			{
-				std::shared_ptr<Event> event = _timedEvents.begin()->second;
-				_eventsMutex.unlock();
+				std::unique_lock<std::mutex> eventsGuard(_eventsMutex);
+				uint64_t nextTime = 0;
+				if(!_timedEvents.empty()) nextTime = _timedEvents.begin()->first;
+				if(!_eventsToReset.empty() && (nextTime == 0 || _eventsToReset.begin()->first < nextTime)) nextTime = _eventsToReset.begin()->first;
+				if(!_timesToReset.empty() && (nextTime == 0 || _timesToReset.begin()->first < nextTime)) nextTime = _timesToReset.begin()->first;
+
+				if(nextTime > currentTime)
+				{
+					//Sleep until the next event is due. schedule() wakes us up when an earlier event is added. The wait is limited in case the system time changes.
+					uint64_t waitTime = nextTime - currentTime;
+					if(waitTime > (uint64_t)_maxMainThreadWait) waitTime = _maxMainThreadWait;
+					_mainThreadConditionVariable.wait_for(eventsGuard, std::chrono::milliseconds(waitTime));
+					continue;
+				}
+
+				//Collect all due events and unschedule them while still holding the lock. Unscheduling them later by ID would also remove
+				//entries scheduled again in the meantime (e.g. a reset rearmed by postTriggerTasks()). Recurring timed events are
+				//rescheduled right away, so events removed or replaced before this point are never recreated.
+				while(!_timedEvents.empty() && _timedEvents.begin()->first <= currentTime)
+				{
+					std::shared_ptr<Event> event = _timedEvents.begin()->second;
+					_timedEventTimes.erase(event->id);
+					_timedEvents.erase(_timedEvents.begin());
+					if(event->recurEvery == 0 || (event->endTime > 0 && currentTime >= event->endTime))
+					{
+						std::lock_guard<std::mutex> disposingGuard(event->disposingMutex);
+						event->disposing = true;
+						timedEvents.push_back(std::make_pair(event, 0));
+					}
+					else
+					{
+						uint64_t nextExecution = getNextExecution(event->eventTime, event->recurEvery);
+						//Never schedule the event for a time that was already processed, otherwise this loop would raise it again.
+						while(nextExecution <= currentTime) nextExecution += event->recurEvery;
+						schedule(_timedEvents, _timedEventTimes, nextExecution, event);
+						timedEvents.push_back(std::make_pair(event, nextExecution));
+					}
+				}
+				while(!_eventsToReset.empty() && _eventsToReset.begin()->first <= currentTime)
+				{
+					eventsToReset.push_back(_eventsToReset.begin()->second);
+					_eventToResetTimes.erase(_eventsToReset.begin()->second->id);
+					_eventsToReset.erase(_eventsToReset.begin());
+				}
+				while(!_timesToReset.empty() && _timesToReset.begin()->first <= currentTime)
+				{
+					timesToReset.push_back(_timesToReset.begin()->second);
+					_timeToResetTimes.erase(_timesToReset.begin()->second->id);
+					_timesToReset.erase(_timesToReset.begin());
+				}
+			}
+
+			for(auto& timedEvent : timedEvents)
+			{
+				std::shared_ptr<Event>& event = timedEvent.first;
 				if(event->enabled)
 				{
 					std::shared_ptr<BaseLib::IQueueEntry> queueEntry(new QueueEntry(event->name, event->eventMethod,  event->eventMethodParameters));
 					enqueue(0, queueEntry);
 					event->lastRaised = currentTime;
 				}
-				save(event);
-				if(event->recurEvery == 0 || (event->endTime > 0 && currentTime >= event->endTime))
+				if(timedEvent.second == 0)
 				{
 					GD::out.printInfo("Info: Removing event " + event->name + ", because the end time is reached.");
-					remove(event->name);
+					deleteEvent(event);
 				}
-				else if(event->recurEvery > 0)
+				else
 				{
-					uint64_t nextExecution = getNextExecution(event->eventTime, event->recurEvery);
-					_eventsMutex.lock();
-					if(event->enabled) GD::out.printInfo("Info: Next execution for event " + event->name + ": " + std::to_string(nextExecution));
-					//We don't call removeTimedEvents here, so we don't need to release the lock. Otherwise there is the possibility that the event
-					//is recreated after being deleted.
-					for(std::map<uint64_t, std::shared_ptr<Event>>::iterator i = _timedEvents.begin(); i != _timedEvents.end(); ++i)
+					saveState(event);
+					if(event->enabled)
 					{
-						if(i->second->id == event->id)
-						{
-							_timedEvents.erase(i);
-							break;
-						}
+						GD::out.printInfo("Info: Next execution for event " + event->name + ": " + std::to_string(timedEvent.second));
+						GD::rpcClient->broadcastUpdateEvent(event->name, (int32_t)event->type, event->peerID, event->peerChannel, event->variable);
 					}
-					while(_timedEvents.find(nextExecution) != _timedEvents.end()) nextExecution++;
-					_timedEvents[nextExecution] = event;
-					_eventsMutex.unlock();
-					if(event->enabled) GD::rpcClient->broadcastUpdateEvent(event->name, (int32_t)event->type, event->peerID, event->peerChannel, event->variable);
 				}
-				else removeTimedEvent(event->id);
 			}
-			else if(!_eventsToReset.empty() && _eventsToReset.begin()->first <= currentTime)
-			{
-				std::shared_ptr<Event> event = _eventsToReset.begin()->second;
-				_eventsMutex.unlock();
 
+			for(auto& event : eventsToReset)
+			{
+				if(event->disposing) continue;
 				GD::out.printInfo("Info: Resetting event " + event->name + ".");
 				std::shared_ptr<BaseLib::IQueueEntry> queueEntry(new QueueEntry(event->name, event->resetMethod, event->resetMethodParameters));
 				enqueue(0, queueEntry);
 				event->lastReset = currentTime;
-				removeEventToReset(event->id);
-				save(event);
+				saveState(event);
 				GD::rpcClient->broadcastUpdateEvent(event->name, (int32_t)event->type, event->peerID, event->peerChannel, event->variable);
 			}
-			else if(!_timesToReset.empty() && _timesToReset.begin()->first <= currentTime)
+
+			for(auto& event : timesToReset)
 			{
-				std::shared_ptr<Event> event = _timesToReset.begin()->second;
-				_eventsMutex.unlock();
+				if(event->disposing) continue;
 				GD::out.printInfo("Info: Resetting initial time for event " + event->name + ".");
-				removeTimeToReset(event->id);
 				event->lastReset = currentTime;
 				event->currentTime = 0;
-				save(event);
+				saveState(event);
 				GD::rpcClient->broadcastUpdateEvent(event->name, (int32_t)event->type, event->peerID, event->peerChannel, event->variable);
 			}
-			else
-			{
-				_eventsMutex.unlock();
-				std::this_thread::sleep_for(std::chrono::milliseconds(300));
-			}
 
 			std::lock_guard<std::mutex> mainThreadGuard(_mainThreadMutex);
 			if(_timedEvents.empty() && _eventsToReset.empty() && _timesToReset.empty()) _stopThread = true;
 		}
 		catch(const std::exception& ex)
 		{
-			_eventsMutex.unlock();
 			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
 		}
 		catch(BaseLib::Exception& ex)
 		{
-			_eventsMutex.unlock();
 			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
 		}
 		catch(...)
 		{
-			_eventsMutex.unlock();
 			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
 		}
 	}
 }
 
+void EventHandler::schedule(std::map<uint64_t, std::shared_ptr<Event>>& events, std::unordered_map<uint64_t, uint64_t>& eventTimes, uint64_t time, const std::shared_ptr<Event>& event)
+{
+	unschedule(events, eventTimes, event->id);
+	while(events.find(time) != events.end()) time++;
+	events[time] = event;
+	eventTimes[event->id] = time;
+	if(events.begin()->first == time) _mainThreadConditionVariable.notify_one();
+}
+
+std::shared_ptr<Event> EventHandler::unschedule(std::map<uint64_t, std::shared_ptr<Event>>& events, std::unordered_map<uint64_t, uint64_t>& eventTimes, uint64_t id)
+{
+	auto timeIterator = eventTimes.find(id);
+	if(timeIterator == eventTimes.end()) return std::shared_ptr<Event>();
+	std::shared_ptr<Event> event;
+	auto eventIterator = events.find(timeIterator->second);
+	if(eventIterator != events.end())
+	{
+		event = eventIterator->second;
+		events.erase(eventIterator);
+	}
+	eventTimes.erase(timeIterator);
+	return event;
+}
+
 BaseLib::PVariable EventHandler::add(BaseLib::PVariable eventDescription)
 {
 	try
@@ -251,9 +320,10 @@ BaseLib::PVariable EventHandler::add(BaseLib::PVariable eventDescription)
 					if(event->resetAfter == 0) return BaseLib::Variable::createError(-5, "RESETAFTER is not specified or 0.");
 				}
 			}
+			compileTrigger(event);
 			if(replace) remove(event->name);
 			std::lock_guard<std::mutex> eventsGuard(_eventsMutex);
-			_triggeredEvents[event->peerID][event->peerChannel][event->variable].push_back(event);
+			_triggeredEvents[TriggerKey(event->peerID, event->peerChannel, event->variable)].push_back(event);
 		}
 		else
 		{
@@ -269,8 +339,7 @@ BaseLib::PVariable EventHandler::add(BaseLib::PVariable eventDescription)
 			{
 				if(replace) remove(event->name);
 				std::lock_guard<std::mutex> eventsGuard(_eventsMutex);
-				while(_timedEvents.find(nextExecution) != _timedEvents.end()) nextExecution++;
-				_timedEvents[nextExecution] = event;
+				schedule(_timedEvents, _timedEventTimes, nextExecution, event);
 			}
 
 			std::lock_guard<std::mutex> mainThreadGuard(_mainThreadMutex);
@@ -317,25 +386,19 @@ BaseLib::PVariable EventHandler::list(int32_t type, uint64_t peerID, int32_t pee
 		}
 		if(type <= 0)
 		{
-			for(std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator iChannels = _triggeredEvents.begin(); iChannels != _triggeredEvents.end(); ++iChannels)
+			for(auto eventsIterator = _triggeredEvents.begin(); eventsIterator != _triggeredEvents.end(); ++eventsIterator)
 			{
-				for(std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator iVariables = iChannels->second.begin(); iVariables != iChannels->second.end(); ++iVariables)
+				for(std::vector<std::shared_ptr<Event>>::iterator iEvent = eventsIterator->second.begin(); iEvent != eventsIterator->second.end(); ++iEvent)
 				{
-					for(std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator iEvents = iVariables->second.begin(); iEvents != iVariables->second.end(); ++iEvents)
+					if(peerID == 0 && variable.empty()) events.push_back(*iEvent);
+					else if(peerID > 0)
 					{
-						for(std::vector<std::shared_ptr<Event>>::iterator iEvent = iEvents->second.begin(); iEvent != iEvents->second.end(); ++iEvent)
+						if((*iEvent)->peerID == peerID && (peerChannel == -1 || (*iEvent)->peerChannel == peerChannel))
 						{
-							if(peerID == 0 && variable.empty()) events.push_back(*iEvent);
-							else if(peerID > 0)
-							{
-								if((*iEvent)->peerID == peerID && (peerChannel == -1 || (*iEvent)->peerChannel == peerChannel))
-								{
-									if(variable.empty() || (*iEvent)->variable == variable) events.push_back(*iEvent);
-								}
-							}
-							else if(!variable.empty() && (*iEvent)->variable == variable) events.push_back(*iEvent);
+							if(variable.empty() || (*iEvent)->variable == variable) events.push_back(*iEvent);
 						}
 					}
+					else if(!variable.empty() && (*iEvent)->variable == variable) events.push_back(*iEvent);
 				}
 			}
 		}
@@ -481,47 +544,32 @@ BaseLib::PVariable EventHandler::remove(std::string name)
 				std::lock_guard<std::mutex> disposingGuard(event->disposingMutex);
 				event->disposing = true;
 				_timedEvents.erase(i);
+				_timedEventTimes.erase(event->id);
 				break;
 			}
 		}
 		if(!event)
 		{
-			for(std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator peerID = _triggeredEvents.begin(); peerID != _triggeredEvents.end(); ++peerID)
+			for(auto eventsIterator = _triggeredEvents.begin(); eventsIterator != _triggeredEvents.end(); ++eventsIterator)
 			{
-				for(std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator channel = peerID->second.begin(); channel != peerID->second.end(); ++channel)
+				for(std::vector<std::shared_ptr<Event>>::iterator currentEvent = eventsIterator->second.begin(); currentEvent != eventsIterator->second.end(); ++currentEvent)
 				{
-					for(std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator variable = channel->second.begin(); variable != channel->second.end(); ++variable)
+					if((*currentEvent)->name == name)
 					{
-						for(std::vector<std::shared_ptr<Event>>::iterator currentEvent = variable->second.begin(); currentEvent != variable->second.end(); ++currentEvent)
-						{
-							if((*currentEvent)->name == name)
-							{
-								event = *currentEvent;
-								_triggeredEvents[peerID->first][channel->first][variable->first].erase(currentEvent);
-								if(_triggeredEvents[peerID->first][channel->first][variable->first].empty()) _triggeredEvents[peerID->first][channel->first].erase(variable->first);
-								if(_triggeredEvents[peerID->first][channel->first].empty()) _triggeredEvents[peerID->first].erase(channel->first);
-								if(_triggeredEvents[peerID->first].empty()) _triggeredEvents.erase(peerID->first);
-								std::lock_guard<std::mutex> disposingGuard(event->disposingMutex);
-								event->disposing = true;
-								break;
-							}
-						}
+						event = *currentEvent;
+						eventsIterator->second.erase(currentEvent);
+						if(eventsIterator->second.empty()) _triggeredEvents.erase(eventsIterator);
+						std::lock_guard<std::mutex> disposingGuard(event->disposingMutex);
+						event->disposing = true;
+						break;
 					}
 				}
+				if(event) break;
 			}
 		}
 		_eventsMutex.unlock();
 		if(!event) return BaseLib::Variable::createError(-5, "Event not found.");
-		if(event && event->type == Event::Type::triggered)
-		{
-			removeEventToReset(event->id);
-			removeTimeToReset(event->id);
-		}
-
-		_databaseMutex.lock();
-		GD::bl->db->deleteEvent(name);
-		_databaseMutex.unlock();
-		GD::rpcClient->broadcastDeleteEvent(name, (int32_t)event->type, event->peerID, event->peerChannel, event->variable);
+		deleteEvent(event);
 		return BaseLib::PVariable(new BaseLib::Variable(BaseLib::VariableType::tVoid));
 	}
 	catch(const std::exception& ex)
@@ -558,20 +606,14 @@ BaseLib::PVariable EventHandler::enable(std::string name, bool enabled)
 		}
 		if(!event)
 		{
-			for(std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator iChannels = _triggeredEvents.begin(); iChannels != _triggeredEvents.end(); ++iChannels)
+			for(auto eventsIterator = _triggeredEvents.begin(); eventsIterator != _triggeredEvents.end(); ++eventsIterator)
 			{
-				for(std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator iVariables = iChannels->second.begin(); iVariables != iChannels->second.end(); ++iVariables)
+				for(std::vector<std::shared_ptr<Event>>::iterator iEvent = eventsIterator->second.begin(); iEvent != eventsIterator->second.end(); ++iEvent)
 				{
-					for(std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator iEvents = iVariables->second.begin(); iEvents != iVariables->second.end(); ++iEvents)
+					if((*iEvent)->name == name)
 					{
-						for(std::vector<std::shared_ptr<Event>>::iterator iEvent = iEvents->second.begin(); iEvent != iEvents->second.end(); ++iEvent)
-						{
-							if((*iEvent)->name == name)
-							{
-								event = *iEvent;
-								break;
-							}
-						}
+						event = *iEvent;
+						break;
 					}
 				}
 			}
@@ -623,20 +665,14 @@ BaseLib::PVariable EventHandler::abortReset(std::string name)
 		}
 		if(!event)
 		{
-			for(std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator iChannels = _triggeredEvents.begin(); iChannels != _triggeredEvents.end(); ++iChannels)
+			for(auto eventsIterator = _triggeredEvents.begin(); eventsIterator != _triggeredEvents.end(); ++eventsIterator)
 			{
-				for(std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator iVariables = iChannels->second.begin(); iVariables != iChannels->second.end(); ++iVariables)
+				for(std::vector<std::shared_ptr<Event>>::iterator iEvent = eventsIterator->second.begin(); iEvent != eventsIterator->second.end(); ++iEvent)
 				{
-					for(std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator iEvents = iVariables->second.begin(); iEvents != iVariables->second.end(); ++iEvents)
+					if((*iEvent)->name == name)
 					{
-						for(std::vector<std::shared_ptr<Event>>::iterator iEvent = iEvents->second.begin(); iEvent != iEvents->second.end(); ++iEvent)
-						{
-							if((*iEvent)->name == name)
-							{
-								event = *iEvent;
-								break;
-							}
-						}
+						event = *iEvent;
+						break;
 					}
 				}
 			}
@@ -783,15 +819,7 @@ void EventHandler::removeEventToReset(uint32_t id)
 	_eventsMutex.lock();
 	try
 	{
-		for(std::map<uint64_t, std::shared_ptr<Event>>::iterator i = _eventsToReset.begin(); i != _eventsToReset.end(); ++i)
-		{
-			if(i->second->id == id)
-			{
-				_eventsToReset.erase(i);
-				_eventsMutex.unlock();
-				return;
-			}
-		}
+		unschedule(_eventsToReset, _eventToResetTimes, id);
 	}
 	catch(const std::exception& ex)
     {
@@ -813,15 +841,7 @@ void EventHandler::removeTimeToReset(uint32_t id)
 	_eventsMutex.lock();
 	try
 	{
-		for(std::map<uint64_t, std::shared_ptr<Event>>::iterator i = _timesToReset.begin(); i != _timesToReset.end(); ++i)
-		{
-			if(i->second->id == id)
-			{
-				_timesToReset.erase(i);
-				_eventsMutex.unlock();
-				return;
-			}
-		}
+		unschedule(_timesToReset, _timeToResetTimes, id);
 	}
 	catch(const std::exception& ex)
     {
@@ -838,26 +858,25 @@ void EventHandler::removeTimeToReset(uint32_t id)
     _eventsMutex.unlock();
 }
 
-void EventHandler::removeTimedEvent(uint32_t id)
+void EventHandler::deleteEvent(std::shared_ptr<Event>& event)
 {
-	_eventsMutex.lock();
 	try
 	{
-		for(std::map<uint64_t, std::shared_ptr<Event>>::iterator i = _timedEvents.begin(); i != _timedEvents.end(); ++i)
 		{
-			if(i->second->id == id)
-			{
-				std::string name = i->second->name;
-				int32_t type = (int32_t)i->second->type;
-				uint64_t peerID = i->second->peerID;
-				int32_t peerChannel = i->second->peerChannel;
-				std::string variable = i->second->variable;
-				_timedEvents.erase(i); //erase invalidates the iterator.
-				_eventsMutex.unlock();
-				GD::rpcClient->broadcastDeleteEvent(name, type, peerID, peerChannel, variable);
-				return;
-			}
+			std::lock_guard<std::mutex> dirtyEventsGuard(_dirtyEventsMutex);
+			_dirtyEvents.erase(event->name);
 		}
+		if(event->type == Event::Type::triggered)
+		{
+			removeEventToReset(event->id);
+			removeTimeToReset(event->id);
+		}
+
+		{
+			std::lock_guard<std::mutex> databaseGuard(_databaseMutex);
+			GD::bl->db->deleteEvent(event->name);
+		}
+		GD::rpcClient->broadcastDeleteEvent(event->name, (int32_t)event->type, event->peerID, event->peerChannel, event->variable);
 	}
 	catch(const std::exception& ex)
     {
@@ -871,7 +890,6 @@ void EventHandler::removeTimedEvent(uint32_t id)
     {
     	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
     }
-    _eventsMutex.unlock();
 }
 
 bool EventHandler::eventExists(uint32_t id)
@@ -879,28 +897,19 @@ bool EventHandler::eventExists(uint32_t id)
 	_eventsMutex.lock();
 	try
 	{
-		for(std::map<uint64_t, std::shared_ptr<Event>>::iterator i = _timedEvents.begin(); i != _timedEvents.end(); ++i)
+		if(_timedEventTimes.find(id) != _timedEventTimes.end())
 		{
-			if(i->second->id == id)
-			{
-				_eventsMutex.unlock();
-				return true;
-			}
+			_eventsMutex.unlock();
+			return true;
 		}
-		for(std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator peerID = _triggeredEvents.begin(); peerID != _triggeredEvents.end(); ++peerID)
+		for(auto eventsIterator = _triggeredEvents.begin(); eventsIterator != _triggeredEvents.end(); ++eventsIterator)
 		{
-			for(std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator channel = peerID->second.begin(); channel != peerID->second.end(); ++channel)
+			for(std::vector<std::shared_ptr<Event>>::iterator event = eventsIterator->second.begin(); event != eventsIterator->second.end(); ++event)
 			{
-				for(std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator variable = channel->second.begin(); variable != channel->second.end(); ++variable)
+				if((*event)->id == id)
 				{
-					for(std::vector<std::shared_ptr<Event>>::iterator event = variable->second.begin(); event != variable->second.end(); ++event)
-					{
-						if((*event)->id == id)
-						{
-							_eventsMutex.unlock();
-							return true;
-						}
-					}
+					_eventsMutex.unlock();
+					return true;
 				}
 			}
 		}
@@ -934,20 +943,14 @@ bool EventHandler::eventExists(std::string name)
 				return true;
 			}
 		}
-		for(std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator peerID = _triggeredEvents.begin(); peerID != _triggeredEvents.end(); ++peerID)
+		for(auto eventsIterator = _triggeredEvents.begin(); eventsIterator != _triggeredEvents.end(); ++eventsIterator)
 		{
-			for(std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator channel = peerID->second.begin(); channel != peerID->second.end(); ++channel)
+			for(std::vector<std::shared_ptr<Event>>::iterator event = eventsIterator->second.begin(); event != eventsIterator->second.end(); ++event)
 			{
-				for(std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator variable = channel->second.begin(); variable != channel->second.end(); ++variable)
+				if((*event)->name == name)
 				{
-					for(std::vector<std::shared_ptr<Event>>::iterator event = variable->second.begin(); event != variable->second.end(); ++event)
-					{
-						if((*event)->name == name)
-						{
-							_eventsMutex.unlock();
-							return true;
-						}
-					}
+					_eventsMutex.unlock();
+					return true;
 				}
 			}
 		}
@@ -981,20 +984,14 @@ std::shared_ptr<Event> EventHandler::getEvent(std::string name)
 				return i->second;
 			}
 		}
-		for(std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator peerID = _triggeredEvents.begin(); peerID != _triggeredEvents.end(); ++peerID)
+		for(auto eventsIterator = _triggeredEvents.begin(); eventsIterator != _triggeredEvents.end(); ++eventsIterator)
 		{
-			for(std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator channel = peerID->second.begin(); channel != peerID->second.end(); ++channel)
+			for(std::vector<std::shared_ptr<Event>>::iterator event = eventsIterator->second.begin(); event != eventsIterator->second.end(); ++event)
 			{
-				for(std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator variable = channel->second.begin(); variable != channel->second.end(); ++variable)
+				if((*event)->name == name)
 				{
-					for(std::vector<std::shared_ptr<Event>>::iterator event = variable->second.begin(); event != variable->second.end(); ++event)
-					{
-						if((*event)->name == name)
-						{
-							_eventsMutex.unlock();
-							return (*event);
-						}
-					}
+					_eventsMutex.unlock();
+					return (*event);
 				}
 			}
 		}
@@ -1032,20 +1029,14 @@ BaseLib::PVariable EventHandler::trigger(std::string name)
 		}
 		if(!event)
 		{
-			for(std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator peerID = _triggeredEvents.begin(); peerID != _triggeredEvents.end(); ++peerID)
+			for(auto eventsIterator = _triggeredEvents.begin(); eventsIterator != _triggeredEvents.end(); ++eventsIterator)
 			{
-				for(std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator channel = peerID->second.begin(); channel != peerID->second.end(); ++channel)
+				for(std::vector<std::shared_ptr<Event>>::iterator currentEvent = eventsIterator->second.begin(); currentEvent != eventsIterator->second.end(); ++currentEvent)
 				{
-					for(std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator variable = channel->second.begin(); variable != channel->second.end(); ++variable)
+					if((*currentEvent)->name == name)
 					{
-						for(std::vector<std::shared_ptr<Event>>::iterator currentEvent = variable->second.begin(); currentEvent != variable->second.end(); ++currentEvent)
-						{
-							if((*currentEvent)->name == name)
-							{
-								event = *currentEvent;
-								break;
-							}
-						}
+						event = *currentEvent;
+						break;
 					}
 				}
 			}
@@ -1143,6 +1134,87 @@ void EventHandler::processRpcCall(std::string& eventName, std::string& eventMeth
     }
 }
 
+void EventHandler::compileTrigger(std::shared_ptr<Event>& event)
+{
+	try
+	{
+		BaseLib::PVariable triggerValue = event->triggerValue;
+		event->triggerCondition = std::function<bool(const BaseLib::PVariable&, const BaseLib::PVariable&)>();
+		switch(event->trigger)
+		{
+			//Comparison with previous value
+			case Event::Trigger::Enum::unchanged:
+				event->triggerName = "unchanged";
+				event->triggerCondition = [](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *lastValue == *value; };
+				break;
+			case Event::Trigger::Enum::changed:
+				event->triggerName = "changed";
+				event->triggerCondition = [](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *lastValue != *value; };
+				break;
+			case Event::Trigger::Enum::greater:
+				event->triggerName = "greater";
+				event->triggerCondition = [](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *lastValue > *value; };
+				break;
+			case Event::Trigger::Enum::less:
+				event->triggerName = "less";
+				event->triggerCondition = [](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *lastValue < *value; };
+				break;
+			case Event::Trigger::Enum::greaterOrUnchanged:
+				event->triggerName = "greaterOrUnchanged";
+				event->triggerCondition = [](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *lastValue >= *value; };
+				break;
+			case Event::Trigger::Enum::lessOrUnchanged:
+				event->triggerName = "lessOrUnchanged";
+				event->triggerCondition = [](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *lastValue <= *value; };
+				break;
+			case Event::Trigger::Enum::updated:
+				event->triggerName = "updated";
+				event->triggerCondition = [](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return true; };
+				break;
+			//Comparison with trigger value
+			case Event::Trigger::Enum::value:
+				event->triggerName = "value";
+				if(triggerValue) event->triggerCondition = [triggerValue](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *value == *triggerValue; };
+				break;
+			case Event::Trigger::Enum::notValue:
+				event->triggerName = "notValue";
+				if(triggerValue) event->triggerCondition = [triggerValue](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *value != *triggerValue; };
+				break;
+			case Event::Trigger::Enum::greaterThanValue:
+				event->triggerName = "greaterThanValue";
+				if(triggerValue) event->triggerCondition = [triggerValue](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *value > *triggerValue; };
+				break;
+			case Event::Trigger::Enum::lessThanValue:
+				event->triggerName = "lessThanValue";
+				if(triggerValue) event->triggerCondition = [triggerValue](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *value < *triggerValue; };
+				break;
+			case Event::Trigger::Enum::greaterOrEqualValue:
+				event->triggerName = "greaterOrEqualValue";
+				if(triggerValue) event->triggerCondition = [triggerValue](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *value >= *triggerValue; };
+				break;
+			case Event::Trigger::Enum::lessOrEqualValue:
+				event->triggerName = "lessOrEqualValue";
+				if(triggerValue) event->triggerCondition = [triggerValue](const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value) { return *value <= *triggerValue; };
+				break;
+			default:
+				event->triggerName = "none";
+				break;
+		}
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
 void EventHandler::processTriggerSingleVariable(uint64_t peerID, int32_t channel, std::string& variable, BaseLib::PVariable& value)
 {
 	try
@@ -1153,13 +1225,9 @@ void EventHandler::processTriggerSingleVariable(uint64_t peerID, int32_t channel
 
 		{
 			std::lock_guard<std::mutex> eventsGuard(_eventsMutex);
-			std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>>::iterator peerIterator = _triggeredEvents.find(peerID);
-			if(peerIterator == _triggeredEvents.end()) return;
-			std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>::iterator channelIterator = peerIterator->second.find(channel);
-			if(channelIterator == peerIterator->second.end()) return;
-			std::map<std::string, std::vector<std::shared_ptr<Event>>>::iterator variableIterator = channelIterator->second.find(variable);
-			if(variableIterator == channelIterator->second.end()) return;
-			for(std::vector<std::shared_ptr<Event>>::iterator i = variableIterator->second.begin(); i !=  variableIterator->second.end(); ++i)
+			auto eventsIterator = _triggeredEvents.find(TriggerKey(peerID, channel, variable));
+			if(eventsIterator == _triggeredEvents.end()) return;
+			for(std::vector<std::shared_ptr<Event>>::iterator i = eventsIterator->second.begin(); i != eventsIterator->second.end(); ++i)
 			{
 				//Don't raise the same event multiple times
 				if(!(*i)->enabled || ((*i)->lastValue && *((*i)->lastValue) == *value && currentTime - (*i)->lastRaised < 220)) continue;
@@ -1169,8 +1237,6 @@ void EventHandler::processTriggerSingleVariable(uint64_t peerID, int32_t channel
 
 		for(std::vector<std::shared_ptr<Event>>::iterator i = triggeredEvents.begin(); i !=  triggeredEvents.end(); ++i)
 		{
-			BaseLib::PVariable eventMethodParameters(new BaseLib::Variable());
-			*eventMethodParameters = *(*i)->eventMethodParameters;
 			BaseLib::PVariable result;
 			BaseLib::PVariable lastValue;
 
@@ -1179,127 +1245,14 @@ void EventHandler::processTriggerSingleVariable(uint64_t peerID, int32_t channel
 				lastValue = (*i)->lastValue;
 			}
 
-			if(((int32_t)(*i)->trigger) < 8)
-			{
-				//Comparison with previous value
-				if((*i)->trigger == Event::Trigger::updated)
-				{
-					GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"updated\"");
-					(*i)->lastRaised = currentTime;
-					result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-				}
-				else if((*i)->trigger == Event::Trigger::unchanged)
-				{
-					if(*lastValue == *value)
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"unchanged\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::changed)
-				{
-					if(*lastValue != *value)
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"changed\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::greater)
-				{
-					if(*lastValue > *value)
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"greater\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::less)
-				{
-					if(*lastValue < *value)
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"less\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::greaterOrUnchanged)
-				{
-					if(*lastValue >= *value)
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"greaterOrUnchanged\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::lessOrUnchanged)
-				{
-					if(*lastValue <= *value)
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"lessOrUnchanged\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-			}
-			else if((*i)->triggerValue)
+			if((*i)->triggerCondition && (*i)->triggerCondition(lastValue, value))
 			{
-				//Comparison with trigger value
-				if((*i)->trigger == Event::Trigger::value)
-				{
-					if(*value == *((*i)->triggerValue))
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"value\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::notValue)
-				{
-					if(*value != *((*i)->triggerValue))
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"notValue\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::greaterThanValue)
-				{
-					if(*value > *((*i)->triggerValue))
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"greaterThanValue\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::lessThanValue)
-				{
-					if(*value < *((*i)->triggerValue))
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"lessThanValue\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::greaterOrEqualValue)
-				{
-					if(*value >= *((*i)->triggerValue))
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"greaterOrEqualValue\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
-				else if((*i)->trigger == Event::Trigger::lessOrEqualValue)
-				{
-					if(*value <= *((*i)->triggerValue))
-					{
-						GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"lessOrEqualValue\"");
-						(*i)->lastRaised = currentTime;
-						result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
-					}
-				}
+				GD::out.printInfo("Info: Event \"" + (*i)->name + "\" raised for peer with id " + std::to_string(peerID) + ", channel " + std::to_string(channel) + " and variable \"" + variable + "\". Trigger: \"" + (*i)->triggerName + "\"");
+				(*i)->lastRaised = currentTime;
+				//The called method may modify its parameters, so only copy them when the event is actually raised.
+				BaseLib::PVariable eventMethodParameters(new BaseLib::Variable());
+				*eventMethodParameters = *(*i)->eventMethodParameters;
+				result = GD::rpcServers.begin()->second.callMethod((*i)->eventMethod, eventMethodParameters);
 			}
 
 			{
@@ -1340,6 +1293,7 @@ void EventHandler::postTriggerTasks(std::shared_ptr<Event>& event, BaseLib::PVar
 			GD::out.printError("Error: Could not execute RPC method for event from peer with id " + std::to_string(event->peerID) + ", channel " + std::to_string(event->peerChannel) + " and variable " + event->variable + ". Error struct:");
 			rpcResult->print(true, true);
 		}
+		bool factorChanged = false;
 		if(event->lastRaised >= currentTime && (event->resetAfter > 0 || event->initialTime > 0))
 		{
 			try
@@ -1350,30 +1304,29 @@ void EventHandler::postTriggerTasks(std::shared_ptr<Event>& event, BaseLib::PVar
 				{
 					GD::out.printInfo("Info: Event \"" + event->name + "\" for peer with id " + std::to_string(event->peerID) + ", channel " + std::to_string(event->peerChannel) + " and variable \"" + event->variable + "\" will be reset in " + std::to_string(event->resetAfter / 1000) + " seconds.");
 
-					_eventsMutex.lock();
-					while(_eventsToReset.find(resetTime) != _eventsToReset.end()) resetTime++;
-					_eventsToReset[resetTime] =  event;
-					_eventsMutex.unlock();
+					std::lock_guard<std::mutex> eventsGuard(_eventsMutex);
+					schedule(_eventsToReset, _eventToResetTimes, resetTime, event);
 				}
 				else //Complex reset
 				{
 					removeTimeToReset(event->id);
 					GD::out.printInfo("Info: INITIALTIME for event \"" + event->name + "\" will be reset in " + std::to_string(event->resetAfter / 1000)+ " seconds.");
-					_eventsMutex.lock();
-					while(_timesToReset.find(resetTime) != _timesToReset.end()) resetTime++;
-					_timesToReset[resetTime] = event;
-					_eventsMutex.unlock();
+					{
+						std::lock_guard<std::mutex> eventsGuard(_eventsMutex);
+						schedule(_timesToReset, _timeToResetTimes, resetTime, event);
+					}
 					if(event->currentTime == 0) event->currentTime = event->initialTime;
 					if(event->factor <= 0)
 					{
 						GD::out.printWarning("Warning: Factor is less or equal 0. Setting factor to 1. Event from peer with id " + std::to_string(event->peerID) + ", channel " + std::to_string(event->peerChannel) + " and variable " + event->variable + ".");
 						event->factor = 1;
+						factorChanged = true;
 					}
 					resetTime = currentTime + event->currentTime;
-					_eventsMutex.lock();
-					while(_eventsToReset.find(resetTime) != _eventsToReset.end()) resetTime++;
-					_eventsToReset[resetTime] =  event;
-					_eventsMutex.unlock();
+					{
+						std::lock_guard<std::mutex> eventsGuard(_eventsMutex);
+						schedule(_eventsToReset, _eventToResetTimes, resetTime, event);
+					}
 					GD::out.printInfo("Info: Event \"" + event->name + "\" will be reset in " + std::to_string(event->currentTime / 1000) + " seconds.");
 					if(event->operation == Event::Operation::Enum::addition)
 					{
@@ -1433,7 +1386,8 @@ void EventHandler::postTriggerTasks(std::shared_ptr<Event>& event, BaseLib::PVar
 				GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
 			}
 		}
-		save(event);
+		if(factorChanged) save(event);
+		else saveState(event);
 	}
 	catch(const std::exception& ex)
     {
@@ -1494,20 +1448,20 @@ void EventHandler::load()
 			if(event->eventTime > 0)
 			{
 				uint64_t nextExecution = getNextExecution(event->eventTime, event->recurEvery);
-				while(_timedEvents.find(nextExecution) != _timedEvents.end()) nextExecution++;
-				_timedEvents[nextExecution] = event;
+				schedule(_timedEvents, _timedEventTimes, nextExecution, event);
 			}
 			else
 			{
-				_triggeredEvents[event->peerID][event->peerChannel][event->variable].push_back(event);
+				compileTrigger(event);
+				_triggeredEvents[TriggerKey(event->peerID, event->peerChannel, event->variable)].push_back(event);
 				if(event->resetAfter > 0 && event->lastReset <= event->lastRaised)
 				{
 					if(event->initialTime > 0)
 					{
-						_eventsToReset[event->lastRaised + event->currentTime] = event;
-						_timesToReset[event->lastRaised + event->resetAfter] = event;
+						schedule(_eventsToReset, _eventToResetTimes, event->lastRaised + event->currentTime, event);
+						schedule(_timesToReset, _timeToResetTimes, event->lastRaised + event->resetAfter, event);
 					}
-					else _eventsToReset[event->lastRaised + event->resetAfter] = event;
+					else schedule(_eventsToReset, _eventToResetTimes, event->lastRaised + event->resetAfter, event);
 				}
 				else if(event->initialTime > 0) event->currentTime = 0;
 			}
@@ -1540,6 +1494,11 @@ void EventHandler::save(std::shared_ptr<Event> event)
 	{
 		//The eventExists is necessary so we don't safe an event that is being deleted
 		if(!event || _disposing) return;
+		{
+			//The full row includes the state, so there's no need to write it again.
+			std::lock_guard<std::mutex> dirtyEventsGuard(_dirtyEventsMutex);
+			_dirtyEvents.erase(event->name);
+		}
 		std::lock_guard<std::mutex> databaseGuard(_databaseMutex);
 		if(event->id > 0 && !eventExists(event->id)) return;
 		std::lock_guard<std::mutex> disposingGuard(event->disposingMutex);
@@ -1590,4 +1549,107 @@ void EventHandler::save(std::shared_ptr<Event> event)
     	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
     }
 }
+
+void EventHandler::saveState(std::shared_ptr<Event> event)
+{
+	try
+	{
+		if(!event || event->disposing || _disposing) return;
+		std::lock_guard<std::mutex> dirtyEventsGuard(_dirtyEventsMutex);
+		_dirtyEvents[event->name] = event;
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
+void EventHandler::flushStates()
+{
+	try
+	{
+		std::unordered_map<std::string, std::shared_ptr<Event>> dirtyEvents;
+		{
+			std::lock_guard<std::mutex> dirtyEventsGuard(_dirtyEventsMutex);
+			dirtyEvents.swap(_dirtyEvents);
+		}
+		if(dirtyEvents.empty()) return;
+		DatabaseController* db = dynamic_cast<DatabaseController*>(GD::bl->db.get());
+		if(!db) return;
+
+		std::lock_guard<std::mutex> databaseGuard(_databaseMutex);
+		//Write all states in one transaction, so SQLite only needs to sync once.
+		std::string savepointName = "eventStates";
+		db->createSavepointAsynchronous(savepointName);
+		for(auto& dirtyEvent : dirtyEvents)
+		{
+			std::shared_ptr<Event>& event = dirtyEvent.second;
+			BaseLib::PVariable lastValue;
+			{
+				std::lock_guard<std::mutex> eventsGuard(_eventsMutex);
+				lastValue = event->lastValue;
+			}
+			std::lock_guard<std::mutex> disposingGuard(event->disposingMutex);
+			if(event->disposing) continue;
+			BaseLib::Database::DataRow data;
+			std::vector<char> value;
+			_rpcEncoder->encodeResponse(lastValue, value);
+			data.push_back(std::shared_ptr<BaseLib::Database::DataColumn>(new BaseLib::Database::DataColumn(value)));
+			data.push_back(std::shared_ptr<BaseLib::Database::DataColumn>(new BaseLib::Database::DataColumn(event->lastRaised)));
+			data.push_back(std::shared_ptr<BaseLib::Database::DataColumn>(new BaseLib::Database::DataColumn(event->lastReset)));
+			data.push_back(std::shared_ptr<BaseLib::Database::DataColumn>(new BaseLib::Database::DataColumn(event->currentTime)));
+			data.push_back(std::shared_ptr<BaseLib::Database::DataColumn>(new BaseLib::Database::DataColumn(event->name)));
+			db->saveEventStateAsynchronous(data);
+		}
+		db->releaseSavepointAsynchronous(savepointName);
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
+void EventHandler::saveStateThread()
+{
+	while(!_disposing)
+	{
+		try
+		{
+			{
+				std::unique_lock<std::mutex> dirtyEventsGuard(_dirtyEventsMutex);
+				_saveStateConditionVariable.wait_for(dirtyEventsGuard, std::chrono::milliseconds(_saveStateInterval), [&] { return (bool)_disposing; });
+			}
+			if(_disposing) return;
+			flushStates();
+		}
+		catch(const std::exception& ex)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(BaseLib::Exception& ex)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(...)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+		}
+	}
+}
 #endif
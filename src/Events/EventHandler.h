@@ -39,9 +39,12 @@
 
 #include <memory>
 #include <string>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <condition_variable>
 
 class Event
 {
@@ -72,6 +75,12 @@ public:
 	std::string variable;
 	Trigger::Enum trigger = Trigger::Enum::none;
 	BaseLib::PVariable triggerValue;
+
+	// {{{ Compiled from "trigger" and "triggerValue" by EventHandler::compileTrigger()
+		std::string triggerName;
+		std::function<bool(const BaseLib::PVariable& lastValue, const BaseLib::PVariable& value)> triggerCondition;
+	// }}}
+
 	std::string eventMethod;
 	BaseLib::PVariable eventMethodParameters;
 	uint64_t resetAfter = 0;
@@ -158,32 +167,104 @@ protected:
 		// }}}
 	};
 
+	struct TriggerKey
+	{
+		uint64_t peerId = 0;
+		int32_t channel = -1;
+		std::string variable;
+
+		TriggerKey() {}
+		TriggerKey(uint64_t peerId, int32_t channel, const std::string& variable) : peerId(peerId), channel(channel), variable(variable) {}
+		bool operator==(const TriggerKey& other) const { return peerId == other.peerId && channel == other.channel && variable == other.variable; }
+	};
+
+	struct TriggerKeyHash
+	{
+		size_t operator()(const TriggerKey& key) const
+		{
+			size_t hash = std::hash<std::string>()(key.variable);
+			hash ^= std::hash<uint64_t>()(key.peerId) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			hash ^= std::hash<int32_t>()(key.channel) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			return hash;
+		}
+	};
+
 	std::atomic_bool _disposing;
 	std::mutex _eventsMutex;
 	std::map<uint64_t, std::shared_ptr<Event>> _timedEvents;
-	std::map<uint64_t, std::map<int32_t, std::map<std::string, std::vector<std::shared_ptr<Event>>>>> _triggeredEvents;
+	std::unordered_map<TriggerKey, std::vector<std::shared_ptr<Event>>, TriggerKeyHash> _triggeredEvents;
 	std::map<uint64_t, std::shared_ptr<Event>> _eventsToReset;
 	std::map<uint64_t, std::shared_ptr<Event>> _timesToReset;
+
+	// {{{ Event ID => key in _timedEvents, _eventsToReset and _timesToReset
+		std::unordered_map<uint64_t, uint64_t> _timedEventTimes;
+		std::unordered_map<uint64_t, uint64_t> _eventToResetTimes;
+		std::unordered_map<uint64_t, uint64_t> _timeToResetTimes;
+	// }}}
+
 	std::atomic_bool _stopThread;
 	std::thread _mainThread;
 	std::mutex _mainThreadMutex;
+	std::condition_variable _mainThreadConditionVariable;
+	const int64_t _maxMainThreadWait = 10000;
 	std::mutex _databaseMutex;
+
+	// {{{ Event state persistence
+		std::mutex _dirtyEventsMutex;
+		std::unordered_map<std::string, std::shared_ptr<Event>> _dirtyEvents;
+		std::condition_variable _saveStateConditionVariable;
+		std::thread _saveStateThread;
+		const int64_t _saveStateInterval = 10000;
+	// }}}
+
 	std::unique_ptr<BaseLib::Rpc::RpcDecoder> _rpcDecoder;
 	std::unique_ptr<BaseLib::Rpc::RpcEncoder> _rpcEncoder;
 
 	void processTriggerMultipleVariables(uint64_t peerID, int32_t channel, std::shared_ptr<std::vector<std::string>>& variables, std::shared_ptr<std::vector<BaseLib::PVariable>>& values);
 	void processTriggerSingleVariable(uint64_t peerID, int32_t channel, std::string& variable, BaseLib::PVariable& value);
 	void processRpcCall(std::string& eventName, std::string& eventMethod, BaseLib::PVariable& eventMethodParameters);
+
+	/**
+	 * Sets "triggerName" and "triggerCondition" of a triggered event, so the trigger doesn't need to be evaluated by comparing enum values on every value change. Needs to be called whenever "trigger" or "triggerValue" change.
+	 */
+	void compileTrigger(std::shared_ptr<Event>& event);
 	void mainThread();
+
+	/**
+	 * Inserts an event into one of the time ordered maps and replaces the event's previous entry. Wakes up the main thread when the event is due before all others. _eventsMutex must be locked.
+	 */
+	void schedule(std::map<uint64_t, std::shared_ptr<Event>>& events, std::unordered_map<uint64_t, uint64_t>& eventTimes, uint64_t time, const std::shared_ptr<Event>& event);
+
+	/**
+	 * Removes an event from one of the time ordered maps. _eventsMutex must be locked.
+	 *
+	 * @return Returns the removed event or nullptr if the event wasn't scheduled.
+	 */
+	std::shared_ptr<Event> unschedule(std::map<uint64_t, std::shared_ptr<Event>>& events, std::unordered_map<uint64_t, uint64_t>& eventTimes, uint64_t id);
 	uint64_t getNextExecution(uint64_t startTime, uint64_t recurEvery);
 	void removeEventToReset(uint32_t id);
 	void removeTimeToReset(uint32_t id);
-	void removeTimedEvent(uint32_t id);
+
+	/**
+	 * Deletes an event from the database and informs the RPC clients. The event must already be removed from the event maps and be marked as disposing.
+	 */
+	void deleteEvent(std::shared_ptr<Event>& event);
 	BaseLib::PVariable getEventDescription(std::shared_ptr<Event> event);
 	bool eventExists(uint32_t id);
 	bool eventExists(std::string name);
 	std::shared_ptr<Event> getEvent(std::string name);
 	void save(std::shared_ptr<Event>);
+
+	/**
+	 * Marks the state of an event (lastValue, lastRaised, lastReset and currentTime) as changed. Changed states are written to the database by saveStateThread() in one transaction every _saveStateInterval milliseconds. Use save() when any other field of the event changed.
+	 */
+	void saveState(std::shared_ptr<Event> event);
+
+	/**
+	 * Writes all changed event states to the database.
+	 */
+	void flushStates();
+	void saveStateThread();
 	void postTriggerTasks(std::shared_ptr<Event>& event, BaseLib::PVariable& rpcResult, uint64_t currentTime);
 	void processQueueEntry(int32_t index, std::shared_ptr<BaseLib::IQueueEntry>& entry);
 };
@@ -48,6 +48,11 @@ public:
 
 	std::unordered_map<std::string, PNodeInfo> nodes;
 
+	// {{{ Load
+		std::atomic<uint64_t> messageCount{0};
+		std::atomic<uint64_t> cpuTime{0}; //In microseconds
+	// }}}
+
 	FlowInfoClient() {}
 	virtual ~FlowInfoClient() {}
 protected:
@@ -52,6 +52,13 @@ public:
 		int32_t exitCode = -1;
 	// }}}
 
+	// {{{ Load
+		double load = 0; //Estimated CPU load in cores
+		int64_t loadTime = 0;
+		int64_t cpuTime = 0;
+		int64_t messageCount = 0;
+	// }}}
+
 	FlowInfoServer() {}
 	virtual ~FlowInfoServer() {}
 protected:
@@ -41,6 +41,8 @@ FlowsClient::FlowsClient() : IQueue(GD::bl.get(), 3, 1000)
 	_disposed = false;
 	_shuttingDown = false;
 	_frontendConnected = false;
+	_stopNodeEventsThread = false;
+	_nodeEvents = std::make_shared<Flows::Array>();
 
 	_fileDescriptor = std::shared_ptr<BaseLib::FileDescriptor>(new BaseLib::FileDescriptor);
 	_out.init(GD::bl.get());
@@ -63,6 +65,8 @@ FlowsClient::FlowsClient() : IQueue(GD::bl.get(), 3, 1000)
 	_localRpcMethods.emplace("stopNodes", std::bind(&FlowsClient::stopNodes, this, std::placeholders::_1));
 	_localRpcMethods.emplace("stopFlow", std::bind(&FlowsClient::stopFlow, this, std::placeholders::_1));
 	_localRpcMethods.emplace("flowCount", std::bind(&FlowsClient::flowCount, this, std::placeholders::_1));
+	_localRpcMethods.emplace("getLoad", std::bind(&FlowsClient::getLoad, this, std::placeholders::_1));
+	_localRpcMethods.emplace("preloadNodes", std::bind(&FlowsClient::preloadNodes, this, std::placeholders::_1));
 	_localRpcMethods.emplace("nodeOutput", std::bind(&FlowsClient::nodeOutput, this, std::placeholders::_1));
 	_localRpcMethods.emplace("invokeNodeMethod", std::bind(&FlowsClient::invokeExternalNodeMethod, this, std::placeholders::_1));
 	_localRpcMethods.emplace("executePhpNodeBaseMethod", std::bind(&FlowsClient::executePhpNodeBaseMethod, this, std::placeholders::_1));
@@ -109,6 +113,10 @@ void FlowsClient::dispose()
 		GD::bl->shuttingDown = true;
 		_stopped = true;
 
+		_stopNodeEventsThread = true;
+		_nodeEventsConditionVariable.notify_all();
+		if(_nodeEventsThread.joinable()) _nodeEventsThread.join();
+
 		stopQueue(0);
 		stopQueue(1);
 		stopQueue(2);
@@ -139,6 +147,10 @@ void FlowsClient::dispose()
 		}
 
 		_flows.clear();
+		{
+			std::lock_guard<std::mutex> nodeMailboxesGuard(_nodeMailboxesMutex);
+			_nodeMailboxes.clear();
+		}
 		_rpcResponses.clear();
 
 		_out.printMessage("Shut down complete.");
@@ -177,6 +189,10 @@ void FlowsClient::start()
 		startQueue(1, false, flowsProcessingThreadCountNodes, 0, SCHED_OTHER);
 		startQueue(2, false, flowsProcessingThreadCountNodes, 0, SCHED_OTHER);
 
+		_stopNodeEventsThread = false;
+		if(_nodeEventsThread.joinable()) _nodeEventsThread.join();
+		_nodeEventsThread = std::thread(&FlowsClient::nodeEventsThread, this);
+
 		_socketPath = GD::bl->settings.socketPath() + "homegearFE.sock";
 		if(GD::bl->debugLevel >= 5) _out.printDebug("Debug: Socket path is " + _socketPath);
 		for(int32_t i = 0; i < 2; i++)
@@ -405,20 +421,101 @@ void FlowsClient::processQueueEntry(int32_t index, std::shared_ptr<BaseLib::IQue
 		}
 		else //Node output
 		{
-			if(!queueEntry->nodeInfo || !queueEntry->message || _shuttingDown) return;
-			Flows::PINode node = _nodeManager->getNode(queueEntry->nodeInfo->id);
-			if(node)
+			processNodeMailbox(queueEntry);
+		}
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
+void FlowsClient::processNodeMailbox(std::shared_ptr<QueueEntry>& queueEntry)
+{
+	try
+	{
+		PNodeMailbox& mailbox = queueEntry->mailbox;
+		if(!mailbox) return;
+
+		while(true)
+		{
+			//Process a limited number of inputs per run and then requeue the mailbox, so busy nodes can't starve the others.
+			for(uint32_t i = 0; i < _nodeInputsPerRun; i++)
+			{
+				NodeInput nodeInput;
+				{
+					std::lock_guard<std::mutex> mailboxGuard(mailbox->mutex);
+					if(mailbox->inputs.empty() || _shuttingDown)
+					{
+						mailbox->inputs.clear();
+						mailbox->scheduled = false;
+						return;
+					}
+					nodeInput = std::move(mailbox->inputs.front());
+					mailbox->inputs.pop_front();
+				}
+
+				if(!nodeInput.nodeInfo || !nodeInput.message) continue;
+				Flows::PINode node = _nodeManager->getNode(nodeInput.nodeInfo->id);
+				if(node)
+				{
+					if(_frontendConnected && GD::bl->settings.nodeBlueDebugOutput() && BaseLib::HelperFunctions::getTime() - nodeInput.nodeInfo->lastNodeEvent1 >= 200)
+					{
+						nodeInput.nodeInfo->lastNodeEvent1 = BaseLib::HelperFunctions::getTime();
+						Flows::PVariable timeout = std::make_shared<Flows::Variable>(Flows::VariableType::tStruct);
+						timeout->structValue->emplace("timeout", std::make_shared<Flows::Variable>(500));
+						nodeEvent(nodeInput.nodeInfo->id, "highlightNode/" + nodeInput.nodeInfo->id, timeout);
+					}
+					if(nodeInput.flow)
+					{
+						//Used by the flows server to place flows by load. Only one in _cpuTimeSampleInterval messages is timed and the measured time is scaled accordingly.
+						if(nodeInput.flow->messageCount++ % _cpuTimeSampleInterval == 0)
+						{
+							timespec startTime{};
+							timespec endTime{};
+							clock_gettime(CLOCK_THREAD_CPUTIME_ID, &startTime);
+							{
+								std::lock_guard<std::mutex> nodeInputGuard(node->getInputMutex());
+								node->input(nodeInput.nodeInfo, nodeInput.targetPort, nodeInput.message);
+							}
+							clock_gettime(CLOCK_THREAD_CPUTIME_ID, &endTime);
+							int64_t cpuTime = ((int64_t)endTime.tv_sec - (int64_t)startTime.tv_sec) * 1000000 + ((int64_t)endTime.tv_nsec - (int64_t)startTime.tv_nsec) / 1000;
+							if(cpuTime > 0) nodeInput.flow->cpuTime += cpuTime * _cpuTimeSampleInterval;
+						}
+						else
+						{
+							std::lock_guard<std::mutex> nodeInputGuard(node->getInputMutex());
+							node->input(nodeInput.nodeInfo, nodeInput.targetPort, nodeInput.message);
+						}
+					}
+					else
+					{
+						std::lock_guard<std::mutex> nodeInputGuard(node->getInputMutex());
+						node->input(nodeInput.nodeInfo, nodeInput.targetPort, nodeInput.message);
+					}
+				}
+			}
+
 			{
-				if(_frontendConnected && GD::bl->settings.nodeBlueDebugOutput() && BaseLib::HelperFunctions::getTime() - queueEntry->nodeInfo->lastNodeEvent1 >= 200)
+				std::lock_guard<std::mutex> mailboxGuard(mailbox->mutex);
+				if(mailbox->inputs.empty() || _shuttingDown)
 				{
-					queueEntry->nodeInfo->lastNodeEvent1 = BaseLib::HelperFunctions::getTime();
-					Flows::PVariable timeout = std::make_shared<Flows::Variable>(Flows::VariableType::tStruct);
-					timeout->structValue->emplace("timeout", std::make_shared<Flows::Variable>(500));
-					nodeEvent(queueEntry->nodeInfo->id, "highlightNode/" + queueEntry->nodeInfo->id, timeout);
+					mailbox->scheduled = false;
+					return;
 				}
-				std::lock_guard<std::mutex> nodeInputGuard(node->getInputMutex());
-				node->input(queueEntry->nodeInfo, queueEntry->targetPort, queueEntry->message);
 			}
+
+			//If the queue is full, keep processing in this thread, so the mailbox doesn't stay scheduled without being processed.
+			std::shared_ptr<BaseLib::IQueueEntry> entry = queueEntry;
+			if(enqueue(2, entry)) return;
 		}
 	}
 	catch(const std::exception& ex)
@@ -433,6 +530,20 @@ void FlowsClient::processQueueEntry(int32_t index, std::shared_ptr<BaseLib::IQue
     {
     	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
     }
+
+	//Only reached on exceptions. Make sure the remaining inputs are still processed.
+	if(!queueEntry->mailbox) return;
+	std::lock_guard<std::mutex> mailboxGuard(queueEntry->mailbox->mutex);
+	std::shared_ptr<BaseLib::IQueueEntry> entry = queueEntry;
+	queueEntry->mailbox->scheduled = !queueEntry->mailbox->inputs.empty() && !_shuttingDown && enqueue(2, entry);
+}
+
+FlowsClient::PNodeMailbox FlowsClient::getNodeMailbox(const std::string& nodeId)
+{
+	std::lock_guard<std::mutex> nodeMailboxesGuard(_nodeMailboxesMutex);
+	PNodeMailbox& mailbox = _nodeMailboxes[nodeId];
+	if(!mailbox) mailbox = std::make_shared<NodeMailbox>();
+	return mailbox;
 }
 
 Flows::PVariable FlowsClient::send(std::vector<char>& data)
@@ -660,6 +771,13 @@ void FlowsClient::unsubscribePeer(std::string nodeId, uint64_t peerId, int32_t c
     }
 }
 
+Flows::PVariable FlowsClient::copyMessage(const Flows::PVariable& message)
+{
+	Flows::PVariable copy = std::make_shared<Flows::Variable>(Flows::VariableType::tStruct);
+	if(message->type == Flows::VariableType::tStruct) *copy->structValue = *message->structValue;
+	return copy;
+}
+
 void FlowsClient::queueOutput(std::string nodeId, uint32_t index, Flows::PVariable message)
 {
 	try
@@ -674,26 +792,55 @@ void FlowsClient::queueOutput(std::string nodeId, uint32_t index, Flows::PVariab
 			nodeInfo = nodesIterator->second;
 		}
 
-		if(message->structValue->find("payload") == message->structValue->end()) message->structValue->emplace("payload", std::make_shared<Flows::Variable>());
-
 		if(index >= nodeInfo->wiresOut.size())
 		{
 			_out.printError("Error: " + nodeId + " has no output with index " + std::to_string(index) + ".");
 			return;
 		}
 
-		message->structValue->emplace("source", std::make_shared<Flows::Variable>(nodeId));
-		for(auto& node : nodeInfo->wiresOut.at(index))
+		//Don't modify the message of the sending node. Only the top level of the message is copied, all values are shared.
+		Flows::PVariable outputMessage = copyMessage(message);
+		if(outputMessage->structValue->find("payload") == outputMessage->structValue->end()) outputMessage->structValue->emplace("payload", std::make_shared<Flows::Variable>());
+		outputMessage->structValue->emplace("source", std::make_shared<Flows::Variable>(nodeId));
+		Flows::PVariable payload = outputMessage->structValue->at("payload");
+
+		auto& wires = nodeInfo->wiresOut.at(index);
+		for(auto wireIterator = wires.begin(); wireIterator != wires.end(); ++wireIterator)
 		{
+			auto& node = *wireIterator;
 			PNodeInfo outputNodeInfo;
+			PFlowInfoClient outputFlow;
 			{
 				std::lock_guard<std::mutex> nodesGuard(_nodesMutex);
 				auto nodeIterator = _nodes.find(node.id);
 				if(nodeIterator == _nodes.end()) continue;
 				outputNodeInfo = nodeIterator->second;
+				auto flowIterator = _nodeFlows.find(node.id);
+				if(flowIterator != _nodeFlows.end()) outputFlow = flowIterator->second;
+			}
+			PNodeMailbox mailbox = getNodeMailbox(node.id);
+			std::lock_guard<std::mutex> mailboxGuard(mailbox->mutex);
+			if(mailbox->inputs.size() >= _nodeMailboxSize)
+			{
+				printQueueFullError(_out, "Error: Dropping output of node " + nodeId + ". Input queue of node " + node.id + " is full.");
+				continue;
+			}
+			NodeInput nodeInput;
+			nodeInput.nodeInfo = outputNodeInfo;
+			nodeInput.flow = outputFlow;
+			nodeInput.targetPort = node.port;
+			//Every receiving node gets its own top level, so setting properties like "payload" doesn't affect the other
+			//receivers. The last receiver can use the output message directly.
+			nodeInput.message = (std::next(wireIterator) == wires.end()) ? outputMessage : copyMessage(outputMessage);
+			mailbox->inputs.push_back(std::move(nodeInput));
+			if(mailbox->scheduled) continue;
+			std::shared_ptr<BaseLib::IQueueEntry> queueEntry = std::make_shared<QueueEntry>(mailbox);
+			if(enqueue(2, queueEntry)) mailbox->scheduled = true;
+			else
+			{
+				mailbox->inputs.pop_back();
+				printQueueFullError(_out, "Error: Dropping output of node " + nodeId + ". Queue is full.");
 			}
-			std::shared_ptr<BaseLib::IQueueEntry> queueEntry = std::make_shared<QueueEntry>(outputNodeInfo, node.port, message);
-			if(!enqueue(2, queueEntry)) printQueueFullError(_out, "Error: Dropping output of node " + nodeId + ". Queue is full.");
 		}
 
 		if(_frontendConnected && GD::bl->settings.nodeBlueDebugOutput() && BaseLib::HelperFunctions::getTime() - nodeInfo->lastNodeEvent2 >= 200)
@@ -706,7 +853,7 @@ void FlowsClient::queueOutput(std::string nodeId, uint32_t index, Flows::PVariab
 			outputIndex->structValue->emplace("index", std::make_shared<Flows::Variable>(index));
 			nodeEvent(nodeId, "highlightLink/" + nodeId, outputIndex);
 			Flows::PVariable status = std::make_shared<Flows::Variable>(Flows::VariableType::tStruct);
-			std::string statusText = std::to_string(index) + ": " + message->structValue->at("payload")->toString();
+			std::string statusText = std::to_string(index) + ": " + payload->toString();
 			if(statusText.size() > 20) statusText = statusText.substr(0, 17) + "...";
 			status->structValue->emplace("text", std::make_shared<Flows::Variable>(statusText));
 			nodeEvent(nodeId, "statusTop/" + nodeId, status);
@@ -732,14 +879,94 @@ void FlowsClient::nodeEvent(std::string nodeId, std::string topic, Flows::PVaria
 	{
 		if(!value) return;
 
-		Flows::PArray parameters = std::make_shared<Flows::Array>();
-		parameters->reserve(3);
-		parameters->push_back(std::make_shared<Flows::Variable>(nodeId));
-		parameters->push_back(std::make_shared<Flows::Variable>(topic));
-		parameters->push_back(value);
+		Flows::PVariable event = std::make_shared<Flows::Variable>(Flows::VariableType::tArray);
+		event->arrayValue->reserve(3);
+		event->arrayValue->push_back(std::make_shared<Flows::Variable>(nodeId));
+		event->arrayValue->push_back(std::make_shared<Flows::Variable>(topic));
+		event->arrayValue->push_back(value);
+
+		std::lock_guard<std::mutex> nodeEventsGuard(_nodeEventsMutex);
+		auto indexIterator = _nodeEventIndices.find(nodeId + '/' + topic);
+		if(indexIterator != _nodeEventIndices.end())
+		{
+			//Replace the older event of this node and topic, but keep its position.
+			_nodeEvents->at(indexIterator->second) = event;
+			return;
+		}
+		if(_nodeEvents->size() >= _maxNodeEvents)
+		{
+			_droppedNodeEvents++;
+			int64_t time = BaseLib::HelperFunctions::getTime();
+			if(time - _lastDroppedNodeEventsWarning >= 10000)
+			{
+				_out.printWarning("Warning: Dropped " + std::to_string(_droppedNodeEvents) + " node events, because more than " + std::to_string(_maxNodeEvents) + " different node events were queued within " + std::to_string(_nodeEventsFlushInterval) + " ms.");
+				_lastDroppedNodeEventsWarning = time;
+				_droppedNodeEvents = 0;
+			}
+			_nodeEventsConditionVariable.notify_one();
+			return;
+		}
+		_nodeEventIndices.emplace(nodeId + '/' + topic, _nodeEvents->size());
+		_nodeEvents->push_back(event);
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
 
-		Flows::PVariable result = invoke("nodeEvent", parameters, false);
-		if(result->errorStruct) GD::out.printError("Error calling nodeEvent: " + result->structValue->at("faultString")->stringValue);
+void FlowsClient::nodeEventsThread()
+{
+	while(!_stopNodeEventsThread)
+	{
+		try
+		{
+			{
+				std::unique_lock<std::mutex> nodeEventsGuard(_nodeEventsMutex);
+				_nodeEventsConditionVariable.wait_for(nodeEventsGuard, std::chrono::milliseconds(_nodeEventsFlushInterval), [&] { return _stopNodeEventsThread || _nodeEvents->size() >= _maxNodeEvents; });
+			}
+			if(_stopNodeEventsThread) return;
+			flushNodeEvents();
+		}
+		catch(const std::exception& ex)
+		{
+			_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(BaseLib::Exception& ex)
+		{
+			_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(...)
+		{
+			_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+		}
+	}
+}
+
+void FlowsClient::flushNodeEvents()
+{
+	try
+	{
+		Flows::PArray events = std::make_shared<Flows::Array>();
+		{
+			std::lock_guard<std::mutex> nodeEventsGuard(_nodeEventsMutex);
+			if(_nodeEvents->empty()) return;
+			events.swap(_nodeEvents);
+			_nodeEventIndices.clear();
+		}
+
+		Flows::PArray parameters(new Flows::Array{ std::make_shared<Flows::Variable>(events) });
+
+		Flows::PVariable result = invoke("nodeEvents", parameters, false);
+		if(result->errorStruct) GD::out.printError("Error calling nodeEvents: " + result->structValue->at("faultString")->stringValue);
 	}
 	catch(const std::exception& ex)
     {
@@ -968,6 +1195,7 @@ Flows::PVariable FlowsClient::startFlow(Flows::PArray& parameters)
 
 			std::lock_guard<std::mutex> nodesGuard(_nodesMutex);
 			_nodes.emplace(node->id, node);
+			_nodeFlows.emplace(node->id, flow);
 		}
 
 		if(flow->nodes.empty())
@@ -1002,14 +1230,12 @@ Flows::PVariable FlowsClient::startFlow(Flows::PArray& parameters)
 		//{{{ Init nodes
 			{
 
+				//Only initialize the nodes of this flow. Nodes of flows that are already running must not be initialized again.
 				std::vector<PNodeInfo> nodes;
-				nodes.reserve(_nodes.size());
+				nodes.reserve(flow->nodes.size());
+				for(auto& node : flow->nodes)
 				{
-					std::lock_guard<std::mutex> nodesGuard(_nodesMutex);
-					for(auto& node : _nodes)
-					{
-						nodes.push_back(node.second);
-					}
+					nodes.push_back(node.second);
 				}
 				std::set<std::string> nodesToRemove;
 				for(auto& node : nodes)
@@ -1052,6 +1278,7 @@ Flows::PVariable FlowsClient::startFlow(Flows::PArray& parameters)
 					{
 						std::lock_guard<std::mutex> nodesGuard(_nodesMutex);
 						_nodes.erase(node);
+						_nodeFlows.erase(node);
 					}
 					_nodeManager->unloadNode(node);
 				}
@@ -1082,9 +1309,11 @@ Flows::PVariable FlowsClient::startNodes(Flows::PArray& parameters)
 {
 	try
 	{
+		int32_t flowId = parameters->empty() ? 0 : parameters->at(0)->integerValue;
 		std::lock_guard<std::mutex> flowsGuard(_flowsMutex);
 		for(auto& flow : _flows)
 		{
+			if(flowId != 0 && flow.first != flowId) continue;
 			std::set<std::string> nodesToRemove;
 			for(auto& nodeIterator : flow.second->nodes)
 			{
@@ -1130,9 +1359,11 @@ Flows::PVariable FlowsClient::configNodesStarted(Flows::PArray& parameters)
 {
 	try
 	{
+		int32_t flowId = parameters->empty() ? 0 : parameters->at(0)->integerValue;
 		std::lock_guard<std::mutex> flowsGuard(_flowsMutex);
 		for(auto& flow : _flows)
 		{
+			if(flowId != 0 && flow.first != flowId) continue;
 			for(auto& nodeIterator : flow.second->nodes)
 			{
 				Flows::PINode node = _nodeManager->getNode(nodeIterator.second->id);
@@ -1160,9 +1391,11 @@ Flows::PVariable FlowsClient::startUpComplete(Flows::PArray& parameters)
 {
 	try
 	{
+		int32_t flowId = parameters->empty() ? 0 : parameters->at(0)->integerValue;
 		std::lock_guard<std::mutex> flowsGuard(_flowsMutex);
 		for(auto& flow : _flows)
 		{
+			if(flowId != 0 && flow.first != flowId) continue;
 			for(auto& nodeIterator : flow.second->nodes)
 			{
 				Flows::PINode node = _nodeManager->getNode(nodeIterator.second->id);
@@ -1230,6 +1463,17 @@ Flows::PVariable FlowsClient::stopFlow(Flows::PArray& parameters)
 		auto flowsIterator = _flows.find(parameters->at(0)->integerValue);
 		if(flowsIterator == _flows.end()) return Flows::Variable::createError(-100, "Unknown flow.");
 		for(auto& node : flowsIterator->second->nodes)
+		{
+			Flows::PINode nodeObject = _nodeManager->getNode(node.second->id);
+			if(nodeObject) nodeObject->stop();
+		}
+		for(auto& node : flowsIterator->second->nodes)
+		{
+			Flows::PINode nodeObject = _nodeManager->getNode(node.second->id);
+			if(_bl->debugLevel >= 5) _out.printDebug("Debug: Waiting for node " + node.second->id + " to stop...");
+			if(nodeObject) nodeObject->waitForStop();
+		}
+		for(auto& node : flowsIterator->second->nodes)
 		{
 			{
 				std::lock_guard<std::mutex> peerSubscriptionsGuard(_peerSubscriptionsMutex);
@@ -1244,6 +1488,15 @@ Flows::PVariable FlowsClient::stopFlow(Flows::PArray& parameters)
 					}
 				}
 			}
+			{
+				std::lock_guard<std::mutex> nodeMailboxesGuard(_nodeMailboxesMutex);
+				_nodeMailboxes.erase(node.first);
+			}
+			{
+				std::lock_guard<std::mutex> nodesGuard(_nodesMutex);
+				_nodes.erase(node.first);
+				_nodeFlows.erase(node.first);
+			}
 			_nodeManager->unloadNode(node.second->id);
 		}
 		_flows.erase(flowsIterator);
@@ -1286,6 +1539,73 @@ Flows::PVariable FlowsClient::flowCount(Flows::PArray& parameters)
     return Flows::Variable::createError(-32500, "Unknown application error.");
 }
 
+Flows::PVariable FlowsClient::getLoad(Flows::PArray& parameters)
+{
+	try
+	{
+		Flows::PVariable load = std::make_shared<Flows::Variable>(Flows::VariableType::tStruct);
+
+		Flows::PVariable flows = std::make_shared<Flows::Variable>(Flows::VariableType::tStruct);
+		{
+			std::lock_guard<std::mutex> flowsGuard(_flowsMutex);
+			for(auto& flow : _flows)
+			{
+				Flows::PVariable flowLoad = std::make_shared<Flows::Variable>(Flows::VariableType::tStruct);
+				flowLoad->structValue->emplace("messageCount", std::make_shared<Flows::Variable>((int64_t)flow.second->messageCount));
+				flowLoad->structValue->emplace("cpuTime", std::make_shared<Flows::Variable>((int64_t)flow.second->cpuTime));
+				flows->structValue->emplace(std::to_string(flow.first), flowLoad);
+			}
+		}
+		load->structValue->emplace("flows", flows);
+
+		return load;
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return Flows::Variable::createError(-32500, "Unknown application error.");
+}
+
+Flows::PVariable FlowsClient::preloadNodes(Flows::PArray& parameters)
+{
+	try
+	{
+		if(parameters->size() != 1) return Flows::Variable::createError(-1, "Wrong parameter count.");
+
+		int32_t count = 0;
+		for(auto& node : *parameters->at(0)->arrayValue)
+		{
+			if(node->arrayValue->size() != 2) continue;
+			if(_nodeManager->preloadNode(node->arrayValue->at(0)->stringValue, node->arrayValue->at(1)->stringValue)) count++;
+		}
+		_out.printInfo("Info: Preloaded " + std::to_string(count) + " node libraries.");
+
+		return std::make_shared<Flows::Variable>();
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return Flows::Variable::createError(-32500, "Unknown application error.");
+}
+
 Flows::PVariable FlowsClient::nodeOutput(Flows::PArray& parameters)
 {
 	try
@@ -44,6 +44,7 @@
 #include <thread>
 #include <mutex>
 #include <string>
+#include <deque>
 
 namespace Flows
 {
@@ -63,13 +64,33 @@ private:
 		std::condition_variable conditionVariable;
 	};
 
+	struct NodeInput
+	{
+		PNodeInfo nodeInfo;
+		PFlowInfoClient flow;
+		uint32_t targetPort = 0;
+		Flows::PVariable message;
+	};
+
+	/**
+	 * Holds the pending inputs of one node. A mailbox is scheduled on the node output queue at most once at a time, so
+	 * the inputs of a node are processed in order and a slow node only occupies one processing thread.
+	 */
+	struct NodeMailbox
+	{
+		std::mutex mutex;
+		std::deque<NodeInput> inputs;
+		bool scheduled = false;
+	};
+	typedef std::shared_ptr<NodeMailbox> PNodeMailbox;
+
 	class QueueEntry : public BaseLib::IQueueEntry
 	{
 	public:
 		QueueEntry() {}
 		QueueEntry(std::string& methodName, Flows::PArray parameters) { this->methodName = methodName; this->parameters = parameters; }
 		QueueEntry(std::vector<char>& packet) { this->packet = packet; }
-		QueueEntry(Flows::PNodeInfo nodeInfo, uint32_t targetPort, Flows::PVariable message) { this->nodeInfo = nodeInfo; this->targetPort = targetPort; this->message = message; }
+		QueueEntry(PNodeMailbox& mailbox) { this->mailbox = mailbox; }
 		virtual ~QueueEntry() {}
 
 		//{{{ Request
@@ -82,9 +103,7 @@ private:
 		//}}}
 
 		//{{{ Node output
-			PNodeInfo nodeInfo;
-			uint32_t targetPort = 0;
-			Flows::PVariable message;
+			PNodeMailbox mailbox;
 		//}}}
 	};
 
@@ -108,6 +127,9 @@ private:
 	std::atomic_bool _nodesStopped;
 	std::unique_ptr<NodeManager> _nodeManager;
 	std::atomic_bool _frontendConnected;
+	const size_t _nodeMailboxSize = 1000;
+	const uint32_t _nodeInputsPerRun = 10;
+	const uint64_t _cpuTimeSampleInterval = 16; //Only every 16th message of a flow is timed to save the two clock_gettime() calls on the others
 
 	std::unique_ptr<Flows::BinaryRpc> _binaryRpc;
 	std::unique_ptr<Flows::RpcDecoder> _rpcDecoder;
@@ -120,6 +142,22 @@ private:
 
 	std::mutex _nodesMutex;
 	std::unordered_map<std::string, PNodeInfo> _nodes;
+	std::unordered_map<std::string, PFlowInfoClient> _nodeFlows;
+
+	std::mutex _nodeMailboxesMutex;
+	std::unordered_map<std::string, PNodeMailbox> _nodeMailboxes;
+
+	//Node events are collected and sent to the flows server as one "nodeEvents" call per flush interval. Only the latest event per node and topic is kept.
+	const int32_t _nodeEventsFlushInterval = 100;
+	const size_t _maxNodeEvents = 1000;
+	std::atomic_bool _stopNodeEventsThread;
+	std::thread _nodeEventsThread;
+	std::mutex _nodeEventsMutex;
+	std::condition_variable _nodeEventsConditionVariable;
+	Flows::PArray _nodeEvents;
+	std::unordered_map<std::string, size_t> _nodeEventIndices;
+	uint32_t _droppedNodeEvents = 0;
+	int64_t _lastDroppedNodeEventsWarning = 0;
 
 	std::mutex _peerSubscriptionsMutex;
 	std::unordered_map<uint64_t, std::unordered_map<int32_t, std::unordered_map<std::string, std::set<std::string>>>> _peerSubscriptions;
@@ -130,13 +168,26 @@ private:
 	void sendResponse(Flows::PVariable& packetId, Flows::PVariable& variable);
 
 	void processQueueEntry(int32_t index, std::shared_ptr<BaseLib::IQueueEntry>& entry);
+	void processNodeMailbox(std::shared_ptr<QueueEntry>& queueEntry);
+	PNodeMailbox getNodeMailbox(const std::string& nodeId);
 	Flows::PVariable send(std::vector<char>& data);
 
 	void log(std::string nodeId, int32_t logLevel, std::string message);
 	void subscribePeer(std::string nodeId, uint64_t peerId, int32_t channel, std::string variable);
 	void unsubscribePeer(std::string nodeId, uint64_t peerId, int32_t channel, std::string variable);
+
+	/**
+	 * Creates a shallow copy of a message. Only the top level struct is copied, the values are shared with the original
+	 * message. Nodes must not modify nested values of received messages in place, but replace them.
+	 *
+	 * @param message The message to copy.
+	 * @return Returns the copy.
+	 */
+	Flows::PVariable copyMessage(const Flows::PVariable& message);
 	void queueOutput(std::string nodeId, uint32_t index, Flows::PVariable message);
 	void nodeEvent(std::string nodeId, std::string topic, Flows::PVariable value);
+	void nodeEventsThread();
+	void flushNodeEvents();
 	Flows::PVariable getNodeData(std::string nodeId, std::string key);
 	void setNodeData(std::string nodeId, std::string key, Flows::PVariable value);
 	Flows::PVariable getConfigParameter(std::string nodeId, std::string name);
@@ -162,19 +213,19 @@ private:
 
 		/**
 		 * Executes the method "start" on all nodes. It is run after all nodes are initialized.
-		 * @param parameters
+		 * @param parameters Optionally the ID of the flow to restrict the call to.
 		 */
 		Flows::PVariable startNodes(Flows::PArray& parameters);
 
 		/**
 		 * Executed when all config nodes are available.
-		 * @param parameters
+		 * @param parameters Optionally the ID of the flow to restrict the call to.
 		 */
 		Flows::PVariable configNodesStarted(Flows::PArray& parameters);
 
 		/**
 		 * Executed when start up is complete. Nodes can output data from within this method.
-		 * @param parameters
+		 * @param parameters Optionally the ID of the flow to restrict the call to.
 		 */
 		Flows::PVariable startUpComplete(Flows::PArray& parameters);
 
@@ -185,8 +236,8 @@ private:
 		Flows::PVariable stopNodes(Flows::PArray& parameters);
 
 		/**
-		 * Stops a flow.
-		 * @param parameters
+		 * Stops a flow. Calls "stop" on all nodes of the flow and unloads them afterwards.
+		 * @param parameters The ID of the flow.
 		 */
 		Flows::PVariable stopFlow(Flows::PArray& parameters);
 
@@ -197,6 +248,19 @@ private:
 		 */
 		Flows::PVariable flowCount(Flows::PArray& parameters);
 
+		/**
+		 * Returns the number of processed messages and the CPU time per flow since the flows were started. The CPU time is extrapolated from every _cpuTimeSampleInterval-th message. It doesn't contain the time PHP nodes spend in Homegear's script engine.
+		 * @param parameters Irrelevant for this method.
+		 * @return Returns a struct with the key "flows". "flows" contains a struct with the keys "messageCount" and "cpuTime" (in microseconds) for each flow ID.
+		 */
+		Flows::PVariable getLoad(Flows::PArray& parameters);
+
+		/**
+		 * Loads the libraries of nodes before they are used by a flow. Called by the server on newly spawned spare processes.
+		 * @param parameters An array of arrays with the namespace and the type of each node.
+		 */
+		Flows::PVariable preloadNodes(Flows::PArray& parameters);
+
 		Flows::PVariable nodeOutput(Flows::PArray& parameters);
 		Flows::PVariable invokeExternalNodeMethod(Flows::PArray& parameters);
 		Flows::PVariable executePhpNodeBaseMethod(Flows::PArray& parameters);
@@ -72,6 +72,33 @@ uint32_t FlowsProcess::nodeThreadCount()
 	return _nodeThreadCount;
 }
 
+double FlowsProcess::load()
+{
+	try
+	{
+		double load = 0;
+		std::lock_guard<std::mutex> flowsGuard(_flowsMutex);
+		for(auto& flow : _flows)
+		{
+			load += flow.second->load;
+		}
+		return load;
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return 0;
+}
+
 void FlowsProcess::invokeFlowFinished(int32_t exitCode)
 {
 	try
@@ -208,7 +235,11 @@ void FlowsProcess::unregisterFlow(int32_t id)
 	try
 	{
 		std::lock_guard<std::mutex> flowsGuard(_flowsMutex);
-		_flows.erase(id);
+		auto flowIterator = _flows.find(id);
+		if(flowIterator == _flows.end()) return;
+		if(_nodeThreadCount >= flowIterator->second->maxThreadCount) _nodeThreadCount -= flowIterator->second->maxThreadCount;
+		else _nodeThreadCount = 0;
+		_flows.erase(flowIterator);
 		_flowFinishedInfo.erase(id);
 	}
 	catch(const std::exception& ex)
@@ -69,6 +69,11 @@ public:
 	void invokeFlowFinished(int32_t id, int32_t exitCode);
 	uint32_t flowCount();
 	uint32_t nodeThreadCount();
+
+	/**
+	 * Returns the estimated CPU load of all flows running in this process in cores.
+	 */
+	double load();
 	PFlowInfoServer getFlow(int32_t id);
 	PFlowFinishedInfo getFlowFinishedInfo(int32_t id);
 	void registerFlow(int32_t id, PFlowInfoServer& flowInfo);
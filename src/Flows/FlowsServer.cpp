@@ -47,8 +47,8 @@ FlowsServer::FlowsServer() : IQueue(GD::bl.get(), 3, 1000)
 	_stopServer = false;
 	_nodeEventsEnabled = false;
 	_flowsRestarting = false;
-	_lastNodeEvent = 0;
-	_nodeEventCounter = 0;
+	_spawningSpareProcess = false;
+	_stopSpareProcess = false;
 
 	_rpcDecoder = std::unique_ptr<BaseLib::Rpc::RpcDecoder>(new BaseLib::Rpc::RpcDecoder(GD::bl.get(), false, false));
 	_rpcEncoder = std::unique_ptr<BaseLib::Rpc::RpcEncoder>(new BaseLib::Rpc::RpcEncoder(GD::bl.get(), true, true));
@@ -153,12 +153,14 @@ FlowsServer::FlowsServer() : IQueue(GD::bl.get(), 3, 1000)
 #endif
 	_localRpcMethods.insert(std::pair<std::string, std::function<BaseLib::PVariable(PFlowsClientData& clientData, BaseLib::PArray& parameters)>>("invokeNodeMethod", std::bind(&FlowsServer::invokeNodeMethod, this, std::placeholders::_1, std::placeholders::_2)));
 	_localRpcMethods.insert(std::pair<std::string, std::function<BaseLib::PVariable(PFlowsClientData& clientData, BaseLib::PArray& parameters)>>("nodeEvent", std::bind(&FlowsServer::nodeEvent, this, std::placeholders::_1, std::placeholders::_2)));
+	_localRpcMethods.insert(std::pair<std::string, std::function<BaseLib::PVariable(PFlowsClientData& clientData, BaseLib::PArray& parameters)>>("nodeEvents", std::bind(&FlowsServer::nodeEvents, this, std::placeholders::_1, std::placeholders::_2)));
 }
 
 FlowsServer::~FlowsServer()
 {
 	if(!_stopServer) stop();
 	GD::bl->threadManager.join(_maintenanceThread);
+	GD::bl->threadManager.join(_spareProcessThread);
 }
 
 void FlowsServer::collectGarbage()
@@ -373,6 +375,7 @@ bool FlowsServer::start()
 		startQueue(2, false, flowsProcessingThreadCountServer, 0, SCHED_OTHER);
 		GD::bl->threadManager.start(_mainThread, true, &FlowsServer::mainThread, this);
 		startFlows();
+		startSpareProcess();
 		return true;
 	}
     catch(const std::exception& ex)
@@ -397,6 +400,7 @@ void FlowsServer::stop()
 		_shuttingDown = true;
 		_stopServer = true;
 		GD::bl->threadManager.join(_mainThread); //Prevent new connections
+		stopSpareProcess();
 		_out.printDebug("Debug: Waiting for flows engine server's client threads to finish.");
 		closeClientConnections();
 		stopQueue(0);
@@ -887,7 +891,7 @@ std::set<std::string> FlowsServer::insertSubflows(BaseLib::PVariable& subflowNod
     return std::set<std::string>();
 }
 
-void FlowsServer::startFlows()
+bool FlowsServer::getFlowDefinitions(std::unordered_map<std::string, FlowDefinition>& definitions, std::set<std::string>& knownIds)
 {
 	try
 	{
@@ -896,9 +900,9 @@ void FlowsServer::startFlows()
 		{
 			std::lock_guard<std::mutex> flowsFileGuard(_flowsFileMutex);
 			std::string flowsFile = GD::bl->settings.flowsDataPath() + "flows.json";
-			if(!GD::bl->io.fileExists(flowsFile)) return;
+			if(!GD::bl->io.fileExists(flowsFile)) return false;
 			rawFlows = GD::bl->io.getFileContent(flowsFile);
-			if(BaseLib::HelperFunctions::trim(rawFlows).empty()) return;
+			if(BaseLib::HelperFunctions::trim(rawFlows).empty()) return false;
 		}
 
 		//{{{ Filter all nodes and assign it to flows
@@ -1010,13 +1014,17 @@ void FlowsServer::startFlows()
 		for(auto& element : flowNodes)
 		{
 			if(subflowInfos.find(element.first) != subflowInfos.end()) continue;
-			BaseLib::PVariable flow = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
-			flow->arrayValue->reserve(element.second.size());
-			uint32_t maxThreadCount = 0;
+			FlowDefinition& definition = definitions[element.first];
+			definition.flow = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
+			definition.flow->arrayValue->reserve(element.second.size());
+			definition.nodeIds = nodeIds[element.first];
+			definition.disabled = disabledFlows.find(element.first) != disabledFlows.end();
+			std::map<std::string, BaseLib::PVariable> sortedNodes;
 			for(auto& node : element.second)
 			{
 				if(!node.second) continue;
-				flow->arrayValue->push_back(node.second);
+				definition.flow->arrayValue->push_back(node.second);
+				sortedNodes.emplace(node.first, node.second);
 				auto typeIterator = node.second->structValue->find("type");
 				if(typeIterator != node.second->structValue->end())
 				{
@@ -1027,18 +1035,72 @@ void FlowsServer::startFlows()
 						GD::out.printError("Error: Could not determine maximum thread count of node \"" + typeIterator->second->stringValue + "\". Node is unknown.");
 						continue;
 					}
-					maxThreadCount += threadCountIterator->second;
+					definition.maxThreadCount += threadCountIterator->second;
 				}
 				else GD::out.printError("Error: Could not determine maximum thread count of node. No key \"type\".");
 			}
 
-			if(disabledFlows.find(element.first) == disabledFlows.end())
+			//The digest is calculated over the nodes sorted by ID, so it only changes when a node of this flow (or of one of its subflows) changes.
+			std::vector<char> encodedNodes;
+			std::vector<char> encodedNode;
+			for(auto& node : sortedNodes)
 			{
-				PFlowInfoServer flowInfo = std::make_shared<FlowInfoServer>();
-				flowInfo->maxThreadCount = maxThreadCount;
-				flowInfo->flow = flow;
-				startFlow(flowInfo, nodeIds[element.first]);
+				_jsonEncoder->encode(node.second, encodedNode);
+				encodedNodes.insert(encodedNodes.end(), encodedNode.begin(), encodedNode.end());
 			}
+			std::vector<char> md5;
+			BaseLib::Security::Hash::md5(encodedNodes, md5);
+			definition.digest = BaseLib::HelperFunctions::getHexString(md5);
+		}
+
+		knownIds = std::move(allNodeIds);
+		for(auto& element : nodeIds)
+		{
+			knownIds.emplace(element.first);
+		}
+		return true;
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return false;
+}
+
+void FlowsServer::startFlows()
+{
+	try
+	{
+		{
+			std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+			_runningFlows.clear();
+		}
+
+		std::unordered_map<std::string, FlowDefinition> definitions;
+		std::set<std::string> knownIds;
+		if(!getFlowDefinitions(definitions, knownIds)) return;
+		pruneFlowLoads(definitions);
+
+		//Start the flows with the highest measured load first, so they are spread across processes before the light ones fill them up.
+		std::vector<std::pair<double, std::string>> flowsToStart;
+		flowsToStart.reserve(definitions.size());
+		for(auto& definition : definitions)
+		{
+			if(!definition.second.disabled) flowsToStart.push_back(std::make_pair(getFlowLoad(definition.first), definition.first));
+		}
+		std::sort(flowsToStart.begin(), flowsToStart.end(), [](const std::pair<double, std::string>& a, const std::pair<double, std::string>& b) { return a.first > b.first; });
+
+		for(auto& flowToStart : flowsToStart)
+		{
+			startFlow(flowToStart.second, definitions.at(flowToStart.second));
 		}
 
 		std::vector<PFlowsClientData> clients;
@@ -1072,11 +1134,117 @@ void FlowsServer::startFlows()
 			sendRequest(client, "startUpComplete", parameters, true);
 		}
 
+		deleteUnusedNodeData(knownIds);
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
+bool FlowsServer::updateChangedFlows()
+{
+	try
+	{
+		std::unordered_map<std::string, FlowDefinition> definitions;
+		std::set<std::string> knownIds;
+		if(!getFlowDefinitions(definitions, knownIds)) return false;
+		pruneFlowLoads(definitions);
+
+		std::vector<std::string> flowsToStop;
+		std::vector<std::string> flowsToStart;
+		{
+			std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+			if(_runningFlows.empty()) return false;
+
+			for(auto& runningFlow : _runningFlows)
+			{
+				if(!runningFlow.second.clientData || runningFlow.second.clientData->closed) return false;
+				auto definitionIterator = definitions.find(runningFlow.first);
+				if(definitionIterator == definitions.end() || definitionIterator->second.disabled || definitionIterator->second.digest != runningFlow.second.digest) flowsToStop.push_back(runningFlow.first);
+			}
+
+			for(auto& definition : definitions)
+			{
+				if(definition.second.disabled) continue;
+				auto runningFlowIterator = _runningFlows.find(definition.first);
+				if(runningFlowIterator == _runningFlows.end() || runningFlowIterator->second.digest != definition.second.digest) flowsToStart.push_back(definition.first);
+			}
+		}
+
+		//Global config nodes can be used by nodes of all flows.
+		for(auto& flowId : flowsToStop)
+		{
+			if(flowId == "g") return false;
+		}
+		for(auto& flowId : flowsToStart)
+		{
+			if(flowId == "g") return false;
+		}
+
+		std::sort(flowsToStart.begin(), flowsToStart.end(), [this](const std::string& a, const std::string& b) { return getFlowLoad(a) > getFlowLoad(b); });
+
+		_out.printInfo("Info: Stopping " + std::to_string(flowsToStop.size()) + " and starting " + std::to_string(flowsToStart.size()) + " changed flows.");
+		for(auto& flowId : flowsToStop)
+		{
+			stopFlow(flowId);
+		}
+
+		std::vector<std::pair<PFlowsClientData, int32_t>> startedFlows;
+		startedFlows.reserve(flowsToStart.size());
+		for(auto& flowId : flowsToStart)
+		{
+			PFlowInfoServer flowInfo = startFlow(flowId, definitions.at(flowId));
+			if(!flowInfo) continue;
+			std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+			auto runningFlowIterator = _runningFlows.find(flowId);
+			if(runningFlowIterator != _runningFlows.end()) startedFlows.push_back(std::make_pair(runningFlowIterator->second.clientData, flowInfo->id));
+		}
+
+		for(auto& method : std::vector<std::string>{ "startNodes", "configNodesStarted", "startUpComplete" })
+		{
+			for(auto& startedFlow : startedFlows)
+			{
+				BaseLib::PArray parameters(new BaseLib::Array{ std::make_shared<BaseLib::Variable>(startedFlow.second) });
+				sendRequest(startedFlow.first, method, parameters, true);
+			}
+		}
+
+		deleteUnusedNodeData(knownIds);
+		return true;
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return false;
+}
+
+void FlowsServer::deleteUnusedNodeData(std::set<std::string>& knownIds)
+{
+	try
+	{
 		std::set<std::string> nodeData = GD::bl->db->getAllNodeDataNodes();
 		std::string dataKey;
 		for(auto nodeId : nodeData)
 		{
-			if(allNodeIds.find(nodeId) == allNodeIds.end() && nodeIds.find(nodeId) == nodeIds.end() && nodeId != "global") GD::bl->db->deleteNodeData(nodeId, dataKey);
+			if(knownIds.find(nodeId) == knownIds.end() && nodeId != "global") GD::bl->db->deleteNodeData(nodeId, dataKey);
 		}
 	}
 	catch(const std::exception& ex)
@@ -1226,6 +1394,8 @@ void FlowsServer::restartFlows()
 	{
 		std::lock_guard<std::mutex> restartFlowsGuard(_restartFlowsMutex);
 		_flowsRestarting = true;
+		stopSpareProcess();
+		updateFlowLoads();
 		stopNodes();
 		_out.printInfo("Info: Stopping Flows...");
 		sendShutdown();
@@ -1234,6 +1404,43 @@ void FlowsServer::restartFlows()
 		getMaxThreadCounts();
 		_out.printInfo("Info: Starting Flows...");
 		startFlows();
+		_flowsRestarting = false;
+		startSpareProcess();
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    _flowsRestarting = false;
+}
+
+void FlowsServer::updateFlows()
+{
+	try
+	{
+		{
+			std::lock_guard<std::mutex> restartFlowsGuard(_restartFlowsMutex);
+			_flowsRestarting = true;
+			updateFlowLoads();
+			getMaxThreadCounts();
+			bool updated = updateChangedFlows();
+			_flowsRestarting = false;
+			if(updated)
+			{
+				startSpareProcess();
+				return;
+			}
+		}
+		_out.printInfo("Info: Flows can't be updated incrementally. Restarting all flows.");
+		restartFlows();
 	}
 	catch(const std::exception& ex)
     {
@@ -1445,7 +1652,7 @@ std::string FlowsServer::handlePost(std::string& path, BaseLib::Http& http, std:
 			BaseLib::HelperFunctions::toLower(md5String);
 
 			_out.printInfo("Info: Deploying (3)...");
-			GD::bl->threadManager.start(_maintenanceThread, true, &FlowsServer::restartFlows, this);
+			GD::bl->threadManager.start(_maintenanceThread, true, &FlowsServer::updateFlows, this);
 
 			return "{\"rev\": \"" + md5String + "\"}";
 		}
@@ -2042,7 +2249,7 @@ void FlowsServer::mainThread()
     }
 }
 
-PFlowsProcess FlowsServer::getFreeProcess(uint32_t maxThreadCount)
+PFlowsProcess FlowsServer::getFreeProcess(uint32_t maxThreadCount, double load)
 {
 	try
 	{
@@ -2052,18 +2259,82 @@ PFlowsProcess FlowsServer::getFreeProcess(uint32_t maxThreadCount)
 			return PFlowsProcess();
 		}
 
-		std::lock_guard<std::mutex> processGuard(_newProcessMutex);
+		//Existing processes are checked without locking _newProcessMutex, so placing a flow doesn't wait for a process that is currently being spawned.
+		PFlowsProcess process = findFreeProcess(maxThreadCount, load);
+		if(!process)
+		{
+			std::lock_guard<std::mutex> newProcessGuard(_newProcessMutex);
+			process = findFreeProcess(maxThreadCount, load); //Another thread might have spawned a process in the meantime
+			if(!process) process = spawnProcess();
+		}
+		return process;
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return PFlowsProcess();
+}
+
+PFlowsProcess FlowsServer::findFreeProcess(uint32_t maxThreadCount, double load)
+{
+	try
+	{
+		//Place the flow in the least loaded process with enough free node threads. A new process is used when the flow would push all processes over _maxProcessLoad, so heavy flows don't share a process (and CPU core) with others.
+		//Empty processes (e. g. the spare process) are only used when no process running flows can take the flow.
+		std::lock_guard<std::mutex> processGuard(_processMutex);
+		PFlowsProcess bestProcess;
+		PFlowsProcess emptyProcess;
+		double bestProcessLoad = 0;
+		for(std::map<pid_t, PFlowsProcess>::iterator i = _processes.begin(); i != _processes.end(); ++i)
 		{
-			std::lock_guard<std::mutex> processGuard(_processMutex);
-			for(std::map<pid_t, PFlowsProcess>::iterator i = _processes.begin(); i != _processes.end(); ++i)
+			if(GD::bl->settings.maxNodeThreadsPerProcess() == -1 || i->second->nodeThreadCount() + maxThreadCount <= (unsigned)GD::bl->settings.maxNodeThreadsPerProcess())
 			{
-				if(GD::bl->settings.maxNodeThreadsPerProcess() == -1 || i->second->nodeThreadCount() + maxThreadCount <= (unsigned)GD::bl->settings.maxNodeThreadsPerProcess())
+				if(i->second->flowCount() == 0)
 				{
-					i->second->lastExecution = BaseLib::HelperFunctions::getTime();
-					return i->second;
+					if(!emptyProcess && i->second->getClientData() && !i->second->getClientData()->closed) emptyProcess = i->second;
+					continue;
+				}
+				double processLoad = i->second->load();
+				if(processLoad > 0 && processLoad + load > _maxProcessLoad) continue;
+				if(!bestProcess || processLoad < bestProcessLoad)
+				{
+					bestProcess = i->second;
+					bestProcessLoad = processLoad;
 				}
 			}
 		}
+		if(!bestProcess) bestProcess = emptyProcess;
+		if(bestProcess) bestProcess->lastExecution = BaseLib::HelperFunctions::getTime();
+		return bestProcess;
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return PFlowsProcess();
+}
+
+PFlowsProcess FlowsServer::spawnProcess(bool spare)
+{
+	try
+	{
 		_out.printInfo("Info: Spawning new flows process.");
 		PFlowsProcess process(new FlowsProcess());
 		std::vector<std::string> arguments{ "-c", GD::configPath, "-rl" };
@@ -2081,13 +2352,14 @@ PFlowsProcess FlowsServer::getFreeProcess(uint32_t maxThreadCount)
 
 			std::mutex requestMutex;
 			std::unique_lock<std::mutex> requestLock(requestMutex);
-			process->requestConditionVariable.wait_for(requestLock, std::chrono::milliseconds(30000), [&]{ return (bool)(process->getClientData()); });
+			process->requestConditionVariable.wait_for(requestLock, std::chrono::milliseconds(30000), [&]{ return (bool)(process->getClientData()) || (spare && _stopSpareProcess); });
 
 			if(!process->getClientData())
 			{
 				std::lock_guard<std::mutex> processGuard(_processMutex);
 				_processes.erase(process->getPid());
-				_out.printError("Error: Could not start new flows process.");
+				if(spare && _stopSpareProcess) _out.printInfo("Info: Spawning of spare flows process was aborted.");
+				else _out.printError("Error: Could not start new flows process.");
 				return PFlowsProcess();
 			}
 			_out.printInfo("Info: Flows process successfully spawned. Process id is " + std::to_string(process->getPid()) + ". Client id is: " + std::to_string(process->getClientData()->id) + ".");
@@ -2114,6 +2386,265 @@ PFlowsProcess FlowsServer::getFreeProcess(uint32_t maxThreadCount)
     return PFlowsProcess();
 }
 
+void FlowsServer::startSpareProcess()
+{
+#ifndef FLOWS_MANUAL_CLIENT_START
+	try
+	{
+		std::lock_guard<std::mutex> spareProcessGuard(_spareProcessMutex);
+		if(_shuttingDown || _flowsRestarting || _spawningSpareProcess) return;
+		{
+			std::lock_guard<std::mutex> processGuard(_processMutex);
+			if(_processes.size() < _minProcessesForSpareProcess) return;
+			for(std::map<pid_t, PFlowsProcess>::iterator i = _processes.begin(); i != _processes.end(); ++i)
+			{
+				if(i->second->flowCount() == 0) return;
+			}
+		}
+		_spawningSpareProcess = true;
+		GD::bl->threadManager.join(_spareProcessThread);
+		GD::bl->threadManager.start(_spareProcessThread, true, &FlowsServer::spawnSpareProcess, this);
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+#endif
+}
+
+void FlowsServer::spawnSpareProcess()
+{
+	try
+	{
+		//_newProcessMutex is not locked here, so flows placed in the meantime don't wait up to 30 seconds for the spare process to connect.
+		PFlowsProcess process;
+		if(!_shuttingDown && !_stopSpareProcess) process = spawnProcess(true);
+		if(process && !_stopSpareProcess)
+		{
+			process->lastExecution = BaseLib::HelperFunctions::getTime();
+			BaseLib::PArray parameters(new BaseLib::Array{ getRunningNodeTypes() });
+			sendRequest(process->getClientData(), "preloadNodes", parameters, false);
+		}
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    _spawningSpareProcess = false;
+}
+
+void FlowsServer::stopSpareProcess()
+{
+	try
+	{
+		_stopSpareProcess = true;
+		{
+			std::lock_guard<std::mutex> processGuard(_processMutex);
+			for(std::map<pid_t, PFlowsProcess>::iterator i = _processes.begin(); i != _processes.end(); ++i)
+			{
+				i->second->requestConditionVariable.notify_all();
+			}
+		}
+		std::lock_guard<std::mutex> spareProcessGuard(_spareProcessMutex);
+		GD::bl->threadManager.join(_spareProcessThread);
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    _stopSpareProcess = false;
+}
+
+BaseLib::PVariable FlowsServer::getRunningNodeTypes()
+{
+	BaseLib::PVariable nodeTypes = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
+	try
+	{
+		std::set<std::pair<std::string, std::string>> uniqueNodeTypes;
+		{
+			std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+			for(auto& runningFlow : _runningFlows)
+			{
+				if(!runningFlow.second.flowInfo || !runningFlow.second.flowInfo->flow) continue;
+				for(auto& node : *runningFlow.second.flowInfo->flow->arrayValue)
+				{
+					auto typeIterator = node->structValue->find("type");
+					if(typeIterator == node->structValue->end() || typeIterator->second->stringValue.compare(0, 8, "subflow:") == 0) continue;
+					auto namespaceIterator = node->structValue->find("namespace");
+					uniqueNodeTypes.emplace(namespaceIterator == node->structValue->end() ? typeIterator->second->stringValue : namespaceIterator->second->stringValue, typeIterator->second->stringValue);
+				}
+			}
+		}
+
+		nodeTypes->arrayValue->reserve(uniqueNodeTypes.size());
+		for(auto& nodeType : uniqueNodeTypes)
+		{
+			nodeTypes->arrayValue->push_back(std::make_shared<BaseLib::Variable>(BaseLib::PArray(new BaseLib::Array{ std::make_shared<BaseLib::Variable>(nodeType.first), std::make_shared<BaseLib::Variable>(nodeType.second) })));
+		}
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return nodeTypes;
+}
+
+void FlowsServer::updateFlowLoads()
+{
+	try
+	{
+		std::vector<std::pair<std::string, RunningFlow>> runningFlows;
+		{
+			std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+			runningFlows.reserve(_runningFlows.size());
+			for(auto& runningFlow : _runningFlows)
+			{
+				runningFlows.push_back(std::make_pair(runningFlow.first, runningFlow.second));
+			}
+		}
+
+		std::map<int32_t, BaseLib::PVariable> clientLoads;
+		for(auto& runningFlow : runningFlows)
+		{
+			PFlowsClientData& clientData = runningFlow.second.clientData;
+			PFlowInfoServer& flowInfo = runningFlow.second.flowInfo;
+			if(!clientData || clientData->closed || !flowInfo) continue;
+			auto clientLoadIterator = clientLoads.find(clientData->id);
+			if(clientLoadIterator == clientLoads.end())
+			{
+				BaseLib::PArray parameters(new BaseLib::Array());
+				BaseLib::PVariable result = sendRequest(clientData, "getLoad", parameters, true);
+				if(result->errorStruct)
+				{
+					_out.printWarning("Warning: Could not get load of flows client " + std::to_string(clientData->id) + ": " + result->structValue->at("faultString")->stringValue);
+					result = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
+				}
+				clientLoadIterator = clientLoads.emplace(clientData->id, result).first;
+			}
+
+			auto flowsIterator = clientLoadIterator->second->structValue->find("flows");
+			if(flowsIterator == clientLoadIterator->second->structValue->end()) continue;
+			auto flowIterator = flowsIterator->second->structValue->find(std::to_string(flowInfo->id));
+			if(flowIterator == flowsIterator->second->structValue->end()) continue;
+			auto messageCountIterator = flowIterator->second->structValue->find("messageCount");
+			auto cpuTimeIterator = flowIterator->second->structValue->find("cpuTime");
+			if(messageCountIterator == flowIterator->second->structValue->end() || cpuTimeIterator == flowIterator->second->structValue->end()) continue;
+
+			int64_t time = BaseLib::HelperFunctions::getTime();
+			int64_t timeDelta = time - flowInfo->loadTime;
+			if(timeDelta < _minLoadInterval) continue;
+
+			FlowLoad flowLoad;
+			flowLoad.cpuLoad = (double)(cpuTimeIterator->second->integerValue64 - flowInfo->cpuTime) / (double)(timeDelta * 1000);
+			flowLoad.messageRate = (double)(messageCountIterator->second->integerValue64 - flowInfo->messageCount) * 1000.0 / (double)timeDelta;
+			if(flowLoad.cpuLoad < 0) flowLoad.cpuLoad = 0;
+			if(flowLoad.messageRate < 0) flowLoad.messageRate = 0;
+			flowInfo->loadTime = time;
+			flowInfo->cpuTime = cpuTimeIterator->second->integerValue64;
+			flowInfo->messageCount = messageCountIterator->second->integerValue64;
+			flowInfo->load = flowLoad.cpuLoad;
+
+			if(GD::bl->debugLevel >= 4) _out.printInfo("Info: Load of flow " + runningFlow.first + ": " + std::to_string(flowLoad.messageRate) + " messages/s, " + std::to_string(flowLoad.cpuLoad * 100) + "% CPU.");
+
+			std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+			_flowLoads[runningFlow.first] = flowLoad;
+		}
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
+double FlowsServer::getFlowLoad(const std::string& flowId)
+{
+	try
+	{
+		std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+		auto flowLoadIterator = _flowLoads.find(flowId);
+		if(flowLoadIterator != _flowLoads.end()) return flowLoadIterator->second.cpuLoad;
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return 0;
+}
+
+void FlowsServer::pruneFlowLoads(const std::unordered_map<std::string, FlowDefinition>& definitions)
+{
+	try
+	{
+		std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+		for(auto i = _flowLoads.begin(); i != _flowLoads.end();)
+		{
+			auto definitionIterator = definitions.find(i->first);
+			if(definitionIterator == definitions.end() || definitionIterator->second.disabled) i = _flowLoads.erase(i);
+			else ++i;
+		}
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
 void FlowsServer::readClient(PFlowsClientData& clientData)
 {
 	try
@@ -2264,17 +2795,23 @@ bool FlowsServer::getFileDescriptor(bool deleteOldSocket)
     return false;
 }
 
-void FlowsServer::startFlow(PFlowInfoServer& flowInfo, std::set<std::string>& nodes)
+PFlowInfoServer FlowsServer::startFlow(const std::string& flowId, FlowDefinition& definition)
 {
 	try
 	{
-		if(_shuttingDown) return;
-		PFlowsProcess process = getFreeProcess(flowInfo->maxThreadCount);
+		if(_shuttingDown) return PFlowInfoServer();
+		PFlowInfoServer flowInfo = std::make_shared<FlowInfoServer>();
+		flowInfo->maxThreadCount = definition.maxThreadCount;
+		flowInfo->flow = definition.flow;
+		flowInfo->load = getFlowLoad(flowId);
+		flowInfo->loadTime = BaseLib::HelperFunctions::getTime();
+
+		PFlowsProcess process = getFreeProcess(flowInfo->maxThreadCount, flowInfo->load);
 		if(!process)
 		{
 			_out.printError("Error: Could not get free process. Not executing flow.");
 			flowInfo->exitCode = -1;
-			return;
+			return PFlowInfoServer();
 		}
 
 		{
@@ -2289,9 +2826,9 @@ void FlowsServer::startFlow(PFlowInfoServer& flowInfo, std::set<std::string>& no
 
 		{
 			std::lock_guard<std::mutex> nodeClientIdMapGuard(_nodeClientIdMapMutex);
-			for(auto& node : nodes)
+			for(auto& node : definition.nodeIds)
 			{
-				_nodeClientIdMap.emplace(node, clientData->id);
+				_nodeClientIdMap[node] = clientData->id;
 			}
 		}
 
@@ -2309,15 +2846,26 @@ void FlowsServer::startFlow(PFlowInfoServer& flowInfo, std::set<std::string>& no
 
 			{
 				std::lock_guard<std::mutex> nodeClientIdMapGuard(_nodeClientIdMapMutex);
-				for(auto& node : nodes)
+				for(auto& node : definition.nodeIds)
 				{
 					_nodeClientIdMap.erase(node);
 				}
 			}
 
-			return;
+			return PFlowInfoServer();
 		}
 		flowInfo->started = true;
+
+		{
+			std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+			RunningFlow& runningFlow = _runningFlows[flowId];
+			runningFlow.flowInfo = flowInfo;
+			runningFlow.clientData = clientData;
+			runningFlow.digest = definition.digest;
+			runningFlow.nodeIds = definition.nodeIds;
+		}
+
+		return flowInfo;
 	}
     catch(const std::exception& ex)
     {
@@ -2331,6 +2879,55 @@ void FlowsServer::startFlow(PFlowInfoServer& flowInfo, std::set<std::string>& no
     {
     	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
     }
+    return PFlowInfoServer();
+}
+
+void FlowsServer::stopFlow(const std::string& flowId)
+{
+	try
+	{
+		RunningFlow runningFlow;
+		{
+			std::lock_guard<std::mutex> runningFlowsGuard(_runningFlowsMutex);
+			auto runningFlowIterator = _runningFlows.find(flowId);
+			if(runningFlowIterator == _runningFlows.end()) return;
+			runningFlow = std::move(runningFlowIterator->second);
+			_runningFlows.erase(runningFlowIterator);
+		}
+		if(!runningFlow.flowInfo || !runningFlow.clientData) return;
+
+		_out.printInfo("Info: Stopping flow with id " + std::to_string(runningFlow.flowInfo->id) + ".");
+		BaseLib::PArray parameters(new BaseLib::Array{ std::make_shared<BaseLib::Variable>(runningFlow.flowInfo->id) });
+		BaseLib::PVariable result = sendRequest(runningFlow.clientData, "stopFlow", parameters, true);
+		if(result->errorStruct) _out.printError("Error: Could not stop flow with id " + std::to_string(runningFlow.flowInfo->id) + ": " + result->structValue->at("faultString")->stringValue);
+
+		{
+			std::lock_guard<std::mutex> processGuard(_processMutex);
+			auto processIterator = _processes.find(runningFlow.clientData->pid);
+			if(processIterator != _processes.end()) processIterator->second->unregisterFlow(runningFlow.flowInfo->id);
+		}
+
+		{
+			std::lock_guard<std::mutex> nodeClientIdMapGuard(_nodeClientIdMapMutex);
+			for(auto& node : runningFlow.nodeIds)
+			{
+				auto nodeIterator = _nodeClientIdMap.find(node);
+				if(nodeIterator != _nodeClientIdMap.end() && nodeIterator->second == runningFlow.clientData->id) _nodeClientIdMap.erase(nodeIterator);
+			}
+		}
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
 }
 
 BaseLib::PVariable FlowsServer::executePhpNodeBaseMethod(BaseLib::PArray& parameters)
@@ -2520,17 +3117,39 @@ BaseLib::PVariable FlowsServer::nodeEvent(PFlowsClientData& clientData, BaseLib:
 	{
 		if(parameters->size() != 3) return BaseLib::Variable::createError(-1, "Method expects exactly three parameters.");
 
-		if(BaseLib::HelperFunctions::getTime() - _lastNodeEvent >= 60000)
+		GD::rpcClient->broadcastNodeEvent(parameters->at(0)->stringValue, parameters->at(1)->stringValue, parameters->at(2));
+		return std::make_shared<BaseLib::Variable>();
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return BaseLib::Variable::createError(-32500, "Unknown application error.");
+}
+
+BaseLib::PVariable FlowsServer::nodeEvents(PFlowsClientData& clientData, BaseLib::PArray& parameters)
+{
+	try
+	{
+		if(parameters->size() != 1 || parameters->at(0)->type != BaseLib::VariableType::tArray) return BaseLib::Variable::createError(-1, "Method expects exactly one parameter of type array.");
+
+		BaseLib::PArray events = std::make_shared<BaseLib::Array>();
+		events->reserve(parameters->at(0)->arrayValue->size());
+		for(auto& event : *parameters->at(0)->arrayValue)
 		{
-			_lastNodeEvent = BaseLib::HelperFunctions::getTime();
-			_nodeEventCounter = 0;
+			if(event->type != BaseLib::VariableType::tArray || event->arrayValue->size() != 3) continue;
+			events->push_back(event);
 		}
-		if(parameters->at(1)->stringValue.compare(0, 14, "highlightNode/") == 0 && _nodeEventCounter > 500) return std::make_shared<BaseLib::Variable>();
-		else if(parameters->at(1)->stringValue != "debug" && _nodeEventCounter > 1000) return std::make_shared<BaseLib::Variable>();
-		else if(_nodeEventCounter > 2000) return std::make_shared<BaseLib::Variable>();
-		_nodeEventCounter++;
 
-		GD::rpcClient->broadcastNodeEvent(parameters->at(0)->stringValue, parameters->at(1)->stringValue, parameters->at(2));
+		GD::rpcClient->broadcastNodeEvents(events);
 		return std::make_shared<BaseLib::Variable>();
 	}
     catch(const std::exception& ex)
@@ -48,6 +48,11 @@ public:
 	bool start();
 	void stop();
 	void restartFlows();
+
+	/**
+	 * Stops and starts only the flows that were added, changed or removed since the last deployment. Falls back to restartFlows() when the global flow changed or a client process is gone.
+	 */
+	void updateFlows();
 	void homegearShuttingDown();
 	void homegearReloading();
 	void processKilled(pid_t pid, int32_t exitCode, int32_t signal, bool coreDumped);
@@ -84,6 +89,29 @@ private:
 		// }}}
 	};
 
+	struct FlowDefinition
+	{
+		BaseLib::PVariable flow;
+		uint32_t maxThreadCount = 0;
+		std::set<std::string> nodeIds;
+		std::string digest;
+		bool disabled = false;
+	};
+
+	struct FlowLoad
+	{
+		double cpuLoad = 0;
+		double messageRate = 0;
+	};
+
+	struct RunningFlow
+	{
+		PFlowInfoServer flowInfo;
+		PFlowsClientData clientData;
+		std::string digest;
+		std::set<std::string> nodeIds;
+	};
+
 	BaseLib::Output _out;
 	std::string _socketPath;
 	std::string _webroot;
@@ -92,6 +120,10 @@ private:
 	std::atomic_bool _nodeEventsEnabled;
 	std::thread _mainThread;
 	std::thread _maintenanceThread;
+	std::thread _spareProcessThread;
+	std::atomic_bool _spawningSpareProcess;
+	std::atomic_bool _stopSpareProcess;
+	std::mutex _spareProcessMutex;
 	int32_t _backlog = 100;
 	std::shared_ptr<BaseLib::FileDescriptor> _serverFileDescriptor;
 	std::mutex _newProcessMutex;
@@ -118,9 +150,12 @@ private:
 	std::unique_ptr<BaseLib::Rpc::JsonDecoder> _jsonDecoder;
 	std::mutex _nodeClientIdMapMutex;
 	std::map<std::string, int32_t> _nodeClientIdMap;
-
-	std::atomic<int64_t> _lastNodeEvent;
-	std::atomic<uint32_t> _nodeEventCounter;
+	std::mutex _runningFlowsMutex;
+	std::unordered_map<std::string, RunningFlow> _runningFlows;
+	std::unordered_map<std::string, FlowLoad> _flowLoads;
+	const int64_t _minLoadInterval = 10000;
+	const double _maxProcessLoad = 0.8;
+	const uint32_t _minProcessesForSpareProcess = 2; //A spare process costs the memory of one idle "homegear -rl" process, so it is only kept when the flows already need several processes.
 
 	std::unique_ptr<BaseLib::Rpc::RpcDecoder> _rpcDecoder;
 	std::unique_ptr<BaseLib::Rpc::RpcEncoder> _rpcEncoder;
@@ -135,14 +170,53 @@ private:
 	void sendShutdown();
 	void closeClientConnections();
 	void closeClientConnection(PFlowsClientData client);
-	PFlowsProcess getFreeProcess(uint32_t maxThreadCount);
+	PFlowsProcess getFreeProcess(uint32_t maxThreadCount, double load);
+
+	/**
+	 * Returns the existing process the flow should be placed in or nullptr if a new process is needed.
+	 */
+	PFlowsProcess findFreeProcess(uint32_t maxThreadCount, double load);
+
+	/**
+	 * Starts a new flows process and waits for it to connect. _newProcessMutex must be locked, except when spawning the spare process: It isn't returned by findFreeProcess() before it is connected.
+	 *
+	 * @param spare Set to true for the spare process. Waiting for it to connect is aborted by stopSpareProcess().
+	 */
+	PFlowsProcess spawnProcess(bool spare = false);
+
+	/**
+	 * Spawns a spare flows process in the background, if there is no empty process and the flows run in at least _minProcessesForSpareProcess processes. The spare process preloads the node libraries used by the running flows, so the next flow that needs a new process doesn't have to wait for a process to start. Called after flows were (re)started, as flows are only placed while _flowsRestarting is set.
+	 */
+	void startSpareProcess();
+	void spawnSpareProcess();
+
+	/**
+	 * Aborts spawning the spare process and waits for the spawn thread to finish. Called before flows are restarted and on shutdown.
+	 */
+	void stopSpareProcess();
+
+	/**
+	 * Returns the namespaces and types of all nodes of running flows as an array of arrays.
+	 */
+	BaseLib::PVariable getRunningNodeTypes();
+	void updateFlowLoads();
+	double getFlowLoad(const std::string& flowId);
+
+	/**
+	 * Removes the measured loads of flows that were deleted or disabled.
+	 */
+	void pruneFlowLoads(const std::unordered_map<std::string, FlowDefinition>& definitions);
 	void getMaxThreadCounts();
 	bool checkIntegrity(std::string flowsFile);
 	void backupFlows();
+	bool getFlowDefinitions(std::unordered_map<std::string, FlowDefinition>& definitions, std::set<std::string>& knownIds);
 	void startFlows();
+	bool updateChangedFlows();
+	void deleteUnusedNodeData(std::set<std::string>& knownIds);
 	void stopNodes();
 	std::set<std::string> insertSubflows(BaseLib::PVariable& subflowNode, std::unordered_map<std::string, BaseLib::PVariable>& subflowInfos, std::unordered_map<std::string, BaseLib::PVariable>& flowNodes, std::unordered_map<std::string, BaseLib::PVariable>& subflowNodes, std::set<std::string>& flowNodeIds, std::set<std::string>& allNodeIds);
-	void startFlow(PFlowInfoServer& flowInfo, std::set<std::string>& nodes);
+	PFlowInfoServer startFlow(const std::string& flowId, FlowDefinition& definition);
+	void stopFlow(const std::string& flowId);
 
 	void processQueueEntry(int32_t index, std::shared_ptr<BaseLib::IQueueEntry>& entry);
 
@@ -152,6 +226,7 @@ private:
 		BaseLib::PVariable executePhpNodeMethod(PFlowsClientData& clientData, BaseLib::PArray& parameters);
 		BaseLib::PVariable invokeNodeMethod(PFlowsClientData& clientData, BaseLib::PArray& parameters);
 		BaseLib::PVariable nodeEvent(PFlowsClientData& clientData, BaseLib::PArray& parameters);
+		BaseLib::PVariable nodeEvents(PFlowsClientData& clientData, BaseLib::PArray& parameters);
 	// }}}
 };
 
@@ -426,6 +426,36 @@ int32_t NodeManager::loadNode(std::string nodeNamespace, std::string type, std::
     return -1;
 }
 
+bool NodeManager::preloadNode(const std::string& nodeNamespace, const std::string& type)
+{
+	try
+	{
+		std::string path(GD::bl->settings.flowsPath() + "nodes/" + nodeNamespace + "/" + type + ".so");
+		if(!BaseLib::Io::fileExists(path)) return false;
+
+		std::lock_guard<std::mutex> nodeLoadersGuard(_nodeLoadersMutex);
+		if(_nodeLoaders.find(nodeNamespace + "." + type) != _nodeLoaders.end()) return true;
+		GD::out.printInfo("Info: Preloading node " + type + ".so");
+		std::unique_ptr<NodeLoader> nodeLoader(new NodeLoader(nodeNamespace, type, path));
+		if(!nodeLoader->loaded()) return false; //Don't cache the failed loader, so loadNode() tries again
+		_nodeLoaders.emplace(nodeNamespace + "." + type, std::move(nodeLoader));
+		return true;
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return false;
+}
+
 int32_t NodeManager::unloadNode(std::string id)
 {
 	try
@@ -439,7 +469,12 @@ int32_t NodeManager::unloadNode(std::string id)
 		if(nodesUsageIterator != _nodesUsage.end())
 		{
 			nodesUsageIterator->second->referenceCounter--;
-			if(nodesUsageIterator->second->referenceCounter > 0) return 0;
+			if(nodesUsageIterator->second->referenceCounter > 0)
+			{
+				//Other nodes of this type are still running, so only the node is removed. The loader has to stay loaded until the last node is gone.
+				_nodes.erase(nodesIterator);
+				return 0;
+			}
 		}
 
 		GD::out.printInfo("Info: Unloading node " + id);
@@ -50,6 +50,11 @@ public:
 	virtual ~NodeLoader();
 
 	Flows::PINode createNode(const std::atomic_bool* nodeEventsEnabled);
+
+	/**
+	 * Returns true when the library was opened and its node factory was created.
+	 */
+	bool loaded() { return (bool)_factory; }
 private:
 	std::string _filename;
 	std::string _path;
@@ -106,6 +111,14 @@ public:
 	 */
 	int32_t loadNode(std::string nodeNamespace, std::string type, std::string id, Flows::PINode& node);
 
+	/**
+	 * Opens the library of a C++ node without creating a node instance, so later calls to loadNode() don't need to load it. Does nothing for PHP nodes.
+	 * @param nodeNamespace The namespace of the node.
+	 * @param type The type of the node.
+	 * @return Returns true when the library is loaded.
+	 */
+	bool preloadNode(const std::string& nodeNamespace, const std::string& type);
+
 	/**
 	 * Unloads a previously loaded node.
 	 * @param id The id of the node (e. g. 142947a.387ef34ad).
@@ -49,6 +49,7 @@ std::unique_ptr<CLI::Server> GD::cliServer;
 int32_t GD::rpcLogLevel = 1;
 BaseLib::Rpc::ServerInfo GD::serverInfo;
 Rpc::ClientSettings GD::clientSettings;
+Rpc::ResponseCache GD::responseCache;
 std::map<int32_t, std::unique_ptr<BaseLib::Licensing::Licensing>> GD::licensingModules;
 std::unique_ptr<UPnP> GD::uPnP(new UPnP());
 std::unique_ptr<Mqtt> GD::mqtt;
@@ -43,6 +43,7 @@
 #include <homegear-base/BaseLib.h>
 #include "../RPC/Server.h"
 #include "../RPC/Client.h"
+#include "../RPC/ResponseCache.h"
 #include "../MQTT/Mqtt.h"
 
 #include <vector>
@@ -79,6 +80,7 @@ public:
 	static std::unique_ptr<CLI::Server> cliServer;
 	static BaseLib::Rpc::ServerInfo serverInfo;
 	static Rpc::ClientSettings clientSettings;
+	static Rpc::ResponseCache responseCache;
 	static int32_t rpcLogLevel;
 	static std::map<int32_t, std::unique_ptr<BaseLib::Licensing::Licensing>> licensingModules;
 	static std::unique_ptr<UPnP> uPnP;
@@ -110,6 +110,24 @@ void Auth::sendBasicUnauthorized(bool binary)
 	}
 }
 
+bool Auth::isVerified(const std::string& authorization)
+{
+	if(_verifiedAuthorization.empty()) return false;
+	if(_verifiedCredentialsVersion != User::credentialsVersion())
+	{
+		//A user was updated or removed since the header was verified. Verify it again.
+		_verifiedAuthorization.clear();
+		return false;
+	}
+	return authorization == _verifiedAuthorization;
+}
+
+void Auth::setVerified(const std::string& authorization, uint64_t credentialsVersion)
+{
+	_verifiedAuthorization = authorization;
+	_verifiedCredentialsVersion = credentialsVersion;
+}
+
 bool Auth::basicServer(std::shared_ptr<BaseLib::Rpc::RpcHeader>& binaryHeader)
 {
 	if(!_initialized) throw AuthException("Not initialized.");
@@ -119,6 +137,7 @@ bool Auth::basicServer(std::shared_ptr<BaseLib::Rpc::RpcHeader>& binaryHeader)
 		sendBasicUnauthorized(true);
 		throw AuthException("No header field \"Authorization\"");
 	}
+	if(isVerified(binaryHeader->authorization)) return true;
 	std::pair<std::string, std::string> authData = BaseLib::HelperFunctions::splitLast(binaryHeader->authorization, ' ');
 	BaseLib::HelperFunctions::toLower(authData.first);
 	if(authData.first != "basic")
@@ -135,7 +154,13 @@ bool Auth::basicServer(std::shared_ptr<BaseLib::Rpc::RpcHeader>& binaryHeader)
 		sendBasicUnauthorized(true);
 		throw AuthException("User name " + credentials.first + " is not in the list of valid users in /etc/homegear/rpcservers.conf.");
 	}
-	if(User::verify(credentials.first, credentials.second)) return true;
+	uint64_t credentialsVersion = User::credentialsVersion();
+	if(User::verify(credentials.first, credentials.second))
+	{
+		setVerified(binaryHeader->authorization, credentialsVersion);
+		return true;
+	}
+	_verifiedAuthorization.clear();
 	sendBasicUnauthorized(true);
 	return false;
 }
@@ -186,6 +211,7 @@ bool Auth::basicServer(BaseLib::Http& httpPacket)
 		sendBasicUnauthorized(false);
 		throw AuthException("No header field \"Authorization\"");
 	}
+	if(isVerified(_http.getHeader().authorization)) return true;
 	std::pair<std::string, std::string> authData = BaseLib::HelperFunctions::splitLast(_http.getHeader().authorization, ' ');
 	BaseLib::HelperFunctions::toLower(authData.first);
 	if(authData.first != "basic")
@@ -202,7 +228,13 @@ bool Auth::basicServer(BaseLib::Http& httpPacket)
 		sendBasicUnauthorized(false);
 		throw AuthException("User name " + credentials.first + " is not in the list of valid users in /etc/homegear/rpcservers.conf.");
 	}
-	if(User::verify(credentials.first, credentials.second)) return true;
+	uint64_t credentialsVersion = User::credentialsVersion();
+	if(User::verify(credentials.first, credentials.second))
+	{
+		setVerified(_http.getHeader().authorization, credentialsVersion);
+		return true;
+	}
+	_verifiedAuthorization.clear();
 	sendBasicUnauthorized(false);
 	return false;
 }
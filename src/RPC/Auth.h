@@ -66,6 +66,13 @@ public:
 	void sendWebSocketAuthorized();
 	void sendWebSocketUnauthorized(std::string reason);
 protected:
+	/**
+	 * Checks if "authorization" equals the last successfully verified authorization header of this connection. The header is
+	 * verified again after any user was updated or removed since then, so changed credentials also apply to open connections.
+	 */
+	bool isVerified(const std::string& authorization);
+	void setVerified(const std::string& authorization, uint64_t credentialsVersion);
+
 	bool _initialized = false;
 	std::string _hostname;
 	std::shared_ptr<BaseLib::TcpSocket> _socket;
@@ -76,6 +83,8 @@ protected:
 	std::string _userName;
 	std::string _password;
 	std::pair<std::string, std::string> _basicAuthString;
+	std::string _verifiedAuthorization;
+	uint64_t _verifiedCredentialsVersion = 0;
 	BaseLib::Http _http;
 	std::shared_ptr<BaseLib::Rpc::RpcEncoder> _rpcEncoder;
 	std::shared_ptr<BaseLib::Rpc::JsonDecoder> _jsonDecoder;
@@ -35,7 +35,7 @@
 
 namespace Rpc
 {
-Client::Client()
+Client::Client() : _eventHistory(_eventHistorySize)
 {
 	_lifetick1.first = 0;
 	_lifetick1.second = true;
@@ -135,20 +135,17 @@ BaseLib::PVariable Client::getLastEvents(std::set<uint64_t> ids, uint32_t timesp
 		int64_t minTime = BaseLib::HelperFunctions::getTime() - timespan;
 		BaseLib::PVariable events = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
 
-		std::lock_guard<std::mutex> eventBufferGuard(_eventBufferMutex);
-		for(int32_t i = _eventBufferPosition - 1; i != _eventBufferPosition; i--)
+		std::vector<EventHistory::PEntry> entries = _eventHistory.get(ids, minTime);
+		events->arrayValue->reserve(entries.size());
+		for(auto& info : entries)
 		{
-			if(i < 0) i = _eventBuffer.size() - 1;
-			EventInfo& info = _eventBuffer.at(i);
-			if(info.time < minTime) break;
-			if(!ids.empty() && ids.find(info.id) == ids.end()) continue;
 			BaseLib::PVariable event = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
-			event->structValue->insert(BaseLib::StructElement("TIME", std::make_shared<BaseLib::Variable>((int32_t)(info.time / 1000))));
-			event->structValue->insert(BaseLib::StructElement("UNIQUEID", std::make_shared<BaseLib::Variable>(info.uniqueId)));
-			event->structValue->insert(BaseLib::StructElement("PEERID", std::make_shared<BaseLib::Variable>(info.id)));
-			event->structValue->insert(BaseLib::StructElement("CHANNEL", std::make_shared<BaseLib::Variable>(info.channel)));
-			event->structValue->insert(BaseLib::StructElement("VARIABLE", std::make_shared<BaseLib::Variable>(info.name)));
-			event->structValue->insert(BaseLib::StructElement("VALUE", info.value));
+			event->structValue->insert(BaseLib::StructElement("TIME", std::make_shared<BaseLib::Variable>((int32_t)(info->time / 1000))));
+			event->structValue->insert(BaseLib::StructElement("UNIQUEID", std::make_shared<BaseLib::Variable>(info->uniqueId)));
+			event->structValue->insert(BaseLib::StructElement("PEERID", std::make_shared<BaseLib::Variable>(info->id)));
+			event->structValue->insert(BaseLib::StructElement("CHANNEL", std::make_shared<BaseLib::Variable>(info->channel)));
+			event->structValue->insert(BaseLib::StructElement("VARIABLE", std::make_shared<BaseLib::Variable>(info->name)));
+			event->structValue->insert(BaseLib::StructElement("VALUE", info->value));
 			events->arrayValue->push_back(event);
 		}
 		return events;
@@ -172,18 +169,7 @@ BaseLib::PVariable Client::getNodeEvents()
 {
 	try
 	{
-		BaseLib::PVariable events = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
-		std::lock_guard<std::mutex> nodeEventCacheGuard(_nodeEventCacheMutex);
-		for(auto& nodeIterator : _nodeEventCache)
-		{
-			BaseLib::PVariable node = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
-			for(auto& topicIterator : nodeIterator.second)
-			{
-				node->structValue->emplace(topicIterator.first, topicIterator.second);
-			}
-			events->structValue->emplace(nodeIterator.first, node);
-		}
-		return events;
+		return _nodeEventCache.get();
 	}
 	catch(const std::exception& ex)
 	{
@@ -200,10 +186,44 @@ BaseLib::PVariable Client::getNodeEvents()
 	return BaseLib::Variable::createError(-32500, "Unknown application error. See error log for more details.");
 }
 
+BaseLib::PVariable Client::getNodeEventCacheInfo()
+{
+	return _nodeEventCache.getInfo();
+}
+
 void Client::broadcastNodeEvent(std::string& nodeId, std::string& topic, BaseLib::PVariable& value)
 {
 	try
 	{
+		BaseLib::PVariable event = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
+		event->arrayValue->reserve(3);
+		event->arrayValue->push_back(std::make_shared<BaseLib::Variable>(nodeId));
+		event->arrayValue->push_back(std::make_shared<BaseLib::Variable>(topic));
+		event->arrayValue->push_back(value);
+		BaseLib::PArray events = std::make_shared<BaseLib::Array>();
+		events->push_back(event);
+		broadcastNodeEvents(events);
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
+void Client::broadcastNodeEvents(BaseLib::PArray& events)
+{
+	try
+	{
+		if(events->empty()) return;
+
 		if(!GD::bl->booting)
 		{
 			std::lock_guard<std::mutex> serversGuard(_serversMutex);
@@ -213,26 +233,54 @@ void Client::broadcastNodeEvent(std::string& nodeId, std::string& topic, BaseLib
 				if(server->second->removed || (!server->second->socket->connected() && server->second->keepAlive && !server->second->reconnectInfinitely) || (!server->second->initialized && BaseLib::HelperFunctions::getTimeSeconds() - server->second->creationTime > 120)) continue;
 				if(server->second->webSocket || server->second->json)
 				{
-					std::shared_ptr<std::list<BaseLib::PVariable>> parameters = std::make_shared<std::list<BaseLib::PVariable>>();
-					parameters->push_back(std::make_shared<BaseLib::Variable>(nodeId));
-					parameters->push_back(std::make_shared<BaseLib::Variable>(topic));
-					parameters->push_back(value);
-					server->second->queueMethod(std::make_shared<std::pair<std::string, std::shared_ptr<BaseLib::List>>>("nodeEvent", parameters));
+					uint32_t allowed = server->second->takeNodeEventBudget(events->size());
+					if(allowed == 0) continue;
+
+					BaseLib::PVariable serverEvents = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
+					if(allowed == events->size()) *serverEvents->arrayValue = *events;
+					else
+					{
+						//Prefer events the user is waiting for (like debug output) over highlighting.
+						serverEvents->arrayValue->reserve(allowed);
+						for(int32_t highlight = 0; highlight < 2 && serverEvents->arrayValue->size() < allowed; highlight++)
+						{
+							for(auto& event : *events)
+							{
+								if(serverEvents->arrayValue->size() >= allowed) break;
+								std::string& topic = event->arrayValue->at(1)->stringValue;
+								bool isHighlight = topic.compare(0, 14, "highlightNode/") == 0 || topic.compare(0, 14, "highlightLink/") == 0;
+								if(isHighlight == (bool)highlight) serverEvents->arrayValue->push_back(event);
+							}
+						}
+					}
+
+					if(server->second->nodeEventBatches)
+					{
+						std::shared_ptr<std::list<BaseLib::PVariable>> parameters = std::make_shared<std::list<BaseLib::PVariable>>();
+						parameters->push_back(serverEvents);
+						server->second->queueMethod(std::make_shared<std::pair<std::string, std::shared_ptr<BaseLib::List>>>("nodeEvents", parameters));
+					}
+					else
+					{
+						//Frontends not supporting batches get one "nodeEvent" call per event.
+						for(auto& event : *serverEvents->arrayValue)
+						{
+							std::shared_ptr<std::list<BaseLib::PVariable>> parameters = std::make_shared<std::list<BaseLib::PVariable>>();
+							parameters->push_back(event->arrayValue->at(0));
+							parameters->push_back(event->arrayValue->at(1));
+							parameters->push_back(event->arrayValue->at(2));
+							server->second->queueMethod(std::make_shared<std::pair<std::string, std::shared_ptr<BaseLib::List>>>("nodeEvent", parameters));
+						}
+					}
 				}
 			}
 		}
 
+		for(auto& event : *events)
 		{
-			if(topic.compare(0, 14, "highlightNode/") != 0 && topic.compare(0, 14, "highlightLink/") != 0)
-			{
-				std::lock_guard<std::mutex> nodeEventCacheGuard(_nodeEventCacheMutex);
-				_nodeEventCache[nodeId][topic] = value;
-				if(_nodeEventCache.size() > 1000000 || _nodeEventCache[nodeId].size() > 100000)
-				{
-					GD::out.printError("Error: Event cache is full. Clearing it.");
-					_nodeEventCache.clear();
-				}
-			}
+			std::string& topic = event->arrayValue->at(1)->stringValue;
+			if(topic.compare(0, 14, "highlightNode/") == 0 || topic.compare(0, 14, "highlightLink/") == 0) continue;
+			_nodeEventCache.set(event->arrayValue->at(0)->stringValue, topic, event->arrayValue->at(2));
 		}
 
 		if(!GD::bl->booting && BaseLib::HelperFunctions::getTime() - _lastGarbageCollection > 60000) collectGarbage();
@@ -323,19 +371,10 @@ void Client::broadcastEvent(uint64_t id, int32_t channel, std::string deviceAddr
 			}
 		}
 
+		int64_t time = BaseLib::HelperFunctions::getTime();
 		for(uint32_t i = 0; i < valueKeys->size(); i++)
 		{
-			EventInfo info;
-			info.time = BaseLib::HelperFunctions::getTime();
-			info.uniqueId = _uniqueEventId++;
-			info.id = id;
-			info.channel = channel;
-			info.name = valueKeys->at(i);
-			info.value = values->at(i);
-			std::lock_guard<std::mutex> eventBufferGuard(_eventBufferMutex);
-			_eventBuffer.at(_eventBufferPosition) = std::move(info);
-			_eventBufferPosition++;
-			if(_eventBufferPosition >= (signed)_eventBuffer.size()) _eventBufferPosition = 0;
+			_eventHistory.add(time, _uniqueEventId++, id, channel, valueKeys->at(i), values->at(i));
 		}
 
 		{
@@ -584,6 +623,7 @@ void Client::broadcastNewDevices(BaseLib::PVariable deviceDescriptions)
 	try
 	{
 		if(!deviceDescriptions) return;
+		GD::responseCache.invalidate();
 #ifndef NO_SCRIPTENGINE
 		GD::scriptEngineServer->broadcastNewDevices(deviceDescriptions);
 #endif
@@ -646,6 +686,7 @@ void Client::broadcastDeleteDevices(BaseLib::PVariable deviceAddresses, BaseLib:
 	try
 	{
 		if(!deviceAddresses || !deviceInfo) return;
+		GD::responseCache.invalidate();
 #ifndef NO_SCRIPTENGINE
 		GD::scriptEngineServer->broadcastDeleteDevices(deviceInfo);
 #endif
@@ -712,6 +753,7 @@ void Client::broadcastUpdateDevice(uint64_t id, int32_t channel, std::string add
 	try
 	{
 		if(id == 0 || address.empty()) return;
+		GD::responseCache.invalidate();
 #ifndef NO_SCRIPTENGINE
 		GD::scriptEngineServer->broadcastUpdateDevice(id, channel, hint);
 #endif
@@ -942,7 +984,7 @@ std::shared_ptr<RemoteRpcServer> Client::addServer(std::pair<std::string, std::s
     return std::shared_ptr<RemoteRpcServer>(new RemoteRpcServer(_client));
 }
 
-std::shared_ptr<RemoteRpcServer> Client::addWebSocketServer(std::shared_ptr<BaseLib::TcpSocket> socket, std::string clientId, std::string address, bool nodeEvents)
+std::shared_ptr<RemoteRpcServer> Client::addWebSocketServer(std::shared_ptr<BaseLib::TcpSocket> socket, std::string clientId, std::string address, bool nodeEvents, bool nodeEventBatches)
 {
 	try
 	{
@@ -969,6 +1011,7 @@ std::shared_ptr<RemoteRpcServer> Client::addWebSocketServer(std::shared_ptr<Base
 		server->keepAlive = true;
 		server->subscribePeers = true;
 		server->nodeEvents = nodeEvents;
+		server->nodeEventBatches = nodeEventBatches;
 		server->newFormat = true;
 		if(nodeEvents)
 		{
@@ -38,6 +38,8 @@
 #include <chrono>
 
 #include "RpcClient.h"
+#include "NodeEventCache.h"
+#include "EventHistory.h"
 #include <homegear-base/BaseLib.h>
 
 namespace Rpc
@@ -50,16 +52,6 @@ public:
 		enum Enum { updateHintAll = 0, updateHintLinks = 1 };
 	};
 
-	struct EventInfo
-	{
-		int64_t time = -1;
-		int32_t uniqueId = 0;
-		uint64_t id = 0;
-		int32_t channel = -1;
-		std::string name;
-		BaseLib::PVariable value;
-	};
-
 	Client();
 	virtual ~Client();
 	void dispose();
@@ -69,6 +61,15 @@ public:
 	void disconnectRega();
 	void initServerMethods(std::pair<std::string, std::string> address);
 	void broadcastNodeEvent(std::string& nodeId, std::string& topic, BaseLib::PVariable& value);
+
+	/**
+	 * Sends node events to all frontends. Frontends connected with the WebSocket protocol "nodeclient2" get one "nodeEvents" call with an array of
+	 * events, where each event is an array with the node ID, the topic and the value. Frontends connected with "nodeclient" get one "nodeEvent" call
+	 * per event as before. Frontends that exceeded their rate budget get "highlightNode/" and "highlightLink/" events dropped first.
+	 *
+	 * @param events The node events to send.
+	 */
+	void broadcastNodeEvents(BaseLib::PArray& events);
 	void broadcastEvent(uint64_t id, int32_t channel, std::string deviceAddress, std::shared_ptr<std::vector<std::string>> valueKeys, std::shared_ptr<std::vector<BaseLib::PVariable>> values);
 	void systemListMethods(std::pair<std::string, std::string> address);
 	void listDevices(std::pair<std::string, std::string> address);
@@ -82,7 +83,7 @@ public:
 	void sendUnknownDevices(std::pair<std::string, std::string> address);
 	void sendError(std::pair<std::string, std::string> address, int32_t level, std::string message);
 	std::shared_ptr<RemoteRpcServer> addServer(std::pair<std::string, std::string> address, std::string path, std::string id);
-	std::shared_ptr<RemoteRpcServer> addWebSocketServer(std::shared_ptr<BaseLib::TcpSocket> socket, std::string clientId, std::string address, bool nodeEvents);
+	std::shared_ptr<RemoteRpcServer> addWebSocketServer(std::shared_ptr<BaseLib::TcpSocket> socket, std::string clientId, std::string address, bool nodeEvents, bool nodeEventBatches);
 	void removeServer(std::pair<std::string, std::string> address);
 	void removeServer(int32_t uid);
 	std::shared_ptr<RemoteRpcServer> getServer(std::pair<std::string, std::string>);
@@ -92,6 +93,11 @@ public:
 
 	BaseLib::PVariable getLastEvents(std::set<uint64_t> ids, uint32_t timespan);
 	BaseLib::PVariable getNodeEvents();
+
+	/**
+	 * Returns size and eviction statistics of the node event cache.
+	 */
+	BaseLib::PVariable getNodeEventCacheInfo();
 private:
 	bool _disposing = false;
 	std::shared_ptr<RpcClient> _client;
@@ -103,13 +109,11 @@ private:
 	std::unique_ptr<BaseLib::Rpc::JsonEncoder> _jsonEncoder;
 	std::mutex _lifetick1Mutex;
 	std::pair<int64_t, bool> _lifetick1;
-	std::mutex _eventBufferMutex;
-	int32_t _eventBufferPosition = 0;
+	static const uint32_t _eventHistorySize = 16384;
 	std::atomic_int _uniqueEventId;
-	std::array<EventInfo, 1024> _eventBuffer;
+	EventHistory _eventHistory;
 	int64_t _lastGarbageCollection = 0;
-	std::mutex _nodeEventCacheMutex;
-	std::unordered_map<std::string, std::unordered_map<std::string, BaseLib::PVariable>> _nodeEventCache;
+	NodeEventCache _nodeEventCache;
 
 	void collectGarbage();
 	std::string getIPAddress(std::string address);
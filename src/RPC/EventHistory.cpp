@@ -0,0 +1,159 @@
+/* Copyright 2013-2017 Sathya Laufer
+ *
+ * Homegear is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * 
+ * Homegear is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Homegear.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * 
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU Lesser General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+*/
+
+#include "EventHistory.h"
+#include "../GD/GD.h"
+
+#include <algorithm>
+
+namespace Rpc
+{
+EventHistory::EventHistory(uint32_t size)
+{
+	if(size == 0) size = 1;
+	_ring.resize(size);
+	_lastPeerSequences = std::make_shared<const PeerSequences>();
+}
+
+EventHistory::PEntry EventHistory::getEntry(uint64_t sequence)
+{
+	if(sequence == 0) return PEntry();
+	//Not lock-free: atomic_load() on a shared_ptr takes one of the standard library's internal mutexes for this slot.
+	PEntry entry = std::atomic_load(&_ring.at(sequence % _ring.size()));
+	//The slot was overwritten by a newer event or not written yet.
+	if(!entry || entry->sequence != sequence) return PEntry();
+	return entry;
+}
+
+void EventHistory::add(int64_t time, int32_t uniqueId, uint64_t id, int32_t channel, const std::string& name, const BaseLib::PVariable& value)
+{
+	try
+	{
+		std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+		entry->time = time;
+		entry->uniqueId = uniqueId;
+		entry->id = id;
+		entry->channel = channel;
+		entry->name = name;
+		entry->value = value;
+
+		std::lock_guard<std::mutex> writeGuard(_writeMutex);
+		std::shared_ptr<std::atomic<uint64_t>> lastPeerSequence;
+		std::shared_ptr<const PeerSequences> lastPeerSequences = std::atomic_load(&_lastPeerSequences);
+		auto lastPeerSequenceIterator = lastPeerSequences->find(id);
+		if(lastPeerSequenceIterator == lastPeerSequences->end())
+		{
+			//New peer: Publish a copy of the map, so readers can keep using the old one without locking.
+			std::shared_ptr<PeerSequences> newLastPeerSequences = std::make_shared<PeerSequences>(*lastPeerSequences);
+			lastPeerSequence = std::make_shared<std::atomic<uint64_t>>(0);
+			newLastPeerSequences->emplace(id, lastPeerSequence);
+			std::atomic_store(&_lastPeerSequences, std::shared_ptr<const PeerSequences>(newLastPeerSequences));
+		}
+		else lastPeerSequence = lastPeerSequenceIterator->second;
+
+		entry->sequence = _sequence + 1;
+		uint64_t previousPeerSequence = *lastPeerSequence;
+		//Only link to entries still in the ring.
+		if(previousPeerSequence + _ring.size() > entry->sequence) entry->previousPeerSequence = previousPeerSequence;
+		PEntry constEntry = entry;
+		std::atomic_store(&_ring.at(entry->sequence % _ring.size()), constEntry);
+		//Set after the slot is written, so readers never get a sequence number whose entry isn't in the ring yet.
+		*lastPeerSequence = entry->sequence;
+		_sequence = entry->sequence;
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+
+std::vector<EventHistory::PEntry> EventHistory::get(const std::set<uint64_t>& ids, int64_t minTime)
+{
+	std::vector<PEntry> entries;
+	try
+	{
+		if(!ids.empty() && ids.size() <= _maxIndexedPeers)
+		{
+			std::vector<uint64_t> sequences;
+			sequences.reserve(ids.size());
+			std::shared_ptr<const PeerSequences> lastPeerSequences = std::atomic_load(&_lastPeerSequences);
+			for(auto id : ids)
+			{
+				auto sequenceIterator = lastPeerSequences->find(id);
+				if(sequenceIterator != lastPeerSequences->end()) sequences.push_back(*sequenceIterator->second);
+			}
+
+			for(auto sequence : sequences)
+			{
+				PEntry entry = getEntry(sequence);
+				while(entry && entry->time >= minTime)
+				{
+					entries.push_back(entry);
+					entry = getEntry(entry->previousPeerSequence);
+				}
+			}
+			std::sort(entries.begin(), entries.end(), [](const PEntry& a, const PEntry& b) { return a->sequence > b->sequence; });
+			return entries;
+		}
+
+		uint64_t sequence = _sequence;
+		uint64_t endSequence = sequence > _ring.size() ? sequence - _ring.size() : 0;
+		for(; sequence > endSequence; sequence--)
+		{
+			PEntry entry = getEntry(sequence);
+			//Writers lapped the reader. All older entries are gone, too.
+			if(!entry || entry->time < minTime) break;
+			if(!ids.empty() && ids.find(entry->id) == ids.end()) continue;
+			entries.push_back(entry);
+		}
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+	return entries;
+}
+}
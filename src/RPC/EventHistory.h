@@ -0,0 +1,102 @@
+/* Copyright 2013-2017 Sathya Laufer
+ *
+ * Homegear is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * 
+ * Homegear is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Homegear.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * 
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU Lesser General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+*/
+
+#ifndef EVENTHISTORY_H_
+#define EVENTHISTORY_H_
+
+#include <homegear-base/BaseLib.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Rpc
+{
+/**
+ * Ring buffer of the last variable changes used by "getLastEvents". Readers of all peers don't take the writer lock,
+ * but the slots are accessed with std::atomic_load/std::atomic_store on shared_ptr, which is not lock-free: the
+ * standard library guards these calls with a small pool of internal mutexes. Contention is limited to single slot
+ * accesses, though, and readers never wait for a writer to finish a whole insert. Every entry stores its sequence
+ * number, so a reader can detect slots that were overwritten while it was reading. Entries of the same peer are
+ * linked by sequence number, which lets readers asking for a few peers skip all other entries. The newest sequence
+ * number of each peer is kept in a per-peer atomic. The map of these atomics is copied and swapped only when a new
+ * peer appears, so readers never take the writer lock either.
+ */
+class EventHistory
+{
+public:
+	struct Entry
+	{
+		uint64_t sequence = 0;
+		uint64_t previousPeerSequence = 0;
+		int64_t time = 0;
+		int32_t uniqueId = 0;
+		uint64_t id = 0;
+		int32_t channel = -1;
+		std::string name;
+		BaseLib::PVariable value;
+	};
+	typedef std::shared_ptr<const Entry> PEntry;
+
+	/**
+	 * @param size The number of events to keep.
+	 */
+	EventHistory(uint32_t size);
+	virtual ~EventHistory() {}
+
+	void add(int64_t time, int32_t uniqueId, uint64_t id, int32_t channel, const std::string& name, const BaseLib::PVariable& value);
+
+	/**
+	 * Returns all events newer than "minTime" ordered from newest to oldest.
+	 *
+	 * @param ids The peers to return events for. When empty, events of all peers are returned.
+	 * @param minTime The minimum event time in milliseconds.
+	 */
+	std::vector<PEntry> get(const std::set<uint64_t>& ids, int64_t minTime);
+private:
+	//Up to this number of requested peers, the per-peer links are used instead of scanning the whole ring.
+	const size_t _maxIndexedPeers = 16;
+	std::vector<PEntry> _ring;
+	std::atomic<uint64_t> _sequence{0};
+
+	typedef std::unordered_map<uint64_t, std::shared_ptr<std::atomic<uint64_t>>> PeerSequences;
+
+	std::mutex _writeMutex;
+	//Accessed with std::atomic_load/std::atomic_store. Only replaced while _writeMutex is locked.
+	std::shared_ptr<const PeerSequences> _lastPeerSequences;
+
+	PEntry getEntry(uint64_t sequence);
+};
+}
+#endif
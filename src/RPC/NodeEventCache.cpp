@@ -0,0 +1,200 @@
+/* Copyright 2013-2017 Sathya Laufer
+ *
+ * Homegear is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * 
+ * Homegear is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Homegear.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * 
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU Lesser General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+*/
+
+#include "NodeEventCache.h"
+#include "../GD/GD.h"
+
+namespace Rpc
+{
+size_t NodeEventCache::getSize(const BaseLib::PVariable& value)
+{
+	if(!value) return 0;
+	size_t size = sizeof(BaseLib::Variable) + value->stringValue.size() + value->binaryValue.size();
+	if(value->type == BaseLib::VariableType::tArray)
+	{
+		for(auto& element : *value->arrayValue)
+		{
+			size += getSize(element);
+		}
+	}
+	else if(value->type == BaseLib::VariableType::tStruct)
+	{
+		for(auto& element : *value->structValue)
+		{
+			size += element.first.size() + getSize(element.second);
+		}
+	}
+	return size;
+}
+
+void NodeEventCache::evict(std::unordered_map<std::string, NodeEntry>::iterator nodeIterator)
+{
+	NodeEntry& node = nodeIterator->second;
+	if(!node.topicLru.empty())
+	{
+		auto topicIterator = node.topics.find(node.topicLru.back());
+		if(topicIterator != node.topics.end())
+		{
+			_size -= topicIterator->second.size;
+			node.topics.erase(topicIterator);
+			_topicCount--;
+			_evictions++;
+		}
+		node.topicLru.pop_back();
+	}
+	if(node.topics.empty())
+	{
+		_nodeLru.erase(node.lruPosition);
+		_nodes.erase(nodeIterator);
+	}
+}
+
+void NodeEventCache::set(const std::string& nodeId, const std::string& topic, const BaseLib::PVariable& value)
+{
+	try
+	{
+		size_t size = nodeId.size() + topic.size() + getSize(value);
+		if(size > _maxSize) return;
+
+		std::lock_guard<std::mutex> cacheGuard(_cacheMutex);
+		auto nodeIterator = _nodes.find(nodeId);
+		if(nodeIterator == _nodes.end())
+		{
+			nodeIterator = _nodes.emplace(nodeId, NodeEntry()).first;
+			_nodeLru.push_front(nodeId);
+			nodeIterator->second.lruPosition = _nodeLru.begin();
+		}
+		else _nodeLru.splice(_nodeLru.begin(), _nodeLru, nodeIterator->second.lruPosition);
+
+		NodeEntry& node = nodeIterator->second;
+		auto topicIterator = node.topics.find(topic);
+		if(topicIterator == node.topics.end())
+		{
+			if(node.topics.size() >= _maxTopicsPerNode) evict(nodeIterator);
+			topicIterator = node.topics.emplace(topic, TopicEntry()).first;
+			node.topicLru.push_front(topic);
+			topicIterator->second.lruPosition = node.topicLru.begin();
+			_topicCount++;
+		}
+		else
+		{
+			node.topicLru.splice(node.topicLru.begin(), node.topicLru, topicIterator->second.lruPosition);
+			_size -= topicIterator->second.size;
+		}
+		topicIterator->second.value = value;
+		topicIterator->second.size = size;
+		_size += size;
+
+		//The node updated last is at the front of _nodeLru, so this never evicts the topic just set while other nodes are left.
+		while(_size > _maxSize && !_nodeLru.empty())
+		{
+			auto lruNodeIterator = _nodes.find(_nodeLru.back());
+			if(lruNodeIterator == _nodes.end())
+			{
+				_nodeLru.pop_back();
+				continue;
+			}
+			evict(lruNodeIterator);
+		}
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+
+BaseLib::PVariable NodeEventCache::get()
+{
+	try
+	{
+		BaseLib::PVariable events = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
+		std::lock_guard<std::mutex> cacheGuard(_cacheMutex);
+		for(auto& nodeIterator : _nodes)
+		{
+			BaseLib::PVariable node = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
+			for(auto& topicIterator : nodeIterator.second.topics)
+			{
+				node->structValue->emplace(topicIterator.first, topicIterator.second.value);
+			}
+			events->structValue->emplace(nodeIterator.first, node);
+		}
+		return events;
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+	return BaseLib::Variable::createError(-32500, "Unknown application error. See error log for more details.");
+}
+
+BaseLib::PVariable NodeEventCache::getInfo()
+{
+	try
+	{
+		BaseLib::PVariable info = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
+		std::lock_guard<std::mutex> cacheGuard(_cacheMutex);
+		info->structValue->emplace("nodes", std::make_shared<BaseLib::Variable>((uint64_t)_nodes.size()));
+		info->structValue->emplace("topics", std::make_shared<BaseLib::Variable>((uint64_t)_topicCount));
+		info->structValue->emplace("size", std::make_shared<BaseLib::Variable>((uint64_t)_size));
+		info->structValue->emplace("maxSize", std::make_shared<BaseLib::Variable>((uint64_t)_maxSize));
+		info->structValue->emplace("evictions", std::make_shared<BaseLib::Variable>((uint64_t)_evictions));
+		return info;
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+	return BaseLib::Variable::createError(-32500, "Unknown application error. See error log for more details.");
+}
+}
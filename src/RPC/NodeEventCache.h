@@ -0,0 +1,101 @@
+/* Copyright 2013-2017 Sathya Laufer
+ *
+ * Homegear is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * 
+ * Homegear is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Homegear.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * 
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU Lesser General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+*/
+
+#ifndef NODEEVENTCACHE_H_
+#define NODEEVENTCACHE_H_
+
+#include <homegear-base/BaseLib.h>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Rpc
+{
+/**
+ * Stores the latest value of every node event topic, so frontends can restore the node status after connecting. The
+ * cache is limited in the number of topics per node and in its total size. When a limit is reached, the least recently
+ * updated topics are evicted (first of the node itself, for the total size of the least recently updated node).
+ */
+class NodeEventCache
+{
+public:
+	NodeEventCache() {}
+	virtual ~NodeEventCache() {}
+
+	void set(const std::string& nodeId, const std::string& topic, const BaseLib::PVariable& value);
+
+	/**
+	 * Returns all cached events as a struct with the node IDs as keys. Each node contains a struct with the topics as keys.
+	 */
+	BaseLib::PVariable get();
+
+	/**
+	 * Returns the number of nodes and topics, the estimated size in bytes and the number of evicted topics.
+	 */
+	BaseLib::PVariable getInfo();
+private:
+	struct TopicEntry
+	{
+		BaseLib::PVariable value;
+		size_t size = 0;
+		std::list<std::string>::iterator lruPosition;
+	};
+
+	struct NodeEntry
+	{
+		std::unordered_map<std::string, TopicEntry> topics;
+		std::list<std::string> topicLru;
+		std::list<std::string>::iterator lruPosition;
+	};
+
+	const size_t _maxTopicsPerNode = 1000;
+	const size_t _maxSize = 16 * 1024 * 1024;
+	std::mutex _cacheMutex;
+	std::unordered_map<std::string, NodeEntry> _nodes;
+	std::list<std::string> _nodeLru;
+	size_t _size = 0;
+	size_t _topicCount = 0;
+	std::atomic<uint64_t> _evictions{0};
+
+	/**
+	 * Estimates the memory used by a variable.
+	 */
+	static size_t getSize(const BaseLib::PVariable& value);
+
+	/**
+	 * Removes the least recently updated topic of a node. Removes the node when it has no topics left. _cacheMutex must be locked.
+	 */
+	void evict(std::unordered_map<std::string, NodeEntry>::iterator nodeIterator);
+};
+}
+#endif
@@ -112,10 +112,19 @@ BaseLib::PVariable RPCSystemListMethods::invoke(BaseLib::PRpcClientInfo clientIn
 		if(!parameters->empty()) return getError(ParameterError::Enum::wrongCount);
 
 		BaseLib::PVariable methodInfo(new BaseLib::Variable(BaseLib::VariableType::tArray));
-		std::shared_ptr<std::map<std::string, std::shared_ptr<RpcMethod>>> methods = _server->getMethods();
-		for(std::map<std::string, std::shared_ptr<RpcMethod>>::iterator i = methods->begin(); i != methods->end(); ++i)
+		std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<RpcMethod>>> methods = _server->getMethods();
+		//The methods are stored in a hash map, so sort the names to keep the output stable.
+		std::vector<std::string> methodNames;
+		methodNames.reserve(methods->size());
+		for(std::unordered_map<std::string, std::shared_ptr<RpcMethod>>::iterator i = methods->begin(); i != methods->end(); ++i)
 		{
-			methodInfo->arrayValue->push_back(BaseLib::PVariable(new BaseLib::Variable(i->first)));
+			methodNames.push_back(i->first);
+		}
+		std::sort(methodNames.begin(), methodNames.end());
+		methodInfo->arrayValue->reserve(methodNames.size());
+		for(auto& methodName : methodNames)
+		{
+			methodInfo->arrayValue->push_back(std::make_shared<BaseLib::Variable>(methodName));
 		}
 		std::unordered_map<std::string, std::shared_ptr<RpcMethod>> ipcMethods = GD::ipcServer->getRpcMethods();
 		for (auto& method : ipcMethods)
@@ -149,7 +158,7 @@ BaseLib::PVariable RPCSystemMethodHelp::invoke(BaseLib::PRpcClientInfo clientInf
 
 		BaseLib::PVariable help;
 
-		std::shared_ptr<std::map<std::string, std::shared_ptr<RpcMethod>>> methods = _server->getMethods();
+		std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<RpcMethod>>> methods = _server->getMethods();
 		auto methodIterator = methods->find(parameters->at(0)->stringValue);
 		if (methodIterator == methods->end())
 		{
@@ -188,7 +197,7 @@ BaseLib::PVariable RPCSystemMethodSignature::invoke(BaseLib::PRpcClientInfo clie
 
 		BaseLib::PVariable signature;
 
-		std::shared_ptr<std::map<std::string, std::shared_ptr<RpcMethod>>> methods = _server->getMethods();
+		std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<RpcMethod>>> methods = _server->getMethods();
 		auto methodIterator = methods->find(parameters->at(0)->stringValue);
 		if (methodIterator == methods->end())
 		{
@@ -197,7 +206,7 @@ BaseLib::PVariable RPCSystemMethodSignature::invoke(BaseLib::PRpcClientInfo clie
 			if (methodIterator2 == ipcMethods.end()) return BaseLib::Variable::createError(-32602, "Method not found.");
 			signature = methodIterator2->second->getSignature();
 		}
-		else signature = _server->getMethods()->at(parameters->at(0)->stringValue)->getSignature();
+		else signature = methodIterator->second->getSignature();
 
 		if(!signature) signature.reset(new BaseLib::Variable(BaseLib::VariableType::tArray));
 
@@ -231,8 +240,9 @@ BaseLib::PVariable RPCSystemMulticall::invoke(BaseLib::PRpcClientInfo clientInfo
 		ParameterError::Enum error = checkParameters(parameters, std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tArray }));
 		if(error != ParameterError::Enum::noError) return getError(error);
 
-		std::shared_ptr<std::map<std::string, std::shared_ptr<RpcMethod>>> methods = _server->getMethods();
+		std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<RpcMethod>>> methods = _server->getMethods();
 		BaseLib::PVariable returns(new BaseLib::Variable(BaseLib::VariableType::tArray));
+		returns->arrayValue->reserve(parameters->at(0)->arrayValue->size());
 		for(std::vector<BaseLib::PVariable>::iterator i = parameters->at(0)->arrayValue->begin(); i != parameters->at(0)->arrayValue->end(); ++i)
 		{
 			if((*i)->type != BaseLib::VariableType::tStruct)
@@ -255,12 +265,17 @@ BaseLib::PVariable RPCSystemMulticall::invoke(BaseLib::PRpcClientInfo clientInfo
 				returns->arrayValue->push_back(BaseLib::Variable::createError(-32602, "No parameters provided."));
 				continue;
 			}
-			std::string methodName = (*i)->structValue->at("methodName")->stringValue;
+			const std::string& methodName = (*i)->structValue->at("methodName")->stringValue;
 			std::shared_ptr<std::vector<BaseLib::PVariable>> parameters = (*i)->structValue->at("params")->arrayValue;
 
-			if(methodName == "system.multicall") returns->arrayValue->push_back(BaseLib::Variable::createError(-32602, "Recursive calls to system.multicall are not allowed."));
-			else if(methods->find(methodName) == methods->end()) returns->arrayValue->push_back(BaseLib::Variable::createError(-32601, "Requested method not found."));
-			else returns->arrayValue->push_back(methods->at(methodName)->invoke(clientInfo, parameters));
+			if(methodName == "system.multicall")
+			{
+				returns->arrayValue->push_back(BaseLib::Variable::createError(-32602, "Recursive calls to system.multicall are not allowed."));
+				continue;
+			}
+			auto methodIterator = methods->find(methodName);
+			if(methodIterator == methods->end()) returns->arrayValue->push_back(BaseLib::Variable::createError(-32601, "Requested method not found."));
+			else returns->arrayValue->push_back(methodIterator->second->invoke(clientInfo, parameters));
 		}
 
 		return returns;
@@ -476,6 +491,7 @@ BaseLib::PVariable RPCAddLink::invoke(BaseLib::PRpcClientInfo clientInfo, std::s
 {
 	try
 	{
+		Rpc::ResponseCache::InvalidationGuard responseCacheInvalidationGuard(GD::responseCache);
 		ParameterError::Enum error = checkParameters(parameters, std::vector<std::vector<BaseLib::VariableType>>({
 			std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tString, BaseLib::VariableType::tString }),
 			std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tString, BaseLib::VariableType::tString, BaseLib::VariableType::tString }),
@@ -1145,21 +1161,21 @@ BaseLib::PVariable RPCGetAllValues::invoke(BaseLib::PRpcClientInfo clientInfo, s
 		}
 
 		BaseLib::PVariable values(new BaseLib::Variable(BaseLib::VariableType::tArray));
-		std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>> families = GD::familyController->getFamilies();
-		for(std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>>::iterator i = families.begin(); i != families.end(); ++i)
+		std::map<int32_t, BaseLib::PVariable> results = GD::familyController->callCentrals("getAllValues", [clientInfo, peerID, returnWriteOnly](std::shared_ptr<BaseLib::Systems::ICentral>& central) -> BaseLib::PVariable
 		{
-			std::shared_ptr<BaseLib::Systems::ICentral> central = i->second->getCentral();
-			if(!central) continue;
-			if(peerID > 0 && !central->peerExists(peerID)) continue;
-			std::this_thread::sleep_for(std::chrono::milliseconds(3));
-			BaseLib::PVariable result = central->getAllValues(clientInfo, peerID, returnWriteOnly);
-			if(result && result->errorStruct)
+			if(peerID > 0 && !central->peerExists(peerID)) return BaseLib::PVariable();
+			return central->getAllValues(clientInfo, peerID, returnWriteOnly);
+		});
+		for(std::map<int32_t, BaseLib::PVariable>::iterator i = results.begin(); i != results.end(); ++i)
+		{
+			if(i->second->errorStruct)
 			{
-				if(peerID > 0) return result;
-				else GD::out.printWarning("Warning: Error calling method \"getAllValues\" on device family " + i->second->getName() + ": " + result->structValue->at("faultString")->stringValue);
+				if(peerID > 0) return i->second;
+				std::shared_ptr<BaseLib::Systems::DeviceFamily> family = GD::familyController->getFamily(i->first);
+				GD::out.printWarning("Warning: Error calling method \"getAllValues\" on device family " + (family ? family->getName() : std::to_string(i->first)) + ": " + i->second->structValue->at("faultString")->stringValue);
 				continue;
 			}
-			if(result && !result->arrayValue->empty()) values->arrayValue->insert(values->arrayValue->end(), result->arrayValue->begin(), result->arrayValue->end());
+			if(!i->second->arrayValue->empty()) values->arrayValue->insert(values->arrayValue->end(), i->second->arrayValue->begin(), i->second->arrayValue->end());
 			if(peerID > 0) break;
 		}
 
@@ -2040,6 +2056,34 @@ BaseLib::PVariable RPCGetParamsetDescription::invoke(BaseLib::PRpcClientInfo cli
 		}));
 		if(error != ParameterError::Enum::noError) return getError(error);
 
+		std::string cacheKey = Rpc::ResponseCache::getKey("getParamsetDescription", clientInfo, parameters);
+		uint64_t cacheVersion = GD::responseCache.version();
+		BaseLib::PVariable description = GD::responseCache.get(cacheKey);
+		if(description) return description;
+
+		description = getDescription(clientInfo, parameters);
+		GD::responseCache.set(cacheKey, description, cacheVersion);
+		return description;
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return BaseLib::Variable::createError(-32500, "Unknown application error.");
+}
+
+BaseLib::PVariable RPCGetParamsetDescription::getDescription(BaseLib::PRpcClientInfo& clientInfo, std::shared_ptr<std::vector<BaseLib::PVariable>>& parameters)
+{
+	try
+	{
 		if(parameters->size() == 5)
 		{
 			std::shared_ptr<BaseLib::Systems::DeviceFamily> family = GD::familyController->getFamily(parameters->at(0)->integerValue);
@@ -2361,15 +2405,13 @@ BaseLib::PVariable RPCGetServiceMessages::invoke(BaseLib::PRpcClientInfo clientI
 		if(parameters->size() == 1) id = parameters->at(0)->booleanValue;
 
 		BaseLib::PVariable serviceMessages(new BaseLib::Variable(BaseLib::VariableType::tArray));
-		std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>> families = GD::familyController->getFamilies();
-		for(std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>>::iterator i = families.begin(); i != families.end(); ++i)
+		std::map<int32_t, BaseLib::PVariable> results = GD::familyController->callCentrals("getServiceMessages", [clientInfo, id](std::shared_ptr<BaseLib::Systems::ICentral>& central)
 		{
-			std::shared_ptr<BaseLib::Systems::ICentral> central = i->second->getCentral();
-			if(!central) continue;
-			//getServiceMessages really needs a lot of ressources, so wait a little bit after each central
-			std::this_thread::sleep_for(std::chrono::milliseconds(3));
-			BaseLib::PVariable messages = central->getServiceMessages(clientInfo, id);
-			if(!messages->arrayValue->empty()) serviceMessages->arrayValue->insert(serviceMessages->arrayValue->end(), messages->arrayValue->begin(), messages->arrayValue->end());
+			return central->getServiceMessages(clientInfo, id);
+		});
+		for(std::map<int32_t, BaseLib::PVariable>::iterator i = results.begin(); i != results.end(); ++i)
+		{
+			if(!i->second->arrayValue->empty()) serviceMessages->arrayValue->insert(serviceMessages->arrayValue->end(), i->second->arrayValue->begin(), i->second->arrayValue->end());
 		}
 
 		return serviceMessages;
@@ -2897,23 +2939,30 @@ BaseLib::PVariable RPCListDevices::invoke(BaseLib::PRpcClientInfo clientInfo, st
 			clientInfo->clientType = BaseLib::RpcClientType::homematicconfigurator;
 		}
 
+		std::string cacheKey = Rpc::ResponseCache::getKey("listDevices", clientInfo, parameters);
+		uint64_t cacheVersion = GD::responseCache.version();
+		BaseLib::PVariable cachedResponse = GD::responseCache.get(cacheKey);
+		if(cachedResponse) return cachedResponse;
+
 		BaseLib::PVariable devices(new BaseLib::Variable(BaseLib::VariableType::tArray));
-		std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>> families = GD::familyController->getFamilies();
-		for(std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>>::iterator i = families.begin(); i != families.end(); ++i)
+		bool timedOut = false;
+		std::map<int32_t, BaseLib::PVariable> results = GD::familyController->callCentrals("listDevices", [clientInfo, channels, fields](std::shared_ptr<BaseLib::Systems::ICentral>& central)
 		{
-			if(familyId != -1 && i->first != familyId) continue;
-			std::shared_ptr<BaseLib::Systems::ICentral> central = i->second->getCentral();
-			if(!central) continue;
-			std::this_thread::sleep_for(std::chrono::milliseconds(3));
-			BaseLib::PVariable result = central->listDevices(clientInfo, channels, fields);
-			if(result && result->errorStruct)
+			return central->listDevices(clientInfo, channels, fields);
+		}, familyId, 10000, &timedOut);
+		for(std::map<int32_t, BaseLib::PVariable>::iterator i = results.begin(); i != results.end(); ++i)
+		{
+			if(i->second->errorStruct)
 			{
-				GD::out.printWarning("Warning: Error calling method \"listDevices\" on device family " + i->second->getName() + ": " + result->structValue->at("faultString")->stringValue);
+				std::shared_ptr<BaseLib::Systems::DeviceFamily> family = GD::familyController->getFamily(i->first);
+				GD::out.printWarning("Warning: Error calling method \"listDevices\" on device family " + (family ? family->getName() : std::to_string(i->first)) + ": " + i->second->structValue->at("faultString")->stringValue);
 				continue;
 			}
-			if(result && !result->arrayValue->empty()) devices->arrayValue->insert(devices->arrayValue->end(), result->arrayValue->begin(), result->arrayValue->end());
+			if(!i->second->arrayValue->empty()) devices->arrayValue->insert(devices->arrayValue->end(), i->second->arrayValue->begin(), i->second->arrayValue->end());
 		}
 
+		//Don't cache incomplete device lists.
+		if(!timedOut) GD::responseCache.set(cacheKey, devices, cacheVersion);
 		return devices;
 	}
 	catch(const std::exception& ex)
@@ -3358,6 +3407,7 @@ BaseLib::PVariable RPCRemoveLink::invoke(BaseLib::PRpcClientInfo clientInfo, std
 {
 	try
 	{
+		Rpc::ResponseCache::InvalidationGuard responseCacheInvalidationGuard(GD::responseCache);
 		ParameterError::Enum error = checkParameters(parameters, std::vector<std::vector<BaseLib::VariableType>>({
 				std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tString, BaseLib::VariableType::tString }),
 				std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tInteger, BaseLib::VariableType::tInteger, BaseLib::VariableType::tInteger, BaseLib::VariableType::tInteger })
@@ -3666,10 +3716,14 @@ BaseLib::PVariable RPCSearchDevices::invoke(BaseLib::PRpcClientInfo clientInfo,
 		}
 
 		BaseLib::PVariable result(new BaseLib::Variable(BaseLib::VariableType::tInteger));
-		for(std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>>::iterator i = families.begin(); i != families.end(); ++i)
+		//Searching can take much longer than other calls, so wait up to five minutes.
+		std::map<int32_t, BaseLib::PVariable> results = GD::familyController->callCentrals("searchDevices", [clientInfo](std::shared_ptr<BaseLib::Systems::ICentral>& central)
 		{
-			std::shared_ptr<BaseLib::Systems::ICentral> central = i->second->getCentral();
-			if(central) result->integerValue += central->searchDevices(clientInfo)->integerValue;
+			return central->searchDevices(clientInfo);
+		}, -1, 300000);
+		for(std::map<int32_t, BaseLib::PVariable>::iterator i = results.begin(); i != results.end(); ++i)
+		{
+			result->integerValue += i->second->integerValue;
 		}
 
 		return result;
@@ -3719,6 +3773,7 @@ BaseLib::PVariable RPCSetId::invoke(BaseLib::PRpcClientInfo clientInfo, std::sha
 {
 	try
 	{
+		Rpc::ResponseCache::InvalidationGuard responseCacheInvalidationGuard(GD::responseCache);
 		ParameterError::Enum error = checkParameters(parameters, std::vector<std::vector<BaseLib::VariableType>>({
 			std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tInteger, BaseLib::VariableType::tInteger })
 		}));
@@ -3816,6 +3871,7 @@ BaseLib::PVariable RPCSetInterface::invoke(BaseLib::PRpcClientInfo clientInfo, s
 {
 	try
 	{
+		Rpc::ResponseCache::InvalidationGuard responseCacheInvalidationGuard(GD::responseCache);
 		ParameterError::Enum error = checkParameters(parameters, std::vector<std::vector<BaseLib::VariableType>>({
 				std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tInteger, BaseLib::VariableType::tString })
 		}));
@@ -3852,6 +3908,7 @@ BaseLib::PVariable RPCSetLinkInfo::invoke(BaseLib::PRpcClientInfo clientInfo, st
 {
 	try
 	{
+		Rpc::ResponseCache::InvalidationGuard responseCacheInvalidationGuard(GD::responseCache);
 		ParameterError::Enum error = checkParameters(parameters, std::vector<std::vector<BaseLib::VariableType>>({
 				std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tString, BaseLib::VariableType::tString, BaseLib::VariableType::tString }),
 				std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tString, BaseLib::VariableType::tString, BaseLib::VariableType::tString, BaseLib::VariableType::tString }),
@@ -4009,6 +4066,7 @@ BaseLib::PVariable RPCSetName::invoke(BaseLib::PRpcClientInfo clientInfo, std::s
 {
 	try
 	{
+		Rpc::ResponseCache::InvalidationGuard responseCacheInvalidationGuard(GD::responseCache);
 		ParameterError::Enum error = checkParameters(parameters, std::vector<std::vector<BaseLib::VariableType>>({
 				std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tInteger, BaseLib::VariableType::tString })
 		}));
@@ -4175,6 +4233,7 @@ BaseLib::PVariable RPCSetTeam::invoke(BaseLib::PRpcClientInfo clientInfo, std::s
 {
 	try
 	{
+		Rpc::ResponseCache::InvalidationGuard responseCacheInvalidationGuard(GD::responseCache);
 		ParameterError::Enum error = checkParameters(parameters, std::vector<std::vector<BaseLib::VariableType>>({
 				std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tString }),
 				std::vector<BaseLib::VariableType>({ BaseLib::VariableType::tString, BaseLib::VariableType::tString }),
@@ -539,6 +539,8 @@ public:
 		addSignature(BaseLib::VariableType::tStruct, std::vector<BaseLib::VariableType>{BaseLib::VariableType::tInteger, BaseLib::VariableType::tInteger, BaseLib::VariableType::tInteger, BaseLib::VariableType::tInteger, BaseLib::VariableType::tString});
 	}
 	BaseLib::PVariable invoke(BaseLib::PRpcClientInfo clientInfo, std::shared_ptr<std::vector<BaseLib::PVariable>> parameters);
+private:
+	BaseLib::PVariable getDescription(BaseLib::PRpcClientInfo& clientInfo, std::shared_ptr<std::vector<BaseLib::PVariable>>& parameters);
 };
 
 class RPCGetParamsetId : public BaseLib::Rpc::RpcMethod
@@ -62,7 +62,7 @@ RPCServer::RPCServer()
 
 	_info.reset(new BaseLib::Rpc::ServerInfo::Info());
 	_dummyClientInfo.reset(new BaseLib::RpcClientInfo());
-	_rpcMethods.reset(new std::map<std::string, std::shared_ptr<BaseLib::Rpc::RpcMethod>>);
+	_rpcMethods.reset(new std::unordered_map<std::string, std::shared_ptr<BaseLib::Rpc::RpcMethod>>);
 	_serverFileDescriptor.reset(new BaseLib::FileDescriptor);
 	_threadPriority = GD::bl->settings.rpcServerThreadPriority();
 	_threadPolicy = GD::bl->settings.rpcServerThreadPolicy();
@@ -315,12 +315,10 @@ void RPCServer::registerMethod(std::string methodName, std::shared_ptr<BaseLib::
 {
 	try
 	{
-		if(_rpcMethods->find(methodName) != _rpcMethods->end())
+		if(!_rpcMethods->emplace(methodName, method).second)
 		{
 			_out.printWarning("Warning: Could not register RPC method, because a method with this name already exists.");
-			return;
 		}
-		_rpcMethods->insert(std::pair<std::string, std::shared_ptr<BaseLib::Rpc::RpcMethod>>(methodName, method));
 	}
 	catch(const std::exception& ex)
     {
@@ -530,6 +528,86 @@ void RPCServer::sendRPCResponseToClient(std::shared_ptr<Client> client, std::vec
     }
 }
 
+void RPCServer::sendChunkedJsonResponseToClient(std::shared_ptr<Client> client, BaseLib::PVariable& variable, int32_t messageId, bool keepAlive)
+{
+	try
+	{
+		if(_stopped) return;
+		if(!clientValid(client)) return;
+		if(GD::bl->debugLevel >= 5) _out.printDebug("Debug: Sending chunked response with " + std::to_string(variable->arrayValue->size()) + " elements to client number " + std::to_string(client->id) + ".");
+		bool error = false;
+		try
+		{
+			//Same delays as in sendRPCResponseToClient.
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			if(!keepAlive || client->rpcType != BaseLib::RpcType::binary) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+			std::string header;
+			header.append("HTTP/1.1 200 OK\r\n");
+			header.append("Connection: ");
+			header.append(keepAlive ? "Keep-Alive\r\n" : "close\r\n");
+			header.append("Content-Type: application/json\r\n");
+			header.append("Transfer-Encoding: chunked\r\n\r\n");
+			client->socket->proofwrite(header.data(), header.size());
+
+			//Elements are appended to "chunk" and flushed as soon as it exceeds the chunk size. The key order matches the encoder's
+			//output for the unchunked response.
+			std::vector<char> chunk;
+			chunk.reserve(_responseChunkSize + 1024);
+			std::vector<char> element;
+			std::string prefix = "{\"id\":" + std::to_string(messageId) + ",\"jsonrpc\":\"2.0\",\"result\":[";
+			chunk.insert(chunk.end(), prefix.begin(), prefix.end());
+			for(std::vector<BaseLib::PVariable>::iterator i = variable->arrayValue->begin(); i != variable->arrayValue->end(); ++i)
+			{
+				if(i != variable->arrayValue->begin()) chunk.push_back(',');
+				element.clear();
+				_jsonEncoder->encode(*i, element);
+				//Values other than structs and arrays are encoded wrapped in brackets.
+				if(!*i || (*i)->type == BaseLib::VariableType::tStruct || (*i)->type == BaseLib::VariableType::tArray) chunk.insert(chunk.end(), element.begin(), element.end());
+				else if(element.size() >= 2) chunk.insert(chunk.end(), element.begin() + 1, element.end() - 1);
+				else chunk.insert(chunk.end(), {'n', 'u', 'l', 'l'});
+
+				if(chunk.size() >= _responseChunkSize)
+				{
+					std::string chunkHeader = BaseLib::HelperFunctions::getHexString((int32_t)chunk.size()) + "\r\n";
+					chunk.insert(chunk.begin(), chunkHeader.begin(), chunkHeader.end());
+					chunk.push_back('\r');
+					chunk.push_back('\n');
+					client->socket->proofwrite(chunk);
+					chunk.clear();
+				}
+			}
+			chunk.insert(chunk.end(), {']', '}', '\r', '\n'});
+			std::string chunkHeader = BaseLib::HelperFunctions::getHexString((int32_t)chunk.size()) + "\r\n";
+			chunk.insert(chunk.begin(), chunkHeader.begin(), chunkHeader.end());
+			chunk.insert(chunk.end(), {'\r', '\n', '0', '\r', '\n', '\r', '\n'});
+			client->socket->proofwrite(chunk);
+		}
+		catch(BaseLib::SocketDataLimitException& ex)
+		{
+			_out.printWarning("Warning: " + ex.what());
+		}
+		catch(const BaseLib::SocketOperationException& ex)
+		{
+			_out.printError("Error: " + ex.what());
+			error = true;
+		}
+		if(!keepAlive || error) closeClientConnection(client);
+	}
+    catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
 void RPCServer::analyzeRPC(std::shared_ptr<Client> client, std::vector<char>& packet, PacketType::Enum packetType, bool keepAlive)
 {
 	try
@@ -638,6 +716,11 @@ void RPCServer::sendRPCResponseToClient(std::shared_ptr<Client> client, BaseLib:
 		}
 		else if(responseType == PacketType::Enum::jsonResponse)
 		{
+			if(client->chunkedResponses && variable->type == BaseLib::VariableType::tArray && variable->arrayValue->size() >= _minChunkedResponseElements)
+			{
+				sendChunkedJsonResponseToClient(client, variable, messageId, keepAlive);
+				return;
+			}
 			_jsonEncoder->encodeResponse(variable, messageId, data);
 			data.push_back('\r');
 			data.push_back('\n');
@@ -681,7 +764,8 @@ BaseLib::PVariable RPCServer::callMethod(std::string& methodName, BaseLib::PVari
 	{
 		if(!parameters) parameters = BaseLib::PVariable(new BaseLib::Variable(BaseLib::VariableType::tArray));
 		if(_stopped || GD::bl->shuttingDown) return BaseLib::Variable::createError(100000, "Server is stopped.");
-		if(_rpcMethods->find(methodName) == _rpcMethods->end())
+		auto methodIterator = _rpcMethods->find(methodName);
+		if(methodIterator == _rpcMethods->end())
 		{
 			BaseLib::PVariable result = GD::ipcServer->callRpcMethod(methodName, parameters->arrayValue);
 			return result;
@@ -698,7 +782,7 @@ BaseLib::PVariable RPCServer::callMethod(std::string& methodName, BaseLib::PVari
 				(*i)->print(true, false);
 			}
 		}
-		BaseLib::PVariable ret = _rpcMethods->at(methodName)->invoke(_dummyClientInfo, parameters->arrayValue);
+		BaseLib::PVariable ret = methodIterator->second->invoke(_dummyClientInfo, parameters->arrayValue);
 		if(GD::bl->debugLevel >= 5)
 		{
 			_out.printDebug("Response: ");
@@ -742,7 +826,8 @@ void RPCServer::callMethod(std::shared_ptr<Client> client, std::string methodNam
 			return;
 		}
 
-		if(_rpcMethods->find(methodName) == _rpcMethods->end())
+		auto methodIterator = _rpcMethods->find(methodName);
+		if(methodIterator == _rpcMethods->end())
 		{
 			BaseLib::PVariable result = GD::ipcServer->callRpcMethod(methodName, parameters);
 			sendRPCResponseToClient(client, result, messageId, responseType, keepAlive);
@@ -760,7 +845,7 @@ void RPCServer::callMethod(std::shared_ptr<Client> client, std::string methodNam
 				(*i)->print(true, false);
 			}
 		}
-		BaseLib::PVariable ret = _rpcMethods->at(methodName)->invoke(client, parameters);
+		BaseLib::PVariable ret = methodIterator->second->invoke(client, parameters);
 		if(GD::bl->debugLevel >= 5)
 		{
 			_out.printDebug("Response: ");
@@ -1078,11 +1163,17 @@ void RPCServer::handleConnectionUpgrade(std::shared_ptr<Client> client, BaseLib:
 				std::vector<char> data(&header[0], &header[0] + header.size());
 				sendRPCResponseToClient(client, data, true);
 			}
-			else if(protocol == "client" || pathProtocol == "client" || protocol == "nodeclient" || pathProtocol == "nodeclient")
+			else if(protocol == "client" || pathProtocol == "client" || protocol == "nodeclient" || pathProtocol == "nodeclient" || protocol == "nodeclient2")
 			{
 				client->rpcType = BaseLib::RpcType::websocket;
 				client->webSocketClient = true;
 				if(protocol == "nodeclient" || pathProtocol == "nodeclient") client->nodeClient = true;
+				else if(protocol == "nodeclient2")
+				{
+					//Version 2 of the node client protocol: Node events are sent as "nodeEvents" batches.
+					client->nodeClient = true;
+					client->nodeEventBatches = true;
+				}
 				std::string header;
 				header.reserve(133 + websocketAccept.size());
 				header.append("HTTP/1.1 101 Switching Protocols\r\n");
@@ -1096,7 +1187,7 @@ void RPCServer::handleConnectionUpgrade(std::shared_ptr<Client> client, BaseLib:
 				if(_info->websocketAuthType == BaseLib::Rpc::ServerInfo::Info::AuthType::none)
 				{
 					_out.printInfo("Info: Transferring client number " + std::to_string(client->id) + " to rpc client.");
-					GD::rpcClient->addWebSocketServer(client->socket, client->webSocketClientId, client->address, client->nodeClient);
+					GD::rpcClient->addWebSocketServer(client->socket, client->webSocketClientId, client->address, client->nodeClient, client->nodeEventBatches);
 					client->socketDescriptor.reset(new BaseLib::FileDescriptor());
 					client->socket.reset(new BaseLib::TcpSocket(GD::bl.get()));
 					client->closed = true;
@@ -1133,8 +1224,10 @@ void RPCServer::readClient(std::shared_ptr<Client> client)
 	try
 	{
 		if(!client) return;
-		int32_t bufferMax = 1024;
-		char buffer[bufferMax + 1];
+		//The buffer grows for large packets (up to _maxReadBufferSize) and shrinks again when the connection is idle.
+		int32_t bufferMax = _defaultReadBufferSize;
+		std::vector<char> bufferVector(bufferMax + 1);
+		char* buffer = bufferVector.data();
 		//Make sure the buffer is null terminated.
 		buffer[bufferMax] = '\0';
 		int32_t processedBytes = 0;
@@ -1143,12 +1236,23 @@ void RPCServer::readClient(std::shared_ptr<Client> client)
 		BaseLib::Rpc::BinaryRpc binaryRpc(GD::bl.get());
 		BaseLib::Http http;
 		BaseLib::WebSocket webSocket;
+		int32_t webRequestCount = 0;
+		int64_t lastWebRequestTime = 0;
 
 		_out.printDebug("Listening for incoming packets from client number " + std::to_string(client->socketDescriptor->id) + ".");
 		while(!_stopServer)
 		{
 			try
 			{
+				int32_t newBufferMax = bufferMax;
+				if(http.headerProcessingStarted() && http.getHeader().contentLength > (uint32_t)bufferMax) newBufferMax = http.getHeader().contentLength > (uint32_t)_maxReadBufferSize ? _maxReadBufferSize : http.getHeader().contentLength;
+				else if(bytesRead == bufferMax && bufferMax < _maxReadBufferSize) newBufferMax = std::min(bufferMax * 2, _maxReadBufferSize); //The last read filled the buffer, so more data is probably waiting.
+				if(newBufferMax != bufferMax)
+				{
+					bufferMax = newBufferMax;
+					bufferVector.resize(bufferMax + 1);
+					buffer = bufferVector.data();
+				}
 				bytesRead = client->socket->proofread(buffer, bufferMax);
 				buffer[bufferMax] = 0; //Even though it shouldn't matter, make sure there is a null termination.
 				//Some clients send only one byte in the first packet
@@ -1156,6 +1260,21 @@ void RPCServer::readClient(std::shared_ptr<Client> client)
 			}
 			catch(const BaseLib::SocketTimeOutException& ex)
 			{
+				bytesRead = 0;
+				if(bufferMax > _defaultReadBufferSize && !binaryRpc.processingStarted() && !http.headerProcessingStarted() && !webSocket.dataProcessingStarted())
+				{
+					bufferMax = _defaultReadBufferSize;
+					bufferVector.resize(bufferMax + 1);
+					bufferVector.shrink_to_fit();
+					buffer = bufferVector.data();
+				}
+
+				//Close idle persistent web server connections
+				if(webRequestCount > 0 && !http.headerProcessingStarted() && BaseLib::HelperFunctions::getTime() - lastWebRequestTime > _webServer->keepAliveTimeout())
+				{
+					if(GD::bl->debugLevel >= 5) _out.printDebug("Debug: Closing idle connection to client number " + std::to_string(client->socketDescriptor->id) + ".");
+					break;
+				}
 				continue;
 			}
 			catch(const BaseLib::SocketClosedException& ex)
@@ -1359,7 +1478,7 @@ void RPCServer::readClient(std::shared_ptr<Client> client)
 							if(client->webSocketClient)
 							{
 								_out.printInfo("Info: Transferring client number " + std::to_string(client->id) + " to rpc client.");
-								GD::rpcClient->addWebSocketServer(client->socket, client->webSocketClientId, client->address, client->nodeClient);
+								GD::rpcClient->addWebSocketServer(client->socket, client->webSocketClientId, client->address, client->nodeClient, client->nodeEventBatches);
 								client->socketDescriptor.reset(new BaseLib::FileDescriptor());
 								client->socket.reset(new BaseLib::TcpSocket(GD::bl.get()));
 								client->closed = true;
@@ -1419,12 +1538,16 @@ void RPCServer::readClient(std::shared_ptr<Client> client)
 
 					http.getHeader().remoteAddress = client->address;
 					http.getHeader().remotePort = client->port;
-					if(http.getHeader().method == "POST") _webServer->post(http, client->socket);
-					else if(http.getHeader().method == "GET" || http.getHeader().method == "HEAD") _webServer->get(http, client->socket);
+					webRequestCount++;
+					bool allowKeepAlive = webRequestCount < _webServer->maxKeepAliveRequests();
+					if(http.getHeader().method == "POST") _webServer->post(http, client->socket, allowKeepAlive);
+					else if(http.getHeader().method == "GET" || http.getHeader().method == "HEAD") _webServer->get(http, client->socket, allowKeepAlive);
+					lastWebRequestTime = BaseLib::HelperFunctions::getTime();
 				}
 				else if(http.getContentSize() > 0 && (_info->xmlrpcServer || _info->jsonrpcServer))
 				{
 					if(http.getHeader().contentType == "application/json" || http.getContent().at(0) == '{') packetType = PacketType::jsonRequest;
+					client->chunkedResponses = http.getHeader().protocol != BaseLib::Http::Protocol::http10;
 					packetReceived(client, http.getContent(), packetType, http.getHeader().connection & BaseLib::Http::Connection::Enum::keepAlive);
 				}
 				http.reset();
@@ -40,6 +40,7 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <unordered_map>
 #include <mutex>
 #include <memory>
 
@@ -55,6 +56,8 @@ namespace Rpc
 				bool webSocketClient = false;
 				bool webSocketAuthorized = false;
 				bool nodeClient = false;
+				bool nodeEventBatches = false;
+				bool chunkedResponses = false;
 				std::thread readThread;
 				std::shared_ptr<BaseLib::FileDescriptor> socketDescriptor;
 				std::shared_ptr<BaseLib::TcpSocket> socket;
@@ -80,7 +83,7 @@ namespace Rpc
 			void start(BaseLib::Rpc::PServerInfo& settings);
 			void stop();
 			void registerMethod(std::string methodName, std::shared_ptr<BaseLib::Rpc::RpcMethod> method);
-			std::shared_ptr<std::map<std::string, std::shared_ptr<BaseLib::Rpc::RpcMethod>>> getMethods() { return _rpcMethods; }
+			std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<BaseLib::Rpc::RpcMethod>>> getMethods() { return _rpcMethods; }
 			uint32_t connectionCount();
 			BaseLib::PVariable callMethod(std::string& methodName, BaseLib::PVariable& parameters);
 
@@ -120,7 +123,7 @@ namespace Rpc
 			std::shared_ptr<BaseLib::FileDescriptor> _serverFileDescriptor;
 			std::mutex _stateMutex;
 			std::map<int32_t, std::shared_ptr<Client>> _clients;
-			std::shared_ptr<std::map<std::string, std::shared_ptr<BaseLib::Rpc::RpcMethod>>> _rpcMethods;
+			std::shared_ptr<std::unordered_map<std::string, std::shared_ptr<BaseLib::Rpc::RpcMethod>>> _rpcMethods;
 			std::unique_ptr<BaseLib::Rpc::RpcDecoder> _rpcDecoder;
 			std::unique_ptr<BaseLib::Rpc::RpcDecoder> _rpcDecoderAnsi;
 			std::unique_ptr<BaseLib::Rpc::RpcEncoder> _rpcEncoder;
@@ -129,6 +132,10 @@ namespace Rpc
 			std::unique_ptr<BaseLib::Rpc::JsonDecoder> _jsonDecoder;
 			std::unique_ptr<BaseLib::Rpc::JsonEncoder> _jsonEncoder;
 			std::unique_ptr<WebServer::WebServer> _webServer;
+			const int32_t _defaultReadBufferSize = 1024;
+			const int32_t _maxReadBufferSize = 1048576;
+			const uint32_t _responseChunkSize = 65536;
+			const uint32_t _minChunkedResponseElements = 100;
 			std::mutex _lifetick1Mutex;
 			std::pair<int64_t, bool> _lifetick1;
 			std::mutex _lifetick2Mutex;
@@ -143,6 +150,12 @@ namespace Rpc
 			void readClient(std::shared_ptr<Client> client);
 			void sendRPCResponseToClient(std::shared_ptr<Client> client, BaseLib::PVariable variable, int32_t messageId, PacketType::Enum packetType, bool keepAlive);
 			void sendRPCResponseToClient(std::shared_ptr<Client> client, std::vector<char>& data, bool keepAlive);
+
+			/**
+			 * Encodes a JSON-RPC array response element by element and sends it using HTTP chunked transfer encoding,
+			 * so the whole encoded response never needs to be held in memory.
+			 */
+			void sendChunkedJsonResponseToClient(std::shared_ptr<Client> client, BaseLib::PVariable& variable, int32_t messageId, bool keepAlive);
 			void packetReceived(std::shared_ptr<Client> client, std::vector<char>& packet, PacketType::Enum packetType, bool keepAlive);
 			void handleConnectionUpgrade(std::shared_ptr<Client> client, BaseLib::Http& http);
 			void analyzeRPC(std::shared_ptr<Client> client, std::vector<char>& packet, PacketType::Enum packetType, bool keepAlive);
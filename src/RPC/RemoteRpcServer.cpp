@@ -66,6 +66,51 @@ RemoteRpcServer::~RemoteRpcServer()
 	_client.reset();
 }
 
+uint32_t RemoteRpcServer::takeNodeEventBudget(uint32_t count)
+{
+	try
+	{
+		std::lock_guard<std::mutex> nodeEventBudgetGuard(_nodeEventBudgetMutex);
+		int64_t time = BaseLib::HelperFunctions::getTime();
+		if(_lastNodeEventBudgetUpdate > 0 && time > _lastNodeEventBudgetUpdate)
+		{
+			_nodeEventBudget += (double)((time - _lastNodeEventBudgetUpdate) * _nodeEventsPerSecond) / 1000.0;
+			if(_nodeEventBudget > _maxNodeEventBudget) _nodeEventBudget = _maxNodeEventBudget;
+		}
+		_lastNodeEventBudgetUpdate = time;
+
+		uint32_t allowed = (uint32_t)_nodeEventBudget;
+		if(allowed > count) allowed = count;
+		_nodeEventBudget -= allowed;
+
+		if(allowed < count)
+		{
+			_droppedNodeEvents += count - allowed;
+			if(time - _lastDroppedNodeEventsWarning >= 10000)
+			{
+				GD::out.printWarning("Warning: Dropped " + std::to_string(_droppedNodeEvents) + " node events for event server \"" + id + "\", because it exceeded its rate budget of " + std::to_string(_nodeEventsPerSecond) + " events per second.");
+				_lastDroppedNodeEventsWarning = time;
+				_droppedNodeEvents = 0;
+			}
+		}
+
+		return allowed;
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return 0;
+}
+
 void RemoteRpcServer::queueMethod(std::shared_ptr<std::pair<std::string, std::shared_ptr<std::list<BaseLib::PVariable>>>> method)
 {
 	try
@@ -141,6 +186,35 @@ void RemoteRpcServer::processMethods()
 				_methodBuffer[_methodBufferTail].reset();
 				_methodBufferTail++;
 				if(_methodBufferTail >= _methodBufferSize) _methodBufferTail = 0;
+				if(!json && !webSocket && message->first == "system.multicall" && message->second->size() == 1)
+				{
+					//Merge all queued multicalls into one request, so a burst of events only needs one round trip.
+					BaseLib::PVariable calls;
+					while(_methodBufferHead != _methodBufferTail)
+					{
+						std::shared_ptr<std::pair<std::string, std::shared_ptr<std::list<BaseLib::PVariable>>>>& nextMessage = _methodBuffer[_methodBufferTail];
+						if(nextMessage->first != "system.multicall" || nextMessage->second->size() != 1) break;
+						BaseLib::PVariable& nextCalls = nextMessage->second->front();
+						uint32_t callCount = calls ? calls->arrayValue->size() : message->second->front()->arrayValue->size();
+						if(callCount + nextCalls->arrayValue->size() > _maxMulticallSize) break;
+						if(!calls)
+						{
+							calls = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
+							calls->arrayValue->reserve(_maxMulticallSize);
+							calls->arrayValue->insert(calls->arrayValue->end(), message->second->front()->arrayValue->begin(), message->second->front()->arrayValue->end());
+						}
+						calls->arrayValue->insert(calls->arrayValue->end(), nextCalls->arrayValue->begin(), nextCalls->arrayValue->end());
+						nextMessage.reset();
+						_methodBufferTail++;
+						if(_methodBufferTail >= _methodBufferSize) _methodBufferTail = 0;
+					}
+					if(calls)
+					{
+						std::shared_ptr<std::list<BaseLib::PVariable>> parameters = std::make_shared<std::list<BaseLib::PVariable>>();
+						parameters->push_back(calls);
+						message = std::make_shared<std::pair<std::string, std::shared_ptr<std::list<BaseLib::PVariable>>>>("system.multicall", parameters);
+					}
+				}
 				if(_methodBufferHead == _methodBufferTail) _methodProcessingMessageAvailable = false; //Set here, because otherwise it might be set to "true" in publish and then set to false again after the while loop
 				_methodBufferMutex.unlock();
 				if(!removed) _client->invokeBroadcast(this, message->first, message->second);
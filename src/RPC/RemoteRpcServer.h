@@ -64,6 +64,7 @@ public:
 	bool newFormat = false;
 	bool subscribePeers = false;
 	bool nodeEvents = false;
+	bool nodeEventBatches = false; //Node events are sent as "nodeEvents" batches instead of single "nodeEvent" calls ("nodeclient2").
 	bool reconnectInfinitely = false;
 	std::string hostname;
 	std::pair<std::string, std::string> address;
@@ -89,11 +90,29 @@ public:
 	 * @param method The method to queue. The first part of the pair is the method name, the second part the parameters.
 	 */
 	void queueMethod(std::shared_ptr<std::pair<std::string, std::shared_ptr<std::list<BaseLib::PVariable>>>> method);
+
+	/**
+	 * Takes node events from the rate budget of this event server. The budget is refilled with _nodeEventsPerSecond events per second up to _maxNodeEventBudget.
+	 *
+	 * @param count The number of node events to send.
+	 * @return Returns the number of node events that may be sent. Events exceeding the budget are counted and reported as dropped.
+	 */
+	uint32_t takeNodeEventBudget(uint32_t count);
 private:
 	std::shared_ptr<RpcClient> _client;
 
+	//Node event rate budget
+	static const uint32_t _nodeEventsPerSecond = 100;
+	static const uint32_t _maxNodeEventBudget = 500;
+	std::mutex _nodeEventBudgetMutex;
+	double _nodeEventBudget = _maxNodeEventBudget;
+	int64_t _lastNodeEventBudgetUpdate = 0;
+	uint32_t _droppedNodeEvents = 0;
+	int64_t _lastDroppedNodeEventsWarning = 0;
+
 	//Method queue
 	static const int32_t _methodBufferSize = 1000;
+	static const uint32_t _maxMulticallSize = 100;
 	std::mutex _methodBufferMutex;
 	int32_t _methodBufferHead = 0;
 	int32_t _methodBufferTail = 0;
@@ -0,0 +1,173 @@
+/* Copyright 2013-2017 Sathya Laufer
+ *
+ * Homegear is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * 
+ * Homegear is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Homegear.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * 
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU Lesser General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+*/
+
+#include "ResponseCache.h"
+#include "../GD/GD.h"
+
+namespace Rpc
+{
+std::string ResponseCache::getKey(const std::string& methodName, const BaseLib::PRpcClientInfo& clientInfo, const std::shared_ptr<std::vector<BaseLib::PVariable>>& parameters)
+{
+	std::string key;
+	key.reserve(256);
+	key.append(methodName).push_back(';');
+	//Responses might differ depending on the client type.
+	key.append(std::to_string(clientInfo ? (int32_t)clientInfo->clientType : -1)).push_back(';');
+	if(parameters)
+	{
+		for(auto& parameter : *parameters)
+		{
+			appendKey(parameter, key);
+		}
+	}
+	return key;
+}
+
+void ResponseCache::appendKey(const BaseLib::PVariable& variable, std::string& key)
+{
+	if(!variable)
+	{
+		key.append("n;");
+		return;
+	}
+	key.append(std::to_string((int32_t)variable->type)).push_back(':');
+	switch(variable->type)
+	{
+		case BaseLib::VariableType::tArray:
+			for(auto& element : *variable->arrayValue)
+			{
+				appendKey(element, key);
+			}
+			key.push_back(']');
+			break;
+		case BaseLib::VariableType::tStruct:
+			for(auto& element : *variable->structValue)
+			{
+				key.append(std::to_string(element.first.size())).push_back(':');
+				key.append(element.first);
+				appendKey(element.second, key);
+			}
+			key.push_back('}');
+			break;
+		case BaseLib::VariableType::tBoolean:
+			key.push_back(variable->booleanValue ? '1' : '0');
+			break;
+		case BaseLib::VariableType::tInteger:
+			key.append(std::to_string(variable->integerValue));
+			break;
+		case BaseLib::VariableType::tInteger64:
+			key.append(std::to_string(variable->integerValue64));
+			break;
+		case BaseLib::VariableType::tFloat:
+			key.append(std::to_string(variable->floatValue));
+			break;
+		case BaseLib::VariableType::tBinary:
+			key.append(std::to_string(variable->binaryValue.size())).push_back(':');
+			key.append(variable->binaryValue.begin(), variable->binaryValue.end());
+			break;
+		default:
+			key.append(std::to_string(variable->stringValue.size())).push_back(':');
+			key.append(variable->stringValue);
+			break;
+	}
+	key.push_back(';');
+}
+
+BaseLib::PVariable ResponseCache::get(const std::string& key)
+{
+	try
+	{
+		std::lock_guard<std::mutex> cacheGuard(_cacheMutex);
+		auto cacheIterator = _cache.find(key);
+		if(cacheIterator == _cache.end()) return BaseLib::PVariable();
+		if(BaseLib::HelperFunctions::getTime() - cacheIterator->second.time > _maxAge)
+		{
+			_cache.erase(cacheIterator);
+			return BaseLib::PVariable();
+		}
+		return cacheIterator->second.response;
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+	return BaseLib::PVariable();
+}
+
+void ResponseCache::set(const std::string& key, const BaseLib::PVariable& response, uint64_t version)
+{
+	try
+	{
+		if(!response || response->errorStruct) return;
+		std::lock_guard<std::mutex> cacheGuard(_cacheMutex);
+		if(version != _version) return;
+		int64_t time = BaseLib::HelperFunctions::getTime();
+		if(_cache.size() >= _maxEntries)
+		{
+			for(auto i = _cache.begin(); i != _cache.end();)
+			{
+				if(time - i->second.time > _maxAge) i = _cache.erase(i);
+				else ++i;
+			}
+			if(_cache.size() >= _maxEntries) _cache.erase(_cache.begin());
+		}
+		CacheEntry& entry = _cache[key];
+		entry.response = response;
+		entry.time = time;
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+
+void ResponseCache::invalidate()
+{
+	std::lock_guard<std::mutex> cacheGuard(_cacheMutex);
+	_version++;
+	_cache.clear();
+}
+}
@@ -0,0 +1,106 @@
+/* Copyright 2013-2017 Sathya Laufer
+ *
+ * Homegear is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ * 
+ * Homegear is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Homegear.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * 
+ * In addition, as a special exception, the copyright holders give
+ * permission to link the code of portions of this program with the
+ * OpenSSL library under certain conditions as described in each
+ * individual source file, and distribute linked combinations
+ * including the two.
+ * You must obey the GNU Lesser General Public License in all respects
+ * for all of the code used other than OpenSSL.  If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so.  If you
+ * do not wish to do so, delete this exception statement from your
+ * version.  If you delete this exception statement from all source
+ * files in the program, then also delete it here.
+*/
+
+#ifndef RESPONSECACHE_H_
+#define RESPONSECACHE_H_
+
+#include <homegear-base/BaseLib.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Rpc
+{
+/**
+ * Caches responses of expensive read only RPC methods like "listDevices". All entries are dropped when devices are
+ * added, deleted or updated. Cached responses are shared between callers and must not be modified.
+ */
+class ResponseCache
+{
+public:
+	/**
+	 * Invalidates the cache when it goes out of scope. Create one at the beginning of RPC methods changing data that is
+	 * part of cached responses. As it is destroyed after the return value is created, no response computed before the
+	 * change can be stored afterwards.
+	 */
+	class InvalidationGuard
+	{
+	public:
+		InvalidationGuard(ResponseCache& cache) : _cache(cache) {}
+		virtual ~InvalidationGuard() { _cache.invalidate(); }
+	private:
+		ResponseCache& _cache;
+	};
+
+	ResponseCache() {}
+	virtual ~ResponseCache() {}
+
+	/**
+	 * Creates the cache key for a method call.
+	 */
+	static std::string getKey(const std::string& methodName, const BaseLib::PRpcClientInfo& clientInfo, const std::shared_ptr<std::vector<BaseLib::PVariable>>& parameters);
+
+	/**
+	 * Returns the current version of the cache. Call this before computing a response and pass the result to set().
+	 */
+	uint64_t version() { return _version; }
+
+	/**
+	 * Returns the cached response or nullptr.
+	 */
+	BaseLib::PVariable get(const std::string& key);
+
+	/**
+	 * Stores a response. The response is not stored if it is an error or if the cache was invalidated since "version"
+	 * was retrieved.
+	 */
+	void set(const std::string& key, const BaseLib::PVariable& response, uint64_t version);
+
+	void invalidate();
+private:
+	struct CacheEntry
+	{
+		BaseLib::PVariable response;
+		int64_t time = 0;
+	};
+
+	const int64_t _maxAge = 60000;
+	const uint32_t _maxEntries = 100;
+	std::mutex _cacheMutex;
+	std::atomic<uint64_t> _version{0};
+	std::unordered_map<std::string, CacheEntry> _cache;
+
+	static void appendKey(const BaseLib::PVariable& variable, std::string& key);
+};
+}
+#endif
@@ -35,13 +35,16 @@
 std::mutex PhpEvents::eventsMapMutex;
 std::map<int32_t, std::shared_ptr<PhpEvents>> PhpEvents::eventsMap;
 
-PhpEvents::PhpEvents(std::string& token, std::function<void(std::string output)>& outputCallback, std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters, bool wait)>& rpcCallback)
+PhpEvents::PhpEvents(std::string& token, std::function<void(std::string output)>& outputCallback, std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters, bool wait)>& rpcCallback, std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters)>& rpcAsyncCallback, std::function<BaseLib::PVariable(int32_t requestId)>& rpcAwaitCallback, std::function<void(int32_t requestId)>& rpcReleaseCallback)
 {
 	_stopProcessing = false;
 	_bufferCount = 0;
 	_token = token;
 	_outputCallback = outputCallback;
 	_rpcCallback = rpcCallback;
+	_rpcAsyncCallback = rpcAsyncCallback;
+	_rpcAwaitCallback = rpcAwaitCallback;
+	_rpcReleaseCallback = rpcReleaseCallback;
 }
 
 PhpEvents::~PhpEvents()
@@ -50,7 +50,7 @@ public:
 	static std::mutex eventsMapMutex;
 	static std::map<int32_t, std::shared_ptr<PhpEvents>> eventsMap;
 
-	PhpEvents(std::string& token, std::function<void(std::string output)>& outputCallback, std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters, bool wait)>& rpcCallback);
+	PhpEvents(std::string& token, std::function<void(std::string output)>& outputCallback, std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters, bool wait)>& rpcCallback, std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters)>& rpcAsyncCallback, std::function<BaseLib::PVariable(int32_t requestId)>& rpcAwaitCallback, std::function<void(int32_t requestId)>& rpcReleaseCallback);
 	virtual ~PhpEvents();
 	void stop();
 	bool enqueue(std::shared_ptr<EventData>& entry);
@@ -65,10 +65,16 @@ public:
 
 	std::function<void(std::string output)>& getOutputCallback() { return _outputCallback; };
 	std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters, bool wait)>& getRpcCallback() { return _rpcCallback; };
+	std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters)>& getRpcAsyncCallback() { return _rpcAsyncCallback; };
+	std::function<BaseLib::PVariable(int32_t requestId)>& getRpcAwaitCallback() { return _rpcAwaitCallback; };
+	std::function<void(int32_t requestId)>& getRpcReleaseCallback() { return _rpcReleaseCallback; };
 	std::string& getToken() { return _token; }
 private:
 	std::function<void(std::string output)> _outputCallback;
 	std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters, bool wait)> _rpcCallback;
+	std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters)> _rpcAsyncCallback;
+	std::function<BaseLib::PVariable(int32_t requestId)> _rpcAwaitCallback;
+	std::function<void(int32_t requestId)> _rpcReleaseCallback;
 	std::string _token;
 
 	// {{{ Data exchange - e are abusing the events object here for data exchange between main thread and sub threads.
@@ -50,25 +50,27 @@ BaseLib::PVariable PhpVariableConverter::getVariable(zval* value)
 		if(!value) return variable;
 		if(Z_TYPE_P(value) == IS_LONG)
 		{
-			variable.reset(new BaseLib::Variable(Z_LVAL_P(value)));
+			variable = std::make_shared<BaseLib::Variable>(Z_LVAL_P(value));
 			variable->type = (sizeof(long) == 8) ? BaseLib::VariableType::tInteger64 : BaseLib::VariableType::tInteger;
 		}
 		else if(Z_TYPE_P(value) == IS_DOUBLE)
 		{
-			variable.reset(new BaseLib::Variable((double)Z_DVAL_P(value)));
+			variable = std::make_shared<BaseLib::Variable>((double)Z_DVAL_P(value));
 		}
 		else if(Z_TYPE_P(value) == IS_TRUE)
 		{
-			variable.reset(new BaseLib::Variable(true));
+			variable = std::make_shared<BaseLib::Variable>(true);
 		}
 		else if(Z_TYPE_P(value) == IS_FALSE)
 		{
-			variable.reset(new BaseLib::Variable(false));
+			variable = std::make_shared<BaseLib::Variable>(false);
 		}
 		else if(Z_TYPE_P(value) == IS_STRING)
 		{
-			if(Z_STRLEN_P(value) > 0) variable.reset(new BaseLib::Variable(std::string(Z_STRVAL_P(value), Z_STRLEN_P(value))));
-			else variable.reset(new BaseLib::Variable(std::string("")));
+			//Copy the string directly into the variable's buffer. Constructing a temporary std::string first copies large
+			//binary strings twice.
+			variable = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tString);
+			if(Z_STRLEN_P(value) > 0) variable->stringValue.assign(Z_STRVAL_P(value), Z_STRLEN_P(value));
 		}
 		else if(Z_TYPE_P(value) == IS_ARRAY)
 		{
@@ -76,33 +78,33 @@ BaseLib::PVariable PhpVariableConverter::getVariable(zval* value)
 			HashTable* ht = Z_ARRVAL_P(value);
 			zend_string* key = nullptr;
 			ulong keyIndex = 0;
-			if(zend_hash_num_elements(ht) == 0)
+			uint32_t elementCount = zend_hash_num_elements(ht);
+			if(elementCount == 0)
 			{
-				variable.reset(new BaseLib::Variable(BaseLib::VariableType::tArray));
+				variable = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
 				return variable;
 			}
 			ZEND_HASH_FOREACH_KEY_VAL(ht, keyIndex, key, element)
 			{
 				if(!variable)
 				{
-					if(key) variable.reset(new BaseLib::Variable(BaseLib::VariableType::tStruct));
-					else variable.reset(new BaseLib::Variable(BaseLib::VariableType::tArray));
+					if(key) variable = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
+					else
+					{
+						variable = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tArray);
+						variable->arrayValue->reserve(elementCount);
+					}
 				}
 				if(!element) continue;
 				BaseLib::PVariable arrayElement = getVariable(element);
 				if(!arrayElement) continue;
-				if(key)
-				{
-					std::string keyName;
-					keyName = std::string(key->val, key->len);
-					variable->structValue->insert(BaseLib::StructElement(keyName, arrayElement));
-				}
-				else variable->arrayValue->push_back(arrayElement);
+				if(key) variable->structValue->emplace(std::string(ZSTR_VAL(key), ZSTR_LEN(key)), std::move(arrayElement));
+				else variable->arrayValue->push_back(std::move(arrayElement));
 			} ZEND_HASH_FOREACH_END();
 		}
 		else
 		{
-			variable.reset(new BaseLib::Variable(BaseLib::VariableType::tVoid));
+			variable = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tVoid);
 		}
 
 		return variable;
@@ -123,7 +125,7 @@ BaseLib::PVariable PhpVariableConverter::getVariable(zval* value)
 }
 #pragma GCC diagnostic warning "-Wunused-but-set-variable"
 
-void PhpVariableConverter::getPHPVariable(BaseLib::PVariable input, zval* output)
+void PhpVariableConverter::getPHPVariable(const BaseLib::PVariable& input, zval* output)
 {
 	try
 	{
@@ -131,18 +133,21 @@ void PhpVariableConverter::getPHPVariable(BaseLib::PVariable input, zval* output
 
 		if(input->type == BaseLib::VariableType::tArray)
 		{
-			array_init(output);
+			//Pre-size the hash table so it doesn't need to be rehashed while filling it. Arrays are initialized as packed
+			//arrays, which don't need a hash part at all.
+			array_init_size(output, input->arrayValue->size());
+			zend_hash_real_init(Z_ARRVAL_P(output), 1);
 			for(std::vector<BaseLib::PVariable>::iterator i = input->arrayValue->begin(); i != input->arrayValue->end(); ++i)
 			{
 				zval element;
 				getPHPVariable(*i, &element);
-				add_next_index_zval(output, &element);
+				zend_hash_next_index_insert_new(Z_ARRVAL_P(output), &element);
 			}
 			return;
 		}
 		else if(input->type == BaseLib::VariableType::tStruct)
 		{
-			array_init(output);
+			array_init_size(output, input->structValue->size());
 			for(std::map<std::string, BaseLib::PVariable>::iterator i = input->structValue->begin(); i != input->structValue->end(); ++i)
 			{
 				zval element;
@@ -174,7 +179,7 @@ void PhpVariableConverter::getPHPVariable(BaseLib::PVariable input, zval* output
 		}
 		else if(input->type == BaseLib::VariableType::tString || input->type == BaseLib::VariableType::tBase64)
 		{
-			if(input->stringValue.empty()) ZVAL_STRINGL(output, "", 0); //At least once, input->stringValue.c_str() on an empty string was a nullptr causing a segementation fault, so check for empty string
+			if(input->stringValue.empty()) ZVAL_EMPTY_STRING(output); //Interned, so no allocation. Also input->stringValue.c_str() on an empty string was a nullptr at least once causing a segementation fault.
 			else ZVAL_STRINGL(output, input->stringValue.c_str(), input->stringValue.size());
 		}
 		else
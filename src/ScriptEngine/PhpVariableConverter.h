@@ -47,7 +47,7 @@ public:
 	virtual ~PhpVariableConverter();
 
 	static BaseLib::PVariable getVariable(zval* value);
-	static void getPHPVariable(BaseLib::PVariable input, zval* output);
+	static void getPHPVariable(const BaseLib::PVariable& input, zval* output);
 protected:
 };
 #endif
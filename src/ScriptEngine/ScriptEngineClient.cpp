@@ -738,6 +738,77 @@ BaseLib::PVariable ScriptEngineClient::callMethod(std::string methodName, BaseLi
     return BaseLib::Variable::createError(-32500, "Unknown application error.");
 }
 
+BaseLib::PVariable ScriptEngineClient::callMethodAsync(std::string methodName, BaseLib::PVariable parameters)
+{
+	try
+	{
+		if(_nodesStopped) return BaseLib::Variable::createError(-32500, "RPC calls are forbidden after \"stop\" is executed.");
+		zend_homegear_globals* globals = php_homegear_get_globals();
+		int32_t packetId = 0;
+		BaseLib::PVariable result = queueRequest(globals->id, methodName, parameters->arrayValue, true, true, packetId);
+		if(result->errorStruct) return result;
+		return std::make_shared<BaseLib::Variable>(packetId);
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return BaseLib::Variable::createError(-32500, "Unknown application error.");
+}
+
+BaseLib::PVariable ScriptEngineClient::awaitResponse(int32_t requestId)
+{
+	try
+	{
+		zend_homegear_globals* globals = php_homegear_get_globals();
+		return waitForResponse(globals->id, requestId);
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return BaseLib::Variable::createError(-32500, "Unknown application error.");
+}
+
+void ScriptEngineClient::releaseResponse(int32_t requestId)
+{
+	try
+	{
+		zend_homegear_globals* globals = php_homegear_get_globals();
+		std::lock_guard<std::mutex> responseGuard(_rpcResponsesMutex);
+		auto scriptIterator = _rpcResponses.find(globals->id);
+		if(scriptIterator != _rpcResponses.end()) scriptIterator->second.erase(requestId);
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
 BaseLib::PVariable ScriptEngineClient::send(std::vector<char>& data)
 {
 	try
@@ -771,17 +842,10 @@ BaseLib::PVariable ScriptEngineClient::send(std::vector<char>& data)
     return BaseLib::PVariable(new BaseLib::Variable());
 }
 
-BaseLib::PVariable ScriptEngineClient::sendRequest(int32_t scriptId, std::string methodName, BaseLib::PArray& parameters, bool wait)
+BaseLib::PVariable ScriptEngineClient::queueRequest(int32_t scriptId, std::string& methodName, BaseLib::PArray& parameters, bool wait, bool async, int32_t& packetId)
 {
 	try
 	{
-		std::unique_lock<std::mutex> requestInfoGuard(_requestInfoMutex);
-		RequestInfo& requestInfo = _requestInfo[scriptId];
-		requestInfoGuard.unlock();
-
-		std::lock_guard<std::mutex> requestGuard(requestInfo.requestMutex);
-
-		int32_t packetId;
 		{
 			std::lock_guard<std::mutex> packetIdGuard(_packetIdMutex);
 			packetId = _currentPacketId++;
@@ -795,13 +859,42 @@ BaseLib::PVariable ScriptEngineClient::sendRequest(int32_t scriptId, std::string
 		std::vector<char> data;
 		_rpcEncoder->encodeRequest(methodName, array, data);
 
-		PScriptEngineResponse response;
 		if(wait)
 		{
+			PScriptEngineResponse response;
 			{
 				std::lock_guard<std::mutex> responseGuard(_rpcResponsesMutex);
-				auto result = _rpcResponses[scriptId].emplace(packetId, std::make_shared<ScriptEngineResponse>());
-				if(result.second) response = result.first->second;
+				std::map<int32_t, PScriptEngineResponse>& scriptResponses = _rpcResponses[scriptId];
+				int64_t time = BaseLib::HelperFunctions::getTime();
+				if(async)
+				{
+					//The limit is checked under the same lock the response is inserted with, so threads of a script can't exceed it.
+					int32_t asyncRequests = 0;
+					for(auto i = scriptResponses.begin(); i != scriptResponses.end();)
+					{
+						if(!i->second->async)
+						{
+							++i;
+							continue;
+						}
+						//No response will arrive anymore. The slot is released here in case the future is never freed.
+						if(!i->second->finished && time - i->second->time > _asyncResponseTimeout)
+						{
+							i = scriptResponses.erase(i);
+							continue;
+						}
+						asyncRequests++;
+						++i;
+					}
+					if(asyncRequests >= _maxAsyncRequestsPerScript) return BaseLib::Variable::createError(-32500, "Too many pending asynchronous requests.");
+				}
+				auto result = scriptResponses.emplace(packetId, std::make_shared<ScriptEngineResponse>());
+				if(result.second)
+				{
+					response = result.first->second;
+					response->async = async;
+					response->time = time;
+				}
 			}
 			if(!response)
 			{
@@ -818,24 +911,61 @@ BaseLib::PVariable ScriptEngineClient::sendRequest(int32_t scriptId, std::string
 		{
 			std::lock_guard<std::mutex> responseGuard(_rpcResponsesMutex);
 			_rpcResponses[scriptId].erase(packetId);
-			return result;
 		}
-		if(!wait) return std::make_shared<BaseLib::Variable>();
+		return result;
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return BaseLib::Variable::createError(-32500, "Unknown application error.");
+}
 
-		int32_t i = 0;
-		std::unique_lock<std::mutex> waitLock(requestInfo.waitMutex);
-		while (!requestInfo.conditionVariable.wait_for(waitLock, std::chrono::milliseconds(1000), [&]
+BaseLib::PVariable ScriptEngineClient::waitForResponse(int32_t scriptId, int32_t packetId)
+{
+	try
+	{
+		PScriptEngineResponse response;
 		{
-			return response->finished || _stopped;
-		}))
+			std::lock_guard<std::mutex> responseGuard(_rpcResponsesMutex);
+			auto scriptIterator = _rpcResponses.find(scriptId);
+			if(scriptIterator != _rpcResponses.end())
+			{
+				auto responseIterator = scriptIterator->second.find(packetId);
+				if(responseIterator != scriptIterator->second.end()) response = responseIterator->second;
+			}
+		}
+		if(!response) return BaseLib::Variable::createError(-1, "Unknown request ID or response already retrieved.");
+
+		std::unique_lock<std::mutex> requestInfoGuard(_requestInfoMutex);
+		RequestInfo& requestInfo = _requestInfo[scriptId];
+		requestInfoGuard.unlock();
+
 		{
-			i++;
-			if(i == 60) break;
+			int32_t i = 0;
+			std::unique_lock<std::mutex> waitLock(requestInfo.waitMutex);
+			while (!requestInfo.conditionVariable.wait_for(waitLock, std::chrono::milliseconds(1000), [&]
+			{
+				return response->finished || _stopped;
+			}))
+			{
+				i++;
+				if(i == 60) break;
+			}
 		}
 
+		BaseLib::PVariable result;
 		if(!response->finished || response->response->arrayValue->size() != 3 || response->packetId != packetId)
 		{
-			_out.printError("Error: No response received to RPC request. Method: " + methodName);
+			_out.printError("Error: No response received to RPC request with packet ID " + std::to_string(packetId) + ".");
 			result = BaseLib::Variable::createError(-1, "No response received.");
 		}
 		else result = response->response->arrayValue->at(2);
@@ -862,6 +992,33 @@ BaseLib::PVariable ScriptEngineClient::sendRequest(int32_t scriptId, std::string
     return BaseLib::Variable::createError(-32500, "Unknown application error.");
 }
 
+BaseLib::PVariable ScriptEngineClient::sendRequest(int32_t scriptId, std::string methodName, BaseLib::PArray& parameters, bool wait)
+{
+	try
+	{
+		//Requests are not serialized per script. Every request has its own packet ID and response struct, so multiple
+		//requests of a script and its threads can be in flight at the same time.
+		int32_t packetId = 0;
+		BaseLib::PVariable result = queueRequest(scriptId, methodName, parameters, wait, false, packetId);
+		if(result->errorStruct || !wait) return result;
+
+		return waitForResponse(scriptId, packetId);
+	}
+	catch(const std::exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return BaseLib::Variable::createError(-32500, "Unknown application error.");
+}
+
 BaseLib::PVariable ScriptEngineClient::sendGlobalRequest(std::string methodName, BaseLib::PArray& parameters)
 {
 	try
@@ -1155,7 +1312,7 @@ void ScriptEngineClient::runScript(int32_t id, PScriptInfo scriptInfo)
 			{
 				//BaseLib::Base64::encode(BaseLib::HelperFunctions::getRandomBytes(16), globals->token);
 				BaseLib::Base64::encode(std::vector<uint8_t>{0, 1, 2, 3, 4, 5}, globals->token);
-				std::shared_ptr<PhpEvents> phpEvents = std::make_shared<PhpEvents>(globals->token, globals->outputCallback, globals->rpcCallback);
+				std::shared_ptr<PhpEvents> phpEvents = std::make_shared<PhpEvents>(globals->token, globals->outputCallback, globals->rpcCallback, globals->rpcAsyncCallback, globals->rpcAwaitCallback, globals->rpcReleaseCallback);
 				phpEvents->setPeerId(scriptInfo->peerId);
 				std::lock_guard<std::mutex> eventsGuard(PhpEvents::eventsMapMutex);
 				PhpEvents::eventsMap.emplace(id, phpEvents);
@@ -1352,6 +1509,9 @@ void ScriptEngineClient::scriptThread(int32_t id, PScriptInfo scriptInfo, bool s
 			globals->sendHeadersCallback = std::bind(&ScriptEngineClient::sendHeaders, this, std::placeholders::_1);
 		}
 		globals->rpcCallback = std::bind(&ScriptEngineClient::callMethod, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+		globals->rpcAsyncCallback = std::bind(&ScriptEngineClient::callMethodAsync, this, std::placeholders::_1, std::placeholders::_2);
+		globals->rpcAwaitCallback = std::bind(&ScriptEngineClient::awaitResponse, this, std::placeholders::_1);
+		globals->rpcReleaseCallback = std::bind(&ScriptEngineClient::releaseResponse, this, std::placeholders::_1);
 		{
 			std::lock_guard<std::mutex> requestInfoGuard(_requestInfoMutex);
 			_requestInfo.emplace(std::piecewise_construct, std::make_tuple(id), std::make_tuple());
@@ -1416,9 +1576,10 @@ void ScriptEngineClient::scriptThread(int32_t id, PScriptInfo scriptInfo, bool s
     }
 }
 
-void ScriptEngineClient::checkSessionIdThread(std::string sessionId, bool* result)
+void ScriptEngineClient::checkSessionIdThread(std::string sessionId, bool* result, int64_t* lifetime)
 {
 	*result = false;
+	*lifetime = 0;
 	std::shared_ptr<BaseLib::Rpc::ServerInfo::Info> serverInfo(new BaseLib::Rpc::ServerInfo::Info());
 
 	{
@@ -1492,6 +1653,7 @@ void ScriptEngineClient::checkSessionIdThread(std::string sessionId, bool* resul
 				}
 			}
         }
+		if(*result) *lifetime = INI_INT("session.gc_maxlifetime");
 	}
 	catch(const std::exception& ex)
 	{
@@ -1751,12 +1913,16 @@ BaseLib::PVariable ScriptEngineClient::checkSessionId(BaseLib::PArray& parameter
 		if(parameters->at(0)->stringValue.empty()) return BaseLib::Variable::createError(-1, "Session ID is empty.");
 
 		bool result = false;
+		int64_t lifetime = 0;
 		std::lock_guard<std::mutex> maintenanceThreadGuard(_maintenanceThreadMutex);
 		if(_maintenanceThread.joinable()) _maintenanceThread.join();
-		_maintenanceThread = std::thread(&ScriptEngineClient::checkSessionIdThread, this, parameters->at(0)->stringValue, &result);
+		_maintenanceThread = std::thread(&ScriptEngineClient::checkSessionIdThread, this, parameters->at(0)->stringValue, &result, &lifetime);
 		if(_maintenanceThread.joinable()) _maintenanceThread.join();
 
-		return std::make_shared<BaseLib::Variable>(result);
+		BaseLib::PVariable response = std::make_shared<BaseLib::Variable>(BaseLib::VariableType::tStruct);
+		response->structValue->emplace("valid", std::make_shared<BaseLib::Variable>(result));
+		response->structValue->emplace("lifetime", std::make_shared<BaseLib::Variable>(lifetime));
+		return response;
 	}
     catch(const std::exception& ex)
     {
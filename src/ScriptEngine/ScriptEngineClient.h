@@ -77,7 +77,6 @@ private:
 
 	struct RequestInfo
 	{
-		std::mutex requestMutex;
 		std::mutex waitMutex;
 		std::condition_variable conditionVariable;
 	};
@@ -131,6 +130,8 @@ private:
 	std::shared_ptr<BaseLib::FileDescriptor> _fileDescriptor;
 	int64_t _lastGargabeCollection = 0;
 	std::atomic_bool _stopped;
+	static const int32_t _maxAsyncRequestsPerScript = 100;
+	static const int64_t _asyncResponseTimeout = 60000;
 	static std::mutex _resourceMutex;
 	std::mutex _sendMutex;
 	std::mutex _requestMutex;
@@ -163,6 +164,32 @@ private:
 	void sendOutput(std::string output);
 	void sendHeaders(BaseLib::PVariable headers);
 	BaseLib::PVariable callMethod(std::string methodName, BaseLib::PVariable parameters, bool wait);
+
+	/**
+	 * Sends an RPC request without waiting for the response.
+	 *
+	 * @param methodName The name of the method to call.
+	 * @param parameters The method's parameters.
+	 * @return Returns the request ID to pass to awaitResponse() or an error struct.
+	 */
+	BaseLib::PVariable callMethodAsync(std::string methodName, BaseLib::PVariable parameters);
+
+	/**
+	 * Waits for the response of a request sent with callMethodAsync().
+	 *
+	 * @param requestId The request ID returned by callMethodAsync().
+	 * @return Returns the result of the RPC method.
+	 */
+	BaseLib::PVariable awaitResponse(int32_t requestId);
+
+	/**
+	 * Removes the response slot of a request sent with callMethodAsync() whose result is not needed anymore.
+	 *
+	 * @param requestId The request ID returned by callMethodAsync().
+	 */
+	void releaseResponse(int32_t requestId);
+	BaseLib::PVariable queueRequest(int32_t scriptId, std::string& methodName, BaseLib::PArray& parameters, bool wait, bool async, int32_t& packetId);
+	BaseLib::PVariable waitForResponse(int32_t scriptId, int32_t packetId);
 	BaseLib::PVariable sendRequest(int32_t scriptId, std::string methodName, BaseLib::PArray& parameters, bool wait);
 	BaseLib::PVariable sendGlobalRequest(std::string methodName, BaseLib::PArray& parameters);
 	void sendResponse(BaseLib::PVariable& packetId, BaseLib::PVariable& variable);
@@ -174,7 +201,7 @@ private:
 	void scriptThread(int32_t id, PScriptInfo scriptInfo, bool sendOutput);
 	void runScript(int32_t id, PScriptInfo scriptInfo);
 	void runNode(int32_t id, PScriptInfo scriptInfo);
-	void checkSessionIdThread(std::string sessionId, bool* result);
+	void checkSessionIdThread(std::string sessionId, bool* result, int64_t* lifetime);
 	BaseLib::PVariable send(std::vector<char>& data);
 
 #ifdef DEBUGSESOCKET
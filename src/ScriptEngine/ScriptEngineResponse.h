@@ -44,6 +44,8 @@ public:
 	std::atomic_bool finished;
 	int32_t packetId = 0;
 	BaseLib::PVariable response;
+	bool async = false; //Sent by "callMethodAsync()". Only these responses count towards the limit of pending asynchronous requests.
+	int64_t time = 0;
 
 	ScriptEngineResponse()
 	{
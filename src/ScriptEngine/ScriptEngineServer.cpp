@@ -154,6 +154,7 @@ ScriptEngineServer::ScriptEngineServer() : IQueue(GD::bl.get(), 3, 1000)
 	_localRpcMethods.emplace("scriptOutput", std::bind(&ScriptEngineServer::scriptOutput, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	_localRpcMethods.emplace("scriptHeaders", std::bind(&ScriptEngineServer::scriptHeaders, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	_localRpcMethods.emplace("peerExists", std::bind(&ScriptEngineServer::peerExists, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	_localRpcMethods.emplace("invalidateSessionId", std::bind(&ScriptEngineServer::invalidateSessionId, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 
 	_localRpcMethods.emplace("listRpcClients", std::bind(&ScriptEngineServer::listRpcClients, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	_localRpcMethods.emplace("raiseDeleteDevice", std::bind(&ScriptEngineServer::raiseDeleteDevice, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
@@ -1555,6 +1556,25 @@ bool ScriptEngineServer::checkSessionId(const std::string& sessionId)
 	try
 	{
 		if(_shuttingDown) return false;
+
+		//Validated session IDs are cached, so reconnecting clients don't start PHP for every connection. Changing or
+		//deleting a user invalidates all cached IDs.
+		uint64_t credentialsVersion = User::credentialsVersion();
+		{
+			std::lock_guard<std::mutex> validSessionIdsGuard(_validSessionIdsMutex);
+			if(_validSessionIdsCredentialsVersion != credentialsVersion)
+			{
+				_validSessionIds.clear();
+				_validSessionIdsCredentialsVersion = credentialsVersion;
+			}
+			auto sessionIdIterator = _validSessionIds.find(sessionId);
+			if(sessionIdIterator != _validSessionIds.end())
+			{
+				if(sessionIdIterator->second >= BaseLib::HelperFunctions::getTime()) return true;
+				_validSessionIds.erase(sessionIdIterator);
+			}
+		}
+
 		PScriptEngineClientData client;
 
 		{
@@ -1584,7 +1604,30 @@ bool ScriptEngineServer::checkSessionId(const std::string& sessionId)
 			GD::out.printError("Error: checkSessionId returned: " + result->structValue->at("faultString")->stringValue);
 			return false;
 		}
-		return result->booleanValue;
+		auto validIterator = result->structValue->find("valid");
+		if(validIterator == result->structValue->end() || !validIterator->second->booleanValue) return false;
+
+		auto lifetimeIterator = result->structValue->find("lifetime");
+		int64_t lifetime = 0;
+		if(lifetimeIterator != result->structValue->end()) lifetime = (lifetimeIterator->second->type == BaseLib::VariableType::tInteger64) ? lifetimeIterator->second->integerValue64 : lifetimeIterator->second->integerValue;
+		if(lifetime > 0)
+		{
+			std::lock_guard<std::mutex> validSessionIdsGuard(_validSessionIdsMutex);
+			if(_validSessionIdsCredentialsVersion == credentialsVersion)
+			{
+				int64_t time = BaseLib::HelperFunctions::getTime();
+				if(_validSessionIds.size() >= _maxValidSessionIds)
+				{
+					for(auto i = _validSessionIds.begin(); i != _validSessionIds.end();)
+					{
+						if(i->second < time) i = _validSessionIds.erase(i);
+						else ++i;
+					}
+				}
+				if(_validSessionIds.size() < _maxValidSessionIds) _validSessionIds[sessionId] = time + std::min(lifetime * 1000, _maxValidSessionIdTimeout);
+			}
+		}
+		return true;
 	}
 	catch(const std::exception& ex)
 	{
@@ -1601,6 +1644,13 @@ bool ScriptEngineServer::checkSessionId(const std::string& sessionId)
 	return false;
 }
 
+void ScriptEngineServer::invalidateSessionId(const std::string& sessionId)
+{
+	std::lock_guard<std::mutex> validSessionIdsGuard(_validSessionIdsMutex);
+	if(sessionId.empty()) _validSessionIds.clear();
+	else _validSessionIds.erase(sessionId);
+}
+
 void ScriptEngineServer::invokeScriptFinished(PScriptEngineProcess process, int32_t id, int32_t exitCode)
 {
 	try
@@ -1991,6 +2041,31 @@ void ScriptEngineServer::unregisterNode(std::string nodeId)
 		return BaseLib::Variable::createError(-32500, "Unknown application error.");
 	}
 
+	BaseLib::PVariable ScriptEngineServer::invalidateSessionId(PScriptEngineClientData& clientData, int32_t scriptId, BaseLib::PArray& parameters)
+	{
+		try
+		{
+			if(parameters->size() > 1) return BaseLib::Variable::createError(-1, "Method expects zero or one parameter.");
+			if(parameters->size() == 1 && parameters->at(0)->type != BaseLib::VariableType::tString) return BaseLib::Variable::createError(-1, "Parameter is not of type string.");
+
+			invalidateSessionId(parameters->empty() ? std::string() : parameters->at(0)->stringValue);
+			return std::make_shared<BaseLib::Variable>();
+		}
+		catch(const std::exception& ex)
+		{
+			_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(BaseLib::Exception& ex)
+		{
+			_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(...)
+		{
+			_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+		}
+		return BaseLib::Variable::createError(-32500, "Unknown application error.");
+	}
+
 	BaseLib::PVariable ScriptEngineServer::listRpcClients(PScriptEngineClientData& clientData, int32_t scriptId, BaseLib::PArray& parameters)
 	{
 		try
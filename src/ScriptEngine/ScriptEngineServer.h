@@ -48,6 +48,7 @@
 #include <thread>
 #include <mutex>
 #include <vector>
+#include <unordered_map>
 #include <iostream>
 #include <string>
 
@@ -70,6 +71,14 @@ public:
 	std::vector<std::tuple<int32_t, uint64_t, int32_t, std::string>> getRunningScripts();
 	void executeScript(PScriptInfo& scriptInfo, bool wait);
 	bool checkSessionId(const std::string& sessionId);
+
+	/**
+	 * Removes a session ID from the cache of validated session IDs. The next call to checkSessionId() for this ID
+	 * validates it by starting the PHP session again.
+	 *
+	 * @param sessionId The session ID to remove. When empty, all cached session IDs are removed.
+	 */
+	void invalidateSessionId(const std::string& sessionId);
 	BaseLib::PVariable executePhpNodeMethod(BaseLib::PArray& parameters);
 	void broadcastEvent(uint64_t id, int32_t channel, std::shared_ptr<std::vector<std::string>> variables, BaseLib::PArray values);
 	void broadcastNewDevices(BaseLib::PVariable deviceDescriptions);
@@ -129,6 +138,11 @@ private:
 	std::thread _scriptFinishedThread;
 	std::mutex _nodeClientIdMapMutex;
 	std::map<std::string, int32_t> _nodeClientIdMap;
+	const uint32_t _maxValidSessionIds = 10000;
+	const int64_t _maxValidSessionIdTimeout = 60000; //Much shorter than session.gc_maxlifetime, so sessions destroyed without calling invalidateSessionId don't stay valid for long.
+	std::mutex _validSessionIdsMutex;
+	std::unordered_map<std::string, int64_t> _validSessionIds;
+	uint64_t _validSessionIdsCredentialsVersion = 0;
 
 	std::unique_ptr<BaseLib::Rpc::RpcDecoder> _rpcDecoder;
 	std::unique_ptr<BaseLib::Rpc::RpcEncoder> _rpcEncoder;
@@ -158,6 +172,7 @@ private:
 		BaseLib::PVariable scriptOutput(PScriptEngineClientData& clientData, int32_t scriptId, BaseLib::PArray& parameters);
 		BaseLib::PVariable scriptHeaders(PScriptEngineClientData& clientData, int32_t scriptId, BaseLib::PArray& parameters);
 		BaseLib::PVariable peerExists(PScriptEngineClientData& clientData, int32_t scriptId, BaseLib::PArray& parameters);
+		BaseLib::PVariable invalidateSessionId(PScriptEngineClientData& clientData, int32_t scriptId, BaseLib::PArray& parameters);
 
 		BaseLib::PVariable listRpcClients(PScriptEngineClientData& clientData, int32_t scriptId, BaseLib::PArray& parameters);
 		BaseLib::PVariable raiseDeleteDevice(PScriptEngineClientData& clientData, int32_t scriptId, BaseLib::PArray& parameters);
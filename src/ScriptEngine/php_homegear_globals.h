@@ -46,6 +46,9 @@ typedef struct _zend_homegear_globals
 	std::function<void(std::string output)> outputCallback;
 	std::function<void(BaseLib::PVariable headers)> sendHeadersCallback;
 	std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters, bool wait)> rpcCallback;
+	std::function<BaseLib::PVariable(std::string methodName, BaseLib::PVariable parameters)> rpcAsyncCallback;
+	std::function<BaseLib::PVariable(int32_t requestId)> rpcAwaitCallback;
+	std::function<void(int32_t requestId)> rpcReleaseCallback;
 	BaseLib::Http http;
 	BaseLib::ScriptEngine::PScriptInfo scriptInfo;
 
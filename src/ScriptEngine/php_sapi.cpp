@@ -56,6 +56,9 @@ static bool _disposed = true;
 static zend_homegear_superglobals _superglobals;
 
 static zend_class_entry* homegear_class_entry = nullptr;
+static zend_class_entry* homegear_async_class_entry = nullptr;
+static zend_class_entry* homegear_future_class_entry = nullptr;
+static zend_object_handlers homegear_future_handlers;
 static zend_class_entry* homegear_gpio_class_entry = nullptr;
 static zend_class_entry* homegear_serial_class_entry = nullptr;
 #ifdef I2CSUPPORT
@@ -524,6 +527,25 @@ void php_homegear_invoke_rpc(std::string& methodName, BaseLib::PVariable& parame
 	PhpVariableConverter::getPHPVariable(result, return_value);
 }
 
+void php_homegear_invoke_rpc_async(std::string& methodName, BaseLib::PVariable& parameters, zval* return_value)
+{
+	if(SEG(id) == 0)
+	{
+		zend_throw_exception(homegear_exception_class_entry, "Script id is unset. Please call \"registerThread\" before calling any Homegear specific method within threads.", -1);
+		RETURN_FALSE
+	}
+	if(!SEG(rpcAsyncCallback)) RETURN_FALSE;
+	if(!parameters) parameters.reset(new BaseLib::Variable(BaseLib::VariableType::tArray));
+	BaseLib::PVariable result = SEG(rpcAsyncCallback)(methodName, parameters);
+	if(result->errorStruct)
+	{
+		zend_throw_exception(homegear_exception_class_entry, result->structValue->at("faultString")->stringValue.c_str(), result->structValue->at("faultCode")->integerValue);
+		RETURN_NULL()
+	}
+	object_init_ex(return_value, homegear_future_class_entry);
+	zend_update_property_long(homegear_future_class_entry, return_value, "requestId", sizeof("requestId") - 1, result->integerValue);
+}
+
 /* RPC functions */
 ZEND_FUNCTION(print_v)
 {
@@ -588,6 +610,9 @@ ZEND_FUNCTION(hg_register_thread)
 	SEG(token) = token;
 	SEG(outputCallback) = phpEvents->getOutputCallback();
 	SEG(rpcCallback) = phpEvents->getRpcCallback();
+	SEG(rpcAsyncCallback) = phpEvents->getRpcAsyncCallback();
+	SEG(rpcAwaitCallback) = phpEvents->getRpcAwaitCallback();
+	SEG(rpcReleaseCallback) = phpEvents->getRpcReleaseCallback();
 	SEG(logLevel) = phpEvents->getLogLevel();
 	SEG(peerId) = phpEvents->getPeerId();
 	RETURN_TRUE
@@ -879,7 +904,7 @@ ZEND_FUNCTION(hg_poll_event)
 			zend_throw_exception(homegear_exception_class_entry, "Script id is invalid.", -1);
 			RETURN_FALSE
 		}
-		if(!eventsIterator->second) eventsIterator->second = std::make_shared<PhpEvents>(SEG(token), SEG(outputCallback), SEG(rpcCallback));
+		if(!eventsIterator->second) eventsIterator->second = std::make_shared<PhpEvents>(SEG(token), SEG(outputCallback), SEG(rpcCallback), SEG(rpcAsyncCallback), SEG(rpcAwaitCallback), SEG(rpcReleaseCallback));
 		phpEvents = eventsIterator->second;
 	}
 	std::shared_ptr<PhpEvents::EventData> eventData = phpEvents->poll(timeout);
@@ -995,7 +1020,7 @@ ZEND_FUNCTION(hg_subscribe_peer)
 			zend_throw_exception(homegear_exception_class_entry, "Script id is invalid.", -1);
 			RETURN_FALSE
 		}
-		if(!eventsIterator->second) eventsIterator->second.reset(new PhpEvents(SEG(token), SEG(outputCallback), SEG(rpcCallback)));
+		if(!eventsIterator->second) eventsIterator->second.reset(new PhpEvents(SEG(token), SEG(outputCallback), SEG(rpcCallback), SEG(rpcAsyncCallback), SEG(rpcAwaitCallback), SEG(rpcReleaseCallback)));
 		phpEvents = eventsIterator->second;
 	}
 	phpEvents->addPeer(peerId, channel, variable);
@@ -1055,7 +1080,7 @@ ZEND_FUNCTION(hg_unsubscribe_peer)
 			zend_throw_exception(homegear_exception_class_entry, "Script id is invalid.", -1);
 			RETURN_FALSE
 		}
-		if(!eventsIterator->second) eventsIterator->second.reset(new PhpEvents(SEG(token), SEG(outputCallback), SEG(rpcCallback)));
+		if(!eventsIterator->second) eventsIterator->second.reset(new PhpEvents(SEG(token), SEG(outputCallback), SEG(rpcCallback), SEG(rpcAsyncCallback), SEG(rpcAwaitCallback), SEG(rpcReleaseCallback)));
 		phpEvents = eventsIterator->second;
 	}
 	phpEvents->removePeer(peerId, channel, variable);
@@ -1818,6 +1843,73 @@ ZEND_METHOD(Homegear, __callStatic)
 	php_homegear_invoke_rpc(methodName, parameters, return_value, true);
 }
 
+ZEND_METHOD(Homegear, async)
+{
+	if(_disposed) RETURN_NULL();
+	object_init_ex(return_value, homegear_async_class_entry);
+}
+
+ZEND_METHOD(HomegearAsync, __call)
+{
+	if(_disposed) RETURN_NULL();
+	zval* zMethodName = nullptr;
+	zval* args = nullptr;
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "zz", &zMethodName, &args) != SUCCESS) RETURN_NULL();
+	std::string methodName(std::string(Z_STRVAL_P(zMethodName), Z_STRLEN_P(zMethodName)));
+	BaseLib::PVariable parameters = PhpVariableConverter::getVariable(args);
+	php_homegear_invoke_rpc_async(methodName, parameters, return_value);
+}
+
+static zend_object* homegear_future_create(zend_class_entry* classEntry)
+{
+	zend_object* object = (zend_object*)ecalloc(1, sizeof(zend_object) + zend_object_properties_size(classEntry));
+	zend_object_std_init(object, classEntry);
+	object_properties_init(object, classEntry);
+	object->handlers = &homegear_future_handlers;
+	return object;
+}
+
+static void homegear_future_free(zend_object* object)
+{
+	//Release the response slot of requests whose result was never retrieved, so they don't count towards the limit of pending requests anymore.
+	if(!_disposed && SEG(rpcReleaseCallback))
+	{
+		zval zObject;
+		ZVAL_OBJ(&zObject, object);
+		zval returnValue;
+		zval* retrieved = zend_read_property(homegear_future_class_entry, &zObject, "retrieved", sizeof("retrieved") - 1, 1, &returnValue);
+		zval* requestId = zend_read_property(homegear_future_class_entry, &zObject, "requestId", sizeof("requestId") - 1, 1, &returnValue);
+		if((!retrieved || Z_TYPE_P(retrieved) != IS_TRUE) && requestId && Z_TYPE_P(requestId) == IS_LONG && Z_LVAL_P(requestId) >= 0) SEG(rpcReleaseCallback)(Z_LVAL_P(requestId));
+	}
+	zend_object_std_dtor(object);
+}
+
+ZEND_METHOD(HomegearFuture, get)
+{
+	if(_disposed) RETURN_NULL();
+	zval* object = getThis();
+	if(!object) RETURN_NULL();
+	zval returnValue;
+	zval* retrieved = zend_read_property(homegear_future_class_entry, object, "retrieved", sizeof("retrieved") - 1, 1, &returnValue);
+	if(retrieved && Z_TYPE_P(retrieved) == IS_TRUE)
+	{
+		zval* cachedResult = zend_read_property(homegear_future_class_entry, object, "result", sizeof("result") - 1, 1, &returnValue);
+		if(cachedResult) ZVAL_COPY(return_value, cachedResult);
+		return;
+	}
+	zval* requestId = zend_read_property(homegear_future_class_entry, object, "requestId", sizeof("requestId") - 1, 1, &returnValue);
+	if(!requestId || Z_TYPE_P(requestId) != IS_LONG || !SEG(rpcAwaitCallback)) RETURN_FALSE;
+	BaseLib::PVariable result = SEG(rpcAwaitCallback)(Z_LVAL_P(requestId));
+	zend_update_property_bool(homegear_future_class_entry, object, "retrieved", sizeof("retrieved") - 1, 1);
+	if(result->errorStruct)
+	{
+		zend_throw_exception(homegear_exception_class_entry, result->structValue->at("faultString")->stringValue.c_str(), result->structValue->at("faultCode")->integerValue);
+		RETURN_NULL()
+	}
+	PhpVariableConverter::getPHPVariable(result, return_value);
+	zend_update_property(homegear_future_class_entry, object, "result", sizeof("result") - 1, return_value);
+}
+
 ZEND_BEGIN_ARG_INFO_EX(php_homegear_two_args, 0, 0, 2)
 	ZEND_ARG_INFO(0, arg1)
 	ZEND_ARG_INFO(0, arg2)
@@ -1826,6 +1918,7 @@ ZEND_END_ARG_INFO()
 static const zend_function_entry homegear_methods[] = {
 	ZEND_ME(Homegear, __call, php_homegear_two_args, ZEND_ACC_PRIVATE)
 	ZEND_ME(Homegear, __callStatic, php_homegear_two_args, ZEND_ACC_PRIVATE | ZEND_ACC_STATIC)
+	ZEND_ME(Homegear, async, NULL, ZEND_ACC_PUBLIC)
 	ZEND_ME_MAPPING(getScriptId, hg_get_script_id, NULL, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
 	ZEND_ME_MAPPING(registerThread, hg_register_thread, NULL, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
 	ZEND_ME_MAPPING(log, hg_log, NULL, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
@@ -1839,6 +1932,16 @@ static const zend_function_entry homegear_methods[] = {
 	{NULL, NULL, NULL}
 };
 
+static const zend_function_entry homegear_async_methods[] = {
+	ZEND_ME(HomegearAsync, __call, php_homegear_two_args, ZEND_ACC_PRIVATE)
+	{NULL, NULL, NULL}
+};
+
+static const zend_function_entry homegear_future_methods[] = {
+	ZEND_ME(HomegearFuture, get, NULL, ZEND_ACC_PUBLIC)
+	{NULL, NULL, NULL}
+};
+
 static const zend_function_entry homegear_gpio_methods[] = {
 	ZEND_ME_MAPPING(export, hg_gpio_export, NULL, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
 	ZEND_ME_MAPPING(open, hg_gpio_open, NULL, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
@@ -2060,6 +2163,21 @@ static PHP_MINIT_FUNCTION(homegear)
 	zend_declare_class_constant_stringl(homegear_class_entry, "LOGFILE_PATH", sizeof("LOGFILE_PATH") - 1, GD::bl->settings.logfilePath().c_str(), GD::bl->settings.logfilePath().size());
 	zend_declare_class_constant_stringl(homegear_class_entry, "WORKING_DIRECTORY", sizeof("WORKING_DIRECTORY") - 1, GD::bl->settings.workingDirectory().c_str(), GD::bl->settings.workingDirectory().size());
 
+	zend_class_entry homegearAsyncCe;
+	INIT_CLASS_ENTRY(homegearAsyncCe, "Homegear\\HomegearAsync", homegear_async_methods);
+	homegear_async_class_entry = zend_register_internal_class(&homegearAsyncCe);
+
+	zend_class_entry homegearFutureCe;
+	INIT_CLASS_ENTRY(homegearFutureCe, "Homegear\\HomegearFuture", homegear_future_methods);
+	homegear_future_class_entry = zend_register_internal_class(&homegearFutureCe);
+	zend_declare_property_long(homegear_future_class_entry, "requestId", sizeof("requestId") - 1, -1, ZEND_ACC_PRIVATE);
+	zend_declare_property_bool(homegear_future_class_entry, "retrieved", sizeof("retrieved") - 1, 0, ZEND_ACC_PRIVATE);
+	zend_declare_property_null(homegear_future_class_entry, "result", sizeof("result") - 1, ZEND_ACC_PRIVATE);
+	homegear_future_class_entry->create_object = homegear_future_create;
+	memcpy(&homegear_future_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+	homegear_future_handlers.free_obj = homegear_future_free;
+	homegear_future_handlers.clone_obj = nullptr; //A clone would release the request of the original.
+
 	zend_class_entry homegearGpioCe;
 	INIT_CLASS_ENTRY(homegearGpioCe, "Homegear\\HomegearGpio", homegear_gpio_methods);
 	homegear_gpio_class_entry = zend_register_internal_class(&homegearGpioCe);
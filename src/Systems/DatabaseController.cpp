@@ -1399,6 +1399,32 @@ void DatabaseController::saveEventAsynchronous(BaseLib::Database::DataRow& event
 	else GD::out.printError("Error: Either eventID is 0 or the number of columns is invalid.");
 }
 
+void DatabaseController::saveEventStateAsynchronous(BaseLib::Database::DataRow& eventState)
+{
+	try
+	{
+		if(eventState.size() != 5)
+		{
+			GD::out.printError("Error: The number of columns is invalid.");
+			return;
+		}
+		std::shared_ptr<BaseLib::IQueueEntry> entry = std::make_shared<QueueEntry>("UPDATE events SET lastValue=?, lastRaised=?, lastReset=?, currentTime=? WHERE name=?", eventState);
+		enqueue(0, entry);
+	}
+	catch(const std::exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+
 void DatabaseController::deleteEvent(std::string& name)
 {
 	try
@@ -113,6 +113,13 @@ public:
 	// {{{ Events
 		virtual std::shared_ptr<BaseLib::Database::DataTable> getEvents();
 		virtual void saveEventAsynchronous(BaseLib::Database::DataRow& event);
+
+		/**
+		 * Only updates the columns of an event that change when it is raised or reset.
+		 *
+		 * @param eventState The columns lastValue, lastRaised, lastReset and currentTime followed by the name of the event.
+		 */
+		void saveEventStateAsynchronous(BaseLib::Database::DataRow& eventState);
 		virtual void deleteEvent(std::string& name);
 	// }}}
 
@@ -746,32 +746,85 @@ void FamilyController::loadModules()
     _moduleLoadersMutex.unlock();
 }
 
+void FamilyController::initAndLoadFamily(std::shared_ptr<BaseLib::Systems::DeviceFamily> family, bool* success)
+{
+	try
+	{
+		*success = false;
+		if(!family->enabled()) GD::out.printInfo("Info: Not initializing device family " + family->getName() + ", because it is disabled in it's configuration file.");
+		else if(!familyAvailable(family->getFamily())) GD::out.printInfo("Info: Not initializing device family " + family->getName() + ", because no physical interface was found.");
+		else if(!family->init()) GD::out.printError("Error: Could not initialize device family " + family->getName() + ".");
+		else
+		{
+			family->load();
+			*success = true;
+		}
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
 void FamilyController::load()
 {
 	try
 	{
 		std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>> families = getFamilies();
+
+		//Families are initialized and loaded in parallel. Families without physical interface (like scripting families)
+		//can reference peers of other families, so they are loaded after all other families.
+		std::vector<std::vector<std::shared_ptr<BaseLib::Systems::DeviceFamily>>> stages(2);
 		for(std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>>::iterator i = families.begin(); i != families.end(); ++i)
 		{
-			if(!i->second->enabled() || !familyAvailable(i->first) || !i->second->init())
+			if(_familiesWithoutPhysicalInterface.find(i->first) == _familiesWithoutPhysicalInterface.end()) stages.at(0).push_back(i->second);
+			else stages.at(1).push_back(i->second);
+		}
+
+		for(auto& stage : stages)
+		{
+			if(stage.empty()) continue;
+			std::unique_ptr<bool[]> results(new bool[stage.size()]);
+			std::vector<std::thread> threads(stage.size());
+			for(uint32_t i = 0; i < stage.size(); i++)
+			{
+				results[i] = false;
+				if(!GD::bl->threadManager.start(threads.at(i), false, &FamilyController::initAndLoadFamily, this, stage.at(i), &results[i]))
+				{
+					initAndLoadFamily(stage.at(i), &results[i]); //No thread available. Load family in this thread.
+				}
+			}
+			for(auto& thread : threads)
+			{
+				GD::bl->threadManager.join(thread);
+			}
+
+			for(uint32_t i = 0; i < stage.size(); i++)
 			{
-				if(!i->second->enabled()) GD::out.printInfo("Info: Not initializing device family " + i->second->getName() + ", because it is disabled in it's configuration file.");
-				else if(familyAvailable(i->first)) GD::out.printError("Error: Could not initialize device family " + i->second->getName() + ".");
-				else GD::out.printInfo("Info: Not initializing device family " + i->second->getName() + ", because no physical interface was found.");
-				i->second->dispose();
-				i->second.reset();
-				_families[i->first].reset();
-				_moduleLoadersMutex.lock();
-				std::map<std::string, std::unique_ptr<ModuleLoader>>::iterator moduleIterator = _moduleLoaders.find(_moduleFilenames[i->first]);
+				if(results[i]) continue;
+				int32_t familyId = stage.at(i)->getFamily();
+				stage.at(i)->dispose();
+				stage.at(i).reset();
+				{
+					std::lock_guard<std::mutex> familiesGuard(_familiesMutex);
+					_families[familyId].reset();
+				}
+				std::lock_guard<std::mutex> moduleLoadersGuard(_moduleLoadersMutex);
+				std::map<std::string, std::unique_ptr<ModuleLoader>>::iterator moduleIterator = _moduleLoaders.find(_moduleFilenames[familyId]);
 				if(moduleIterator != _moduleLoaders.end())
 				{
 					moduleIterator->second->dispose();
 					_moduleLoaders.erase(moduleIterator);
 				}
-				_moduleLoadersMutex.unlock();
-				continue;
 			}
-			i->second->load();
 		}
 	}
 	catch(const std::exception& ex)
@@ -792,6 +845,7 @@ void FamilyController::disposeDeviceFamilies()
 {
 	try
 	{
+		stopCentralCallThreads();
 		std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>> families = getFamilies();
 		for(std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>>::iterator i = families.begin(); i != families.end(); ++i)
 		{
@@ -822,7 +876,12 @@ void FamilyController::dispose()
 	try
 	{
 		if(_disposed) return;
-		_disposed = true;
+		{
+			std::lock_guard<std::mutex> waitGuard(_physicalInterfaceWaitMutex);
+			_disposed = true;
+		}
+		_physicalInterfaceConditionVariable.notify_all();
+		stopCentralCallThreads();
 		_rpcCache.reset();
 		_familiesMutex.lock();
 		_currentFamily.reset();
@@ -948,6 +1007,244 @@ std::shared_ptr<BaseLib::Systems::DeviceFamily> FamilyController::getFamily(int3
     return std::shared_ptr<BaseLib::Systems::DeviceFamily>();
 }
 
+std::map<int32_t, BaseLib::PVariable> FamilyController::callCentrals(const std::string& methodName, CentralMethod method, int32_t familyId, int32_t timeout, bool* timedOut)
+{
+	std::map<int32_t, BaseLib::PVariable> results;
+	if(timedOut) *timedOut = false;
+	try
+	{
+		if(timeout <= 0) timeout = 10000;
+		PCentralCallBatch batch = std::make_shared<CentralCallBatch>();
+		std::vector<PCentralCall> calls;
+		std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>> families = getFamilies();
+		std::set<int32_t> hangingFamilies;
+		{
+			std::lock_guard<std::mutex> queueGuard(_centralCallQueueMutex);
+			for(std::map<int32_t, uint32_t>::iterator i = _abandonedCentralCalls.begin(); i != _abandonedCentralCalls.end(); ++i)
+			{
+				hangingFamilies.insert(i->first);
+			}
+		}
+		for(std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>>::iterator i = families.begin(); i != families.end(); ++i)
+		{
+			if(familyId != -1 && i->first != familyId) continue;
+			if(hangingFamilies.find(i->first) != hangingFamilies.end())
+			{
+				//The previous call to this family didn't return yet. Calling it again would only occupy another thread.
+				if(timedOut) *timedOut = true;
+				GD::out.printWarning("Warning: Not calling \"" + methodName + "\" on device family " + i->second->getName() + ", because a previous call still didn't return.");
+				continue;
+			}
+			std::shared_ptr<BaseLib::Systems::ICentral> central = i->second->getCentral();
+			if(!central) continue;
+			PCentralCall call = std::make_shared<CentralCall>();
+			call->familyId = i->first;
+			call->central = central;
+			call->method = method;
+			call->batch = batch;
+			calls.push_back(call);
+		}
+		if(calls.empty()) return results;
+		batch->pending = calls.size();
+
+		bool queued = false;
+		if(calls.size() > 1)
+		{
+			std::lock_guard<std::mutex> queueGuard(_centralCallQueueMutex);
+			if(!_stopCentralCallThreads)
+			{
+				while(_centralCallThreads.size() < _maxCentralCallThreads && _centralCallThreads.size() < calls.size())
+				{
+					_centralCallThreads.emplace_back();
+					if(!GD::bl->threadManager.start(_centralCallThreads.back(), false, &FamilyController::centralCallThread, this))
+					{
+						_centralCallThreads.pop_back();
+						break;
+					}
+				}
+				if(!_centralCallThreads.empty())
+				{
+					_centralCallQueue.insert(_centralCallQueue.end(), calls.begin(), calls.end());
+					queued = true;
+				}
+			}
+		}
+
+		if(queued)
+		{
+			_centralCallQueueConditionVariable.notify_all();
+
+			{
+				std::unique_lock<std::mutex> batchGuard(batch->mutex);
+				batch->conditionVariable.wait_for(batchGuard, std::chrono::milliseconds(timeout), [&] { return batch->pending == 0; });
+			}
+
+			{
+				//Calls still running are not waited for anymore. Calls still queued are skipped. Lock order: queue, then batch.
+				std::lock_guard<std::mutex> queueGuard(_centralCallQueueMutex);
+				std::lock_guard<std::mutex> batchGuard(batch->mutex);
+				if(batch->pending > 0)
+				{
+					batch->abandoned = true;
+					for(std::vector<PCentralCall>::iterator i = calls.begin(); i != calls.end(); ++i)
+					{
+						if((*i)->finished) continue;
+						(*i)->abandoned = true;
+						_abandonedCentralCalls[(*i)->familyId]++;
+					}
+				}
+			}
+
+			std::lock_guard<std::mutex> batchGuard(batch->mutex);
+			for(std::vector<PCentralCall>::iterator i = calls.begin(); i != calls.end(); ++i)
+			{
+				if((*i)->abandoned)
+				{
+					if(timedOut) *timedOut = true;
+					std::shared_ptr<BaseLib::Systems::DeviceFamily> family = families.at((*i)->familyId);
+					GD::out.printWarning("Warning: Device family " + family->getName() + " did not respond to \"" + methodName + "\" within " + std::to_string(timeout) + "ms.");
+					continue;
+				}
+				if((*i)->result) results[(*i)->familyId] = (*i)->result;
+			}
+		}
+		else
+		{
+			//Only one central or no thread available. Call the centrals in this thread.
+			for(std::vector<PCentralCall>::iterator i = calls.begin(); i != calls.end(); ++i)
+			{
+				executeCentralCall(*i);
+				if((*i)->result) results[(*i)->familyId] = (*i)->result;
+			}
+		}
+	}
+	catch(const std::exception& ex)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+    return results;
+}
+
+void FamilyController::executeCentralCall(PCentralCall& call)
+{
+	try
+	{
+		{
+			std::lock_guard<std::mutex> batchGuard(call->batch->mutex);
+			if(call->batch->abandoned) return;
+		}
+		call->result = call->method(call->central);
+	}
+	catch(const std::exception& ex)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+	std::lock_guard<std::mutex> batchGuard(call->batch->mutex);
+	call->finished = true;
+	if(call->batch->pending > 0) call->batch->pending--;
+	call->batch->conditionVariable.notify_one();
+}
+
+void FamilyController::centralCallThread()
+{
+	while(true)
+	{
+		try
+		{
+			PCentralCall call;
+			{
+				std::unique_lock<std::mutex> queueGuard(_centralCallQueueMutex);
+				_centralCallQueueConditionVariable.wait(queueGuard, [&] { return _stopCentralCallThreads || !_centralCallQueue.empty(); });
+				if(_stopCentralCallThreads) return;
+				call = _centralCallQueue.front();
+				_centralCallQueue.pop_front();
+			}
+			executeCentralCall(call);
+
+			std::lock_guard<std::mutex> queueGuard(_centralCallQueueMutex);
+			if(call->abandoned)
+			{
+				auto abandonedCallsIterator = _abandonedCentralCalls.find(call->familyId);
+				if(abandonedCallsIterator != _abandonedCentralCalls.end())
+				{
+					if(abandonedCallsIterator->second > 1) abandonedCallsIterator->second--;
+					else _abandonedCentralCalls.erase(abandonedCallsIterator);
+				}
+				GD::out.printInfo("Info: Abandoned call to device family " + std::to_string(call->familyId) + " returned.");
+			}
+		}
+		catch(const std::exception& ex)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(BaseLib::Exception& ex)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+		}
+		catch(...)
+		{
+			GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+		}
+	}
+}
+
+void FamilyController::stopCentralCallThreads()
+{
+	try
+	{
+		std::vector<std::thread> threads;
+		std::deque<PCentralCall> queue;
+		{
+			std::lock_guard<std::mutex> queueGuard(_centralCallQueueMutex);
+			_stopCentralCallThreads = true;
+			threads.swap(_centralCallThreads);
+			queue.swap(_centralCallQueue);
+		}
+		_centralCallQueueConditionVariable.notify_all();
+
+		//Release callers waiting for calls that are not executed anymore.
+		for(std::deque<PCentralCall>::iterator i = queue.begin(); i != queue.end(); ++i)
+		{
+			std::lock_guard<std::mutex> batchGuard((*i)->batch->mutex);
+			if((*i)->batch->pending > 0) (*i)->batch->pending--;
+			(*i)->batch->conditionVariable.notify_one();
+		}
+
+		for(std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i)
+		{
+			GD::bl->threadManager.join(*i);
+		}
+	}
+	catch(const std::exception& ex)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+        GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+}
+
 bool FamilyController::peerExists(uint64_t peerId)
 {
 	try
@@ -1189,6 +1486,35 @@ bool FamilyController::physicalInterfaceIsOpen()
 	return false;
 }
 
+bool FamilyController::waitForPhysicalInterfaces(int32_t timeout)
+{
+	try
+	{
+		int64_t endTime = BaseLib::HelperFunctions::getTime() + timeout;
+		std::unique_lock<std::mutex> waitLock(_physicalInterfaceWaitMutex);
+		while(!_disposed)
+		{
+			if(physicalInterfaceIsOpen()) return true;
+			if(BaseLib::HelperFunctions::getTime() >= endTime) return false;
+			//Check often, so startup continues right after the last interface is connected. dispose() wakes us up.
+			_physicalInterfaceConditionVariable.wait_for(waitLock, std::chrono::milliseconds(100), [&] { return _disposed; });
+		}
+	}
+	catch(const std::exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(BaseLib::Exception& ex)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+    }
+    catch(...)
+    {
+    	GD::out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+    }
+	return false;
+}
+
 void FamilyController::physicalInterfaceStartListening()
 {
 	try
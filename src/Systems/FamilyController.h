@@ -38,6 +38,10 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <deque>
 
 #include <dlfcn.h>
 
@@ -77,6 +81,8 @@ public:
 		bool loaded;
 	};
 
+	typedef std::function<BaseLib::PVariable(std::shared_ptr<BaseLib::Systems::ICentral>& central)> CentralMethod;
+
 	// {{{ Family event handling
 		//Hooks
 		virtual void onAddWebserverEventHandler(BaseLib::Rpc::IWebserverEventSink* eventHandler, std::map<int32_t, BaseLib::PEventHandler>& eventHandlers);
@@ -130,6 +136,11 @@ public:
 	int32_t reloadModule(std::string filename);
 
 	void loadModules();
+
+	/**
+	 * Initializes and loads all device families. Families are loaded in parallel. Families without physical interface are
+	 * loaded after all other families.
+	 */
 	void load();
 	void save(bool full);
 	bool familySelected() { return (bool)_currentFamily; }
@@ -146,6 +157,21 @@ public:
 	 */
 	std::shared_ptr<BaseLib::Systems::DeviceFamily> getFamily(int32_t familyId);
 
+	/**
+	 * Calls a method on the centrals of all families in parallel. The calls are executed by a bounded pool of worker
+	 * threads. Families not responding within the timeout are left out of the result, so one slow family can't stall
+	 * the whole response. Families with an abandoned call that is still running are not called again until that call
+	 * returns, so a hanging family can't occupy all worker threads.
+	 *
+	 * @param methodName The name of the method. Only used for log messages.
+	 * @param method The function to execute for each central. It may return an empty pointer to skip the central.
+	 * @param familyId Only call the central of this family. -1 calls the centrals of all families.
+	 * @param timeout The maximum time in milliseconds to wait for a family, measured from when the call is queued. Values less than or equal to 0 use the default of 10000.
+	 * @param timedOut When not nullptr, set to true if at least one family did not respond within the timeout and false otherwise.
+	 * @return Returns the non-empty results ordered by family ID.
+	 */
+	std::map<int32_t, BaseLib::PVariable> callCentrals(const std::string& methodName, CentralMethod method, int32_t familyId = -1, int32_t timeout = 10000, bool* timedOut = nullptr);
+
 	/*
 	 * Checks if the peer with the provided id exists.
 	 */
@@ -167,15 +193,52 @@ public:
 	void physicalInterfaceStopListening();
 	void physicalInterfaceStartListening();
 	bool physicalInterfaceIsOpen();
+
+	/**
+	 * Waits until all physical interfaces are open.
+	 *
+	 * @param timeout The maximum time to wait in milliseconds.
+	 * @return Returns true when all interfaces are open and false on timeout or when the family controller is disposed.
+	 */
+	bool waitForPhysicalInterfaces(int32_t timeout);
 	void physicalInterfaceSetup(int32_t userID, int32_t groupID, bool setPermissions);
 	BaseLib::PVariable listInterfaces(int32_t familyID);
 	// }}}
 
 	BaseLib::PVariable listFamilies();
 private:
+	struct CentralCallBatch
+	{
+		std::mutex mutex;
+		std::condition_variable conditionVariable;
+		uint32_t pending = 0;
+		bool abandoned = false;
+	};
+	typedef std::shared_ptr<CentralCallBatch> PCentralCallBatch;
+
+	struct CentralCall
+	{
+		int32_t familyId = -1;
+		std::shared_ptr<BaseLib::Systems::ICentral> central;
+		CentralMethod method;
+		BaseLib::PVariable result;
+		bool finished = false;
+		bool abandoned = false; //Guarded by _centralCallQueueMutex
+		PCentralCallBatch batch;
+	};
+	typedef std::shared_ptr<CentralCall> PCentralCall;
+
 	bool _disposed = false;
 	BaseLib::PVariable _rpcCache;
 
+	const uint32_t _maxCentralCallThreads = 8;
+	std::mutex _centralCallQueueMutex;
+	std::condition_variable _centralCallQueueConditionVariable;
+	std::deque<PCentralCall> _centralCallQueue;
+	std::vector<std::thread> _centralCallThreads;
+	bool _stopCentralCallThreads = false;
+	std::map<int32_t, uint32_t> _abandonedCentralCalls; //Number of abandoned calls per family, that are still queued or running.
+
 	std::set<int32_t> _familiesWithoutPhysicalInterface;
 	std::mutex _moduleLoadersMutex;
 	std::map<std::string, std::unique_ptr<ModuleLoader>> _moduleLoaders;
@@ -185,6 +248,14 @@ private:
 	std::map<int32_t, std::shared_ptr<BaseLib::Systems::DeviceFamily>> _families;
 	std::shared_ptr<BaseLib::Systems::DeviceFamily> _currentFamily;
 
+	std::mutex _physicalInterfaceWaitMutex;
+	std::condition_variable _physicalInterfaceConditionVariable;
+
+	void initAndLoadFamily(std::shared_ptr<BaseLib::Systems::DeviceFamily> family, bool* success);
+	void executeCentralCall(PCentralCall& call);
+	void centralCallThread();
+	void stopCentralCallThreads();
+
 	FamilyController(const FamilyController&);
 	FamilyController& operator=(const FamilyController&);
 };
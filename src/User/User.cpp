@@ -32,6 +32,37 @@
 #include "../GD/GD.h"
 #include <homegear-base/BaseLib.h>
 
+std::atomic<uint64_t> User::_credentialsVersion(0);
+std::mutex User::_verifiedCredentialsMutex;
+std::vector<uint8_t> User::_verifiedCredentialsKey;
+std::map<std::string, User::VerifiedCredentials> User::_verifiedCredentials;
+
+std::vector<uint8_t> User::getCredentialsDigest(const std::string& userName, const std::string& password)
+{
+	//Only call with _verifiedCredentialsMutex locked.
+	if(_verifiedCredentialsKey.empty())
+	{
+		_verifiedCredentialsKey.resize(32);
+		gcry_randomize(&_verifiedCredentialsKey.at(0), _verifiedCredentialsKey.size(), GCRY_STRONG_RANDOM);
+	}
+	std::vector<char> data;
+	data.reserve(_verifiedCredentialsKey.size() + userName.size() + 1 + password.size());
+	data.insert(data.end(), _verifiedCredentialsKey.begin(), _verifiedCredentialsKey.end());
+	data.insert(data.end(), userName.begin(), userName.end());
+	data.push_back(':');
+	data.insert(data.end(), password.begin(), password.end());
+	std::vector<uint8_t> digest(gcry_md_get_algo_dlen(GCRY_MD_SHA256));
+	gcry_md_hash_buffer(GCRY_MD_SHA256, &digest.at(0), &data.at(0), data.size());
+	return digest;
+}
+
+void User::invalidateVerifiedCredentials(const std::string& userName)
+{
+	std::lock_guard<std::mutex> verifiedCredentialsGuard(_verifiedCredentialsMutex);
+	_verifiedCredentials.erase(userName);
+	_credentialsVersion++;
+}
+
 std::vector<unsigned char> User::generateWHIRLPOOL(const std::string& password, std::vector<unsigned char>& salt)
 {
 	std::vector<char> passwordBytes;
@@ -71,6 +102,20 @@ bool User::verify(const std::string& userName, const std::string& password)
 {
 	try
 	{
+		//Successfully verified credentials are cached for a short time, so clients authenticating every request don't cause
+		//a database query and a WHIRLPOOL calculation each time. Only a keyed digest of the credentials is stored.
+		std::vector<uint8_t> credentialsDigest;
+		uint64_t credentialsVersion = _credentialsVersion;
+		{
+			std::lock_guard<std::mutex> verifiedCredentialsGuard(_verifiedCredentialsMutex);
+			credentialsDigest = getCredentialsDigest(userName, password);
+			auto credentialsIterator = _verifiedCredentials.find(userName);
+			if(credentialsIterator != _verifiedCredentials.end())
+			{
+				if(credentialsIterator->second.expirationTime >= BaseLib::HelperFunctions::getTime() && credentialsIterator->second.digest == credentialsDigest) return true;
+			}
+		}
+
 		std::shared_ptr<BaseLib::Database::DataTable> rows = GD::bl->db->getPassword(userName);
 		if(rows->empty() || rows->at(0).empty() || rows->at(0).size() != 2) return false;
 		std::vector<unsigned char> salt;
@@ -79,8 +124,24 @@ bool User::verify(const std::string& userName, const std::string& password)
 		storedHash.insert(storedHash.begin(), rows->at(0).at(0)->binaryValue->begin(), rows->at(0).at(0)->binaryValue->end());
 		std::vector<unsigned char> hash = generateWHIRLPOOL(password, salt);
 		if(hash.empty()) return false;
-		if(hash == storedHash) return true;
-		return false;
+		if(hash != storedHash) return false;
+
+		std::lock_guard<std::mutex> verifiedCredentialsGuard(_verifiedCredentialsMutex);
+		if(credentialsVersion != _credentialsVersion) return true; //User was changed while verifying. Don't cache.
+		int64_t time = BaseLib::HelperFunctions::getTime();
+		if(_verifiedCredentials.size() >= _maxVerifiedCredentials)
+		{
+			for(auto i = _verifiedCredentials.begin(); i != _verifiedCredentials.end();)
+			{
+				if(i->second.expirationTime < time) i = _verifiedCredentials.erase(i);
+				else ++i;
+			}
+			if(_verifiedCredentials.size() >= _maxVerifiedCredentials) return true;
+		}
+		VerifiedCredentials& verifiedCredentials = _verifiedCredentials[userName];
+		verifiedCredentials.digest = credentialsDigest;
+		verifiedCredentials.expirationTime = time + _verifiedCredentialsTimeout;
+		return true;
 	}
 	catch(std::exception& ex)
 	{
@@ -111,8 +172,11 @@ bool User::remove(const std::string& userName)
 		uint64_t userID = GD::bl->db->getUserID(userName);
 		if(userID == 0) return false;
 
-		if(GD::bl->db->deleteUser(userID)) return true;
-		return false;
+		invalidateVerifiedCredentials(userName);
+		bool result = GD::bl->db->deleteUser(userID);
+		//Invalidate again after the database was written. Credentials verified against the old entry in the meantime are dropped, too.
+		invalidateVerifiedCredentials(userName);
+		return result;
 	}
 	catch(std::exception& ex)
 	{
@@ -157,7 +221,11 @@ bool User::update(const std::string& userName, const std::string& password)
 		std::vector<uint8_t> salt;
 		std::vector<uint8_t> passwordHash = User::generateWHIRLPOOL(password, salt);
 
-		if(GD::bl->db->updateUser(userID, passwordHash, salt)) return true;
+		invalidateVerifiedCredentials(userName);
+		bool result = GD::bl->db->updateUser(userID, passwordHash, salt);
+		//Invalidate again after the database was written. Credentials verified against the old hash in the meantime are dropped, too.
+		invalidateVerifiedCredentials(userName);
+		return result;
 	}
 	catch(std::exception& ex)
 	{
@@ -36,6 +36,8 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <atomic>
 
 #include <gcrypt.h>
 
@@ -52,6 +54,28 @@ public:
 	static bool update(const std::string& userName, const std::string& password);
 	static bool remove(const std::string& userName);
 	static bool getAll(std::map<uint64_t, std::string>& users);
+
+	/**
+	 * Returns a number that changes every time a user is updated or removed. It can be used to invalidate credentials
+	 * cached elsewhere.
+	 */
+	static uint64_t credentialsVersion() { return _credentialsVersion; }
+private:
+	struct VerifiedCredentials
+	{
+		std::vector<uint8_t> digest;
+		int64_t expirationTime = 0;
+	};
+
+	static const int64_t _verifiedCredentialsTimeout = 60000;
+	static const uint32_t _maxVerifiedCredentials = 1000;
+	static std::atomic<uint64_t> _credentialsVersion;
+	static std::mutex _verifiedCredentialsMutex;
+	static std::vector<uint8_t> _verifiedCredentialsKey;
+	static std::map<std::string, VerifiedCredentials> _verifiedCredentials;
+
+	static std::vector<uint8_t> getCredentialsDigest(const std::string& userName, const std::string& password);
+	static void invalidateVerifiedCredentials(const std::string& userName);
 };
 
 #endif
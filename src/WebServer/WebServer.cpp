@@ -2,8 +2,19 @@
 #include "../UPnP/UPnP.h"
 #include "WebServer.h"
 
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+
 namespace WebServer
 {
+static inline int64_t getModificationTime(const struct stat& statStruct)
+{
+	//Nanosecond resolution, so changes within the same second are detected.
+	return ((int64_t)statStruct.st_mtim.tv_sec * 1000000000) + statStruct.st_mtim.tv_nsec;
+}
+
 WebServer::WebServer(std::shared_ptr<BaseLib::Rpc::ServerInfo::Info>& serverInfo)
 {
 	_out.init(GD::bl.get());
@@ -17,7 +28,7 @@ WebServer::~WebServer()
 {
 }
 
-void WebServer::get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> socket)
+void WebServer::get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> socket, bool allowKeepAlive)
 {
 	try
 	{
@@ -26,6 +37,7 @@ void WebServer::get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> soc
 			return;
 		}
 		std::string path = http.getHeader().path;
+		bool keepAlive = allowKeepAlive && keepAliveRequested(http);
 
 		BaseLib::EventHandlers eventHandlers = getEventHandlers();
 		for(BaseLib::EventHandlers::const_iterator i = eventHandlers.begin(); i != eventHandlers.end(); ++i)
@@ -74,17 +86,16 @@ void WebServer::get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> soc
 				return;
 			}
 			if(path == "flows/") path = "flows/index.php";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.php")) path += "index.php";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.php5")) path += "index.php5";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.php7")) path += "index.php7";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.hgs")) path += "index.hgs";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.html")) path += "index.html";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.htm")) path += "index.htm";
 			else
 			{
-				getError(404, "Not Found", "The requested URL " + path + " was not found on this server.", content);
-				send(socket, content);
-				return;
+				std::string index = getIndex(_serverInfo->contentPath + path, true);
+				if(index.empty())
+				{
+					getError(404, "Not Found", "The requested URL " + path + " was not found on this server.", content);
+					send(socket, content);
+					return;
+				}
+				path += index;
 			}
 		}
 
@@ -102,10 +113,10 @@ void WebServer::get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> soc
 			else if(!contentString.empty())
 			{
 				std::string header;
-				_http.constructHeader(contentString.size(), responseEncoding, 200, "OK", headers, header);
+				constructHeader(contentString.size(), responseEncoding, 200, "OK", headers, keepAlive, header);
 				content.insert(content.end(), header.begin(), header.end());
 				content.insert(content.end(), contentString.begin(), contentString.end());
-				send(socket, content);
+				send(socket, content, !keepAlive);
 				return;
 			}
 		}
@@ -125,32 +136,62 @@ void WebServer::get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> soc
 			int32_t pos = path.find_last_of('.');
 			if(pos != (signed)std::string::npos && (unsigned)pos < path.size() - 1) ending = path.substr(pos + 1);
 			GD::bl->hf.toLower(ending);
-			std::string contentString;
 #ifndef NO_SCRIPTENGINE
 			if(ending == "php" || ending == "php5" || ending == "php7" || ending == "hgs")
 			{
-				std::string fullPath;
-				if(path == "flows/index.php") fullPath = GD::bl->settings.flowsPath() + "www/index.php";
-				else if(path == "flows/signin.php") fullPath = GD::bl->settings.flowsPath() + "www/signin.php";
-				else fullPath = _serverInfo->contentPath + path;
-				std::string relativePath = '/' + path;
-				BaseLib::ScriptEngine::PScriptInfo scriptInfo(new BaseLib::ScriptEngine::ScriptInfo(BaseLib::ScriptEngine::ScriptInfo::ScriptType::web, fullPath, relativePath, http, _serverInfo));
-				scriptInfo->socket = socket;
-				scriptInfo->scriptHeadersCallback = std::bind(&WebServer::sendHeaders, this, std::placeholders::_1, std::placeholders::_2);
-				GD::scriptEngineServer->executeScript(scriptInfo, true);
-				socket->close();
+				//Scripts answering HEAD requests might still send a body, so don't reuse the connection.
+				executeScript(http, socket, path, keepAlive && http.getHeader().method == "GET");
 				return;
 			}
 #endif
 			std::string contentType = _http.getMimeType(ending);
 			if(contentType.empty()) contentType = "application/octet-stream";
-			//Don't return content when method is "HEAD"
-			if(http.getHeader().method == "GET") contentString = GD::bl->io.getFileContent(_serverInfo->contentPath + path);
+
+			//Serve precompressed variants ("file.js.br", "file.js.gz") when the client accepts them and they are not older than the file.
+			std::string fullPath = _serverInfo->contentPath + path;
+			PCachedFile file = getCachedFile(fullPath);
+			if(!file) throw BaseLib::Exception("File not found.");
+			std::string filePath = fullPath;
+			auto acceptEncodingIterator = http.getHeader().fields.find("accept-encoding");
+			if(acceptEncodingIterator != http.getHeader().fields.end())
+			{
+				std::vector<std::pair<std::string, std::string>> encodings{ {"br", ".br"}, {"gzip", ".gz"} };
+				for(auto& encoding : encodings)
+				{
+					if(acceptEncodingIterator->second.find(encoding.first) == std::string::npos) continue;
+					PCachedFile compressedFile = getCachedFile(fullPath + encoding.second);
+					if(!compressedFile || compressedFile->lastModified < file->lastModified) continue;
+					file = compressedFile;
+					filePath = fullPath + encoding.second;
+					headers.push_back("Content-Encoding: " + encoding.first);
+					break;
+				}
+			}
+			headers.push_back("Vary: Accept-Encoding");
+			headers.push_back("ETag: " + file->etag);
+			headers.push_back("Last-Modified: " + file->lastModifiedString);
+
+			bool notModified = false;
+			auto ifNoneMatchIterator = http.getHeader().fields.find("if-none-match");
+			if(ifNoneMatchIterator != http.getHeader().fields.end()) notModified = ifNoneMatchIterator->second.find(file->etag) != std::string::npos;
+			else
+			{
+				auto ifModifiedSinceIterator = http.getHeader().fields.find("if-modified-since");
+				if(ifModifiedSinceIterator != http.getHeader().fields.end()) notModified = ifModifiedSinceIterator->second == file->lastModifiedString;
+			}
+
 			std::string header;
-			_http.constructHeader(contentString.size(), contentType, 200, "OK", headers, header);
-			content.insert(content.end(), header.begin(), header.end());
-			if(!contentString.empty()) content.insert(content.end(), contentString.begin(), contentString.end());
-			send(socket, content);
+			if(notModified)
+			{
+				constructHeader(0, contentType, 304, "Not Modified", headers, keepAlive, header);
+				PCachedFile emptyFile;
+				sendFile(socket, header, filePath, emptyFile, !keepAlive);
+				return;
+			}
+			constructHeader(file->size, contentType, 200, "OK", headers, keepAlive, header);
+			//Don't return content when method is "HEAD"
+			if(http.getHeader().method != "GET") file.reset();
+			sendFile(socket, header, filePath, file, !keepAlive);
 		}
 		catch(const std::exception& ex)
 		{
@@ -179,7 +220,7 @@ void WebServer::get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> soc
     }
 }
 
-void WebServer::post(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> socket)
+void WebServer::post(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> socket, bool allowKeepAlive)
 {
 	try
 	{
@@ -189,6 +230,7 @@ void WebServer::post(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> so
 			return;
 		}
 		std::string path = http.getHeader().path;
+		bool keepAlive = allowKeepAlive && keepAliveRequested(http);
 
 		BaseLib::EventHandlers eventHandlers = getEventHandlers();
 		for(BaseLib::EventHandlers::const_iterator i = eventHandlers.begin(); i != eventHandlers.end(); ++i)
@@ -232,15 +274,16 @@ void WebServer::post(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> so
 				return;
 			}
 			if (path == "flows/") path = "flows/index.php";
-			else if (GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.php")) path += "index.php";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.php5")) path += "index.php5";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.php7")) path += "index.php7";
-			else if(GD::bl->io.fileExists(_serverInfo->contentPath + path + "index.hgs")) path += "index.hgs";
 			else
 			{
-				getError(404, _http.getStatusText(404), "The requested URL " + path + " was not found on this server.", content);
-				send(socket, content);
-				return;
+				std::string index = getIndex(_serverInfo->contentPath + path, false);
+				if(index.empty())
+				{
+					getError(404, _http.getStatusText(404), "The requested URL " + path + " was not found on this server.", content);
+					send(socket, content);
+					return;
+				}
+				path += index;
 			}
 		}
 
@@ -259,10 +302,10 @@ void WebServer::post(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> so
 			{
 				std::vector<std::string> headers;
 				std::string header;
-				_http.constructHeader(contentString.size(), responseEncoding, 200, "OK", headers, header);
+				constructHeader(contentString.size(), responseEncoding, 200, "OK", headers, keepAlive, header);
 				content.insert(content.end(), header.begin(), header.end());
 				content.insert(content.end(), contentString.begin(), contentString.end());
-				send(socket, content);
+				send(socket, content, !keepAlive);
 				return;
 			}
 		}
@@ -278,16 +321,7 @@ void WebServer::post(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> so
 		try
 		{
 			_out.printInfo("Client is requesting: " + http.getHeader().path + " (translated to: \"" + _serverInfo->contentPath + path + "\", method: POST)");
-			std::string fullPath;
-			if(path == "flows/index.php") fullPath = GD::bl->settings.flowsPath() + "www/index.php";
-			else if(path == "flows/signin.php") fullPath = GD::bl->settings.flowsPath() + "www/signin.php";
-			else fullPath = _serverInfo->contentPath + path;
-			std::string relativePath = '/' + path;
-			BaseLib::ScriptEngine::PScriptInfo scriptInfo(new BaseLib::ScriptEngine::ScriptInfo(BaseLib::ScriptEngine::ScriptInfo::ScriptType::web, fullPath, relativePath, http, _serverInfo));
-			scriptInfo->socket = socket;
-			scriptInfo->scriptHeadersCallback = std::bind(&WebServer::sendHeaders, this, std::placeholders::_1, std::placeholders::_2);
-			GD::scriptEngineServer->executeScript(scriptInfo, true);
-			socket->close();
+			executeScript(http, socket, path, keepAlive);
 		}
 		catch(const std::exception& ex)
 		{
@@ -369,7 +403,7 @@ void WebServer::getError(int32_t code, std::string codeDescription, std::string
     }
 }
 
-void WebServer::send(std::shared_ptr<BaseLib::TcpSocket>& socket, std::vector<char>& data)
+void WebServer::send(std::shared_ptr<BaseLib::TcpSocket>& socket, std::vector<char>& data, bool closeConnection)
 {
 	try
 	{
@@ -388,7 +422,7 @@ void WebServer::send(std::shared_ptr<BaseLib::TcpSocket>& socket, std::vector<ch
 		{
 			_out.printInfo("Info: " + ex.what());
 		}
-		socket->close();
+		if(closeConnection) socket->close();
 	}
     catch(const std::exception& ex)
     {
@@ -404,11 +438,291 @@ void WebServer::send(std::shared_ptr<BaseLib::TcpSocket>& socket, std::vector<ch
     }
 }
 
-void WebServer::sendHeaders(BaseLib::ScriptEngine::PScriptInfo& scriptInfo, BaseLib::PVariable& headers)
+std::string WebServer::getIndex(const std::string& directory, bool includeHtml)
+{
+	try
+	{
+		struct stat statStruct;
+		if(stat(directory.c_str(), &statStruct) != 0) return "";
+		std::string key = directory + (includeHtml ? "\n1" : "\n0");
+
+		{
+			std::lock_guard<std::mutex> fileCacheGuard(_fileCacheMutex);
+			auto indexIterator = _indexCache.find(key);
+			if(indexIterator != _indexCache.end() && indexIterator->second.lastModified == getModificationTime(statStruct)) return indexIterator->second.index;
+		}
+
+		std::vector<std::string> indexFiles{ "index.php", "index.php5", "index.php7", "index.hgs" };
+		if(includeHtml)
+		{
+			indexFiles.push_back("index.html");
+			indexFiles.push_back("index.htm");
+		}
+
+		CachedIndex cachedIndex;
+		cachedIndex.lastModified = getModificationTime(statStruct);
+		for(auto& indexFile : indexFiles)
+		{
+			if(BaseLib::Io::fileExists(directory + indexFile))
+			{
+				cachedIndex.index = indexFile;
+				break;
+			}
+		}
+
+		std::lock_guard<std::mutex> fileCacheGuard(_fileCacheMutex);
+		_indexCache[key] = cachedIndex;
+		return cachedIndex.index;
+	}
+	catch(const std::exception& ex)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+	return "";
+}
+
+WebServer::PCachedFile WebServer::getCachedFile(const std::string& path)
+{
+	try
+	{
+		struct stat statStruct;
+		if(stat(path.c_str(), &statStruct) != 0 || !S_ISREG(statStruct.st_mode)) return PCachedFile();
+
+		{
+			std::lock_guard<std::mutex> fileCacheGuard(_fileCacheMutex);
+			auto fileIterator = _fileCache.find(path);
+			if(fileIterator != _fileCache.end())
+			{
+				if(fileIterator->second->lastModified == getModificationTime(statStruct) && fileIterator->second->size == (int64_t)statStruct.st_size) return fileIterator->second;
+				if(fileIterator->second->content) _fileCacheSize -= fileIterator->second->content->size();
+				_fileCache.erase(fileIterator);
+			}
+		}
+
+		PCachedFile file = std::make_shared<CachedFile>();
+		file->lastModified = getModificationTime(statStruct);
+		file->size = statStruct.st_size;
+		std::ostringstream etag;
+		etag << std::hex << '"' << (uint64_t)statStruct.st_ino << '-' << file->lastModified << '-' << file->size << '"';
+		file->etag = etag.str();
+		struct tm timeStruct;
+		time_t lastModified = statStruct.st_mtime;
+		gmtime_r(&lastModified, &timeStruct);
+		char timeString[64];
+		size_t timeStringSize = strftime(timeString, sizeof(timeString), "%a, %d %b %Y %H:%M:%S GMT", &timeStruct);
+		file->lastModifiedString = std::string(timeString, timeStringSize);
+		if(file->size > _maxCachedFileSize) return file;
+
+		file->content = std::make_shared<std::vector<char>>(BaseLib::Io::getBinaryFileContent(path));
+		if((int64_t)file->content->size() != file->size) return file; //File changed while reading. Don't cache it.
+
+		std::lock_guard<std::mutex> fileCacheGuard(_fileCacheMutex);
+		auto fileIterator = _fileCache.find(path);
+		if(fileIterator != _fileCache.end())
+		{
+			if(fileIterator->second->content) _fileCacheSize -= fileIterator->second->content->size();
+			_fileCache.erase(fileIterator);
+		}
+		while(!_fileCache.empty() && _fileCacheSize + file->size > _maxFileCacheSize)
+		{
+			if(_fileCache.begin()->second->content) _fileCacheSize -= _fileCache.begin()->second->content->size();
+			_fileCache.erase(_fileCache.begin());
+		}
+		_fileCache.emplace(path, file);
+		_fileCacheSize += file->size;
+		return file;
+	}
+	catch(const std::exception& ex)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+	return PCachedFile();
+}
+
+void WebServer::sendFile(std::shared_ptr<BaseLib::TcpSocket>& socket, const std::string& header, const std::string& path, PCachedFile& file, bool closeConnection)
+{
+	try
+	{
+		try
+		{
+			//Sleep a tiny little bit. Some clients like don't accept responses too fast.
+			std::this_thread::sleep_for(std::chrono::milliseconds(22));
+			socket->proofwrite(header.c_str(), header.size());
+			if(file)
+			{
+				if(file->content)
+				{
+					if(!file->content->empty()) socket->proofwrite(file->content->data(), file->content->size());
+				}
+				else
+				{
+					//Large files are not cached. Stream them instead of reading them into memory completely.
+					std::ifstream fileStream(path, std::ios::in | std::ios::binary);
+					if(fileStream.is_open())
+					{
+						std::vector<char> buffer(65536);
+						int64_t bytesLeft = file->size;
+						while(bytesLeft > 0 && fileStream.read(buffer.data(), std::min((int64_t)buffer.size(), bytesLeft)))
+						{
+							socket->proofwrite(buffer.data(), fileStream.gcount());
+							bytesLeft -= fileStream.gcount();
+						}
+						if(bytesLeft > 0)
+						{
+							_out.printWarning("Warning: Could not read file completely: " + path);
+							closeConnection = true;
+						}
+					}
+					else
+					{
+						_out.printError("Error: Could not open file " + path);
+						closeConnection = true;
+					}
+				}
+			}
+		}
+		catch(BaseLib::SocketDataLimitException& ex)
+		{
+			_out.printWarning("Warning: " + ex.what());
+		}
+		catch(const BaseLib::SocketOperationException& ex)
+		{
+			_out.printInfo("Info: " + ex.what());
+			closeConnection = true;
+		}
+		if(closeConnection) socket->close();
+	}
+	catch(const std::exception& ex)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+
+bool WebServer::keepAliveRequested(BaseLib::Http& http)
+{
+	if(http.getHeader().connection & BaseLib::Http::Connection::Enum::close) return false;
+	if(http.getHeader().protocol == BaseLib::Http::Protocol::http10) return http.getHeader().connection & BaseLib::Http::Connection::Enum::keepAlive;
+	return true;
+}
+
+void WebServer::constructHeader(uint32_t contentLength, const std::string& contentType, int32_t code, const std::string& codeDescription, const std::vector<std::string>& additionalHeaders, bool keepAlive, std::string& header)
+{
+	header.reserve(1024);
+	header.append("HTTP/1.1 " + std::to_string(code) + " " + codeDescription + "\r\n");
+	if(keepAlive) header.append("Connection: Keep-Alive\r\nKeep-Alive: timeout=" + std::to_string(_keepAliveTimeout / 1000) + "\r\n");
+	else header.append("Connection: close\r\n");
+	if(!contentType.empty()) header.append("Content-Type: " + contentType + "\r\n");
+	for(auto& additionalHeader : additionalHeaders)
+	{
+		header.append(additionalHeader + "\r\n");
+	}
+	header.append("Content-Length: " + std::to_string(contentLength) + "\r\n\r\n");
+}
+
+#ifndef NO_SCRIPTENGINE
+void WebServer::executeScript(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket>& socket, const std::string& path, bool keepAlive)
+{
+	std::string fullPath;
+	if(path == "flows/index.php") fullPath = GD::bl->settings.flowsPath() + "www/index.php";
+	else if(path == "flows/signin.php") fullPath = GD::bl->settings.flowsPath() + "www/signin.php";
+	else fullPath = _serverInfo->contentPath + path;
+	std::string relativePath = '/' + path;
+	BaseLib::ScriptEngine::PScriptInfo scriptInfo(new BaseLib::ScriptEngine::ScriptInfo(BaseLib::ScriptEngine::ScriptInfo::ScriptType::web, fullPath, relativePath, http, _serverInfo));
+	PScriptResponse response = std::make_shared<ScriptResponse>();
+	response->socket = socket;
+	response->keepAlive = keepAlive;
+	//Without keep alive the script engine writes the output directly to the socket. Otherwise it needs to be framed.
+	if(!keepAlive) scriptInfo->socket = socket;
+	else scriptInfo->scriptOutputCallback = std::bind(&WebServer::sendScriptOutput, this, response, std::placeholders::_1, std::placeholders::_2);
+	scriptInfo->scriptHeadersCallback = std::bind(&WebServer::sendHeaders, this, response, std::placeholders::_1, std::placeholders::_2);
+	GD::scriptEngineServer->executeScript(scriptInfo, true);
+
+	if(!response->keepAlive || !response->headersSent)
+	{
+		socket->close();
+		return;
+	}
+	if(response->chunked)
+	{
+		try
+		{
+			std::string lastChunk("0\r\n\r\n");
+			socket->proofwrite(lastChunk.c_str(), lastChunk.size());
+		}
+		catch(const BaseLib::SocketOperationException& ex)
+		{
+			_out.printInfo("Info: " + ex.what());
+			socket->close();
+		}
+	}
+}
+
+void WebServer::sendScriptOutput(PScriptResponse response, BaseLib::ScriptEngine::PScriptInfo& scriptInfo, std::string& output)
 {
 	try
 	{
-		if(!scriptInfo || !scriptInfo->socket || !headers) return;
+		if(!response || output.empty() || response->noBody) return;
+		if(response->chunked)
+		{
+			std::ostringstream chunkHeader;
+			chunkHeader << std::hex << output.size() << "\r\n";
+			std::string chunk;
+			chunk.reserve(chunkHeader.str().size() + output.size() + 2);
+			chunk.append(chunkHeader.str()).append(output).append("\r\n");
+			response->socket->proofwrite(chunk.c_str(), chunk.size());
+		}
+		else response->socket->proofwrite(output.c_str(), output.size());
+	}
+	catch(const BaseLib::SocketOperationException& ex)
+	{
+		_out.printInfo("Info: " + ex.what());
+		response->keepAlive = false;
+		response->socket->close();
+	}
+	catch(const std::exception& ex)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(BaseLib::Exception& ex)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__, ex.what());
+	}
+	catch(...)
+	{
+		_out.printEx(__FILE__, __LINE__, __PRETTY_FUNCTION__);
+	}
+}
+#endif
+
+void WebServer::sendHeaders(PScriptResponse response, BaseLib::ScriptEngine::PScriptInfo& scriptInfo, BaseLib::PVariable& headers)
+{
+	try
+	{
+		if(!response || !scriptInfo || !headers) return;
 		BaseLib::Struct::iterator headerIterator = headers->structValue->find("RESPONSE_CODE");
 		int32_t responseCode = 500;
 		if(headerIterator != headers->structValue->end()) responseCode = headerIterator->second->integerValue;
@@ -424,6 +738,31 @@ void WebServer::sendHeaders(BaseLib::ScriptEngine::PScriptInfo& scriptInfo, Base
 			}
 		}
 
+		bool hasContentLength = false;
+		if(response->keepAlive)
+		{
+			for(BaseLib::Struct::iterator i = headers->structValue->begin(); i != headers->structValue->end();)
+			{
+				std::string name = i->first;
+				BaseLib::HelperFunctions::toLower(name);
+				if(name == "content-length") hasContentLength = true;
+				else if(name == "transfer-encoding") response->keepAlive = false; //We can't reframe output the script already encoded.
+				else if(name == "connection")
+				{
+					std::string value = i->second->stringValue;
+					if(BaseLib::HelperFunctions::toLower(value).find("close") != std::string::npos) response->keepAlive = false;
+					else
+					{
+						i = headers->structValue->erase(i);
+						continue;
+					}
+				}
+				++i;
+			}
+			response->noBody = (responseCode >= 100 && responseCode < 200) || responseCode == 204 || responseCode == 304;
+			response->chunked = response->keepAlive && !hasContentLength && !response->noBody;
+		}
+
 		std::string output;
 		output.reserve(1024);
 		output.append("HTTP/1.1 " + std::to_string(responseCode) + ' ' + scriptInfo->http.getStatusText(responseCode) + "\r\n");
@@ -432,8 +771,19 @@ void WebServer::sendHeaders(BaseLib::ScriptEngine::PScriptInfo& scriptInfo, Base
 			if(output.size() + i->first.size() + i->second->stringValue.size() + 6 > output.capacity()) output.reserve(output.capacity() + 1024);
 			output.append(i->first + ": " + i->second->stringValue + "\r\n");
 		}
+		if(response->keepAlive)
+		{
+			output.append("Connection: Keep-Alive\r\nKeep-Alive: timeout=" + std::to_string(_keepAliveTimeout / 1000) + "\r\n");
+			if(response->chunked) output.append("Transfer-Encoding: chunked\r\n");
+		}
 		output.append("\r\n");
-		scriptInfo->socket->proofwrite(output.c_str(), output.size());
+		response->socket->proofwrite(output.c_str(), output.size());
+		response->headersSent = true;
+	}
+	catch(const BaseLib::SocketOperationException& ex)
+	{
+		_out.printInfo("Info: " + ex.what());
+		response->keepAlive = false;
 	}
     catch(const std::exception& ex)
     {
@@ -33,6 +33,8 @@
 
 #include <homegear-base/BaseLib.h>
 
+#include <unordered_map>
+
 namespace WebServer
 {
 	class WebServer : public BaseLib::IEventsEx
@@ -41,14 +43,61 @@ namespace WebServer
 			WebServer(std::shared_ptr<BaseLib::Rpc::ServerInfo::Info>& serverInfo);
 			virtual ~WebServer();
 
-			void get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> socket);
-			void post(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> socket);
+			/**
+			 * The time in milliseconds a persistent connection may stay idle before it is closed.
+			 */
+			int64_t keepAliveTimeout() { return _keepAliveTimeout; }
+
+			/**
+			 * The maximum number of requests served over one persistent connection.
+			 */
+			int32_t maxKeepAliveRequests() { return _maxKeepAliveRequests; }
+
+			/**
+			 * Processes a GET or HEAD request.
+			 *
+			 * @param http The request.
+			 * @param socket The socket to send the response to.
+			 * @param allowKeepAlive When "true", the connection is kept open if the client requests it. Otherwise it is closed after the response.
+			 */
+			void get(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> socket, bool allowKeepAlive = false);
+			void post(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket> socket, bool allowKeepAlive = false);
 			void getError(int32_t code, std::string codeDescription, std::string longDescription, std::vector<char>& content);
 			void getError(int32_t code, std::string codeDescription, std::string longDescription, std::vector<char>& content, std::vector<std::string>& additionalHeaders);
 
 			void registerSendHeadersHook(std::string& moduleName, std::function<void(BaseLib::Http& http, BaseLib::PVariable& headers)>& callback);
 		protected:
 		private:
+			struct CachedFile
+			{
+				int64_t lastModified = 0;
+				int64_t size = 0;
+				std::string etag;
+				std::string lastModifiedString;
+
+				/**
+				 * The file content. nullptr for files larger than _maxCachedFileSize.
+				 */
+				std::shared_ptr<std::vector<char>> content;
+			};
+			typedef std::shared_ptr<CachedFile> PCachedFile;
+
+			struct ScriptResponse
+			{
+				std::shared_ptr<BaseLib::TcpSocket> socket;
+				bool keepAlive = false;
+				bool headersSent = false;
+				bool chunked = false;
+				bool noBody = false;
+			};
+			typedef std::shared_ptr<ScriptResponse> PScriptResponse;
+
+			struct CachedIndex
+			{
+				int64_t lastModified = 0;
+				std::string index;
+			};
+
 			BaseLib::Output _out;
 			BaseLib::Rpc::PServerInfo _serverInfo;
 			BaseLib::Http _http;
@@ -56,8 +105,41 @@ namespace WebServer
 			std::mutex _sendHeaderHookMutex;
 			std::map<std::string, std::function<void(BaseLib::Http& http, BaseLib::PVariable& headers)>> _sendHeaderHooks;
 
-			void send(std::shared_ptr<BaseLib::TcpSocket>& socket, std::vector<char>& data);
-			void sendHeaders(BaseLib::ScriptEngine::PScriptInfo& scriptInfo, BaseLib::PVariable& headers);
+			const int64_t _keepAliveTimeout = 15000;
+			const int32_t _maxKeepAliveRequests = 100;
+			const int64_t _maxCachedFileSize = 4194304;
+			const int64_t _maxFileCacheSize = 33554432;
+			std::mutex _fileCacheMutex;
+			int64_t _fileCacheSize = 0;
+			std::unordered_map<std::string, PCachedFile> _fileCache;
+			std::unordered_map<std::string, CachedIndex> _indexCache;
+
+			/**
+			 * Returns the index file name of a directory or an empty string when there is none. Results are cached and
+			 * validated using the directory's modification time.
+			 */
+			std::string getIndex(const std::string& directory, bool includeHtml);
+
+			/**
+			 * Returns the metadata and (for small files) the content of a static file. The cache entry is validated
+			 * against the file's modification time and size on every call.
+			 *
+			 * @return The cached file or nullptr if the file doesn't exist.
+			 */
+			PCachedFile getCachedFile(const std::string& path);
+			void sendFile(std::shared_ptr<BaseLib::TcpSocket>& socket, const std::string& header, const std::string& path, PCachedFile& file, bool closeConnection);
+
+			void send(std::shared_ptr<BaseLib::TcpSocket>& socket, std::vector<char>& data, bool closeConnection = true);
+			bool keepAliveRequested(BaseLib::Http& http);
+			void constructHeader(uint32_t contentLength, const std::string& contentType, int32_t code, const std::string& codeDescription, const std::vector<std::string>& additionalHeaders, bool keepAlive, std::string& header);
+
+			/**
+			 * Executes a PHP script and sends its output. When "keepAlive" is "true", output without "Content-Length" is
+			 * sent using chunked transfer encoding, so the connection can be reused.
+			 */
+			void executeScript(BaseLib::Http& http, std::shared_ptr<BaseLib::TcpSocket>& socket, const std::string& path, bool keepAlive);
+			void sendScriptOutput(PScriptResponse response, BaseLib::ScriptEngine::PScriptInfo& scriptInfo, std::string& output);
+			void sendHeaders(PScriptResponse response, BaseLib::ScriptEngine::PScriptInfo& scriptInfo, BaseLib::PVariable& headers);
 	};
 }
 #endif
@@ -1106,18 +1106,8 @@ void startUp()
         GD::out.printMessage("Startup complete. Waiting for physical interfaces to connect.");
 
         //Wait for all interfaces to connect before setting booting to false
-        {
-			for(int32_t i = 0; i < 300; i++)
-			{
-				if(GD::familyController->physicalInterfaceIsOpen())
-				{
-					GD::out.printMessage("All physical interfaces are connected now.");
-					break;
-				}
-				if(i == 299) GD::out.printError("Error: At least one physical interface is not connected.");
-				std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-			}
-        }
+        if(GD::familyController->waitForPhysicalInterfaces(300000)) GD::out.printMessage("All physical interfaces are connected now.");
+        else GD::out.printError("Error: At least one physical interface is not connected.");
 
         if(GD::bl->settings.enableUPnP())
 		{